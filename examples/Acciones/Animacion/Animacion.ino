@@ -0,0 +1,33 @@
+#include <Orbito.h>
+#include "animacion.h"
+
+// La animacion se describe en animacion.json y se convierte con:
+//   python3 extras/tools/orbito_anim.py animacion.json animacion.h
+// Se guarda en la memoria Flash y se va leyendo poco a poco mientras se reproduce
+
+// Direccion de la Flash donde la guardamos (multiplo de 4096, los sectores 0 y 1 son de Storage)
+#define DIRECCION_ANIMACION 0x10000
+
+void setup() {
+    Serial.begin(115200);
+    Orbito.begin();
+
+    // Solo hace falta guardarla una vez: si ya esta en la Flash, la reproducimos sin copiarla
+    if (!Orbito.Action.playAnimation(DIRECCION_ANIMACION)) {
+        Serial.println("Guardando la animacion en la Flash...");
+        Orbito.Action.storeAnimation(DIRECCION_ANIMACION, animacion, sizeof(animacion));
+        Orbito.Action.playAnimation(DIRECCION_ANIMACION);
+    }
+}
+
+void loop() {
+    Orbito.update(); // Aqui se aplican los fotogramas clave
+
+    // Escribe "parar" o "otra vez" en el monitor serie
+    if (Serial.available()) {
+        String orden = Serial.readStringUntil('\n');
+        orden.trim();
+        if (orden == "parar") Orbito.Action.stopAnimation();
+        if (orden == "otra vez") Orbito.Action.playAnimation(DIRECCION_ANIMACION);
+    }
+}
@@ -0,0 +1,15 @@
+// Generated by extras/tools/orbito_anim.py, do not edit
+#pragma once
+
+const uint8_t animacion[152] = {
+    0x4F, 0x52, 0x42, 0x41, 0x01, 0x01, 0x09, 0x00, 0x70, 0x17, 0x00, 0x00, 0x88, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x03, 0x00, 0x2C, 0x01,
+    0x58, 0x02, 0x00, 0x00, 0x01, 0x02, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0xF1, 0x00, 0x90, 0x01,
+    0x78, 0x05, 0x00, 0x00, 0x01, 0x03, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x58, 0x02,
+    0xFC, 0x08, 0x00, 0x00, 0x01, 0x03, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x2C, 0x01,
+    0x8C, 0x0A, 0x00, 0x00, 0x02, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x0C, 0x00, 0x00,
+    0x00, 0x02, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0xFA, 0x00, 0x68, 0x10, 0x00, 0x00,
+    0x00, 0x03, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x02, 0x00, 0xF4, 0x01, 0x50, 0x14, 0x00, 0x00,
+    0x01, 0x03, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0xF6, 0x2C, 0x01, 0xE0, 0x15, 0x00, 0x00,
+    0x02, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
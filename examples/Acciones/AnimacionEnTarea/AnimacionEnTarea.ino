@@ -0,0 +1,26 @@
+#include <Orbito.h>
+
+int contador = 0;
+
+void setup() {
+    Orbito.begin();
+    Orbito.Action.setExpression(OrbitoRobot::ActionModule::HAPPY);
+    Orbito.Action.animateEyes(true);
+
+    // La cara se anima en su propia tarea: parpadea aunque el loop() este parado
+    Orbito.Action.enableAnimationTask(true);
+}
+
+void loop() {
+    Orbito.update(); // Sigue haciendo falta para el WiFi, el Bluetooth y la pantalla
+
+    // Un marcador de dos partes: las reservamos juntas para que la cara no se pinte en medio
+    Orbito.Display.lock();
+    Orbito.Display.fillRect(0, 0, 320, 10, 0x0000);
+    Orbito.Display.setCursor(4, 1);
+    Orbito.Display.print("Cuenta: " + String(contador++));
+    Orbito.Display.unlock();
+
+    // Un delay largo ya no congela los ojos
+    delay(2000);
+}
@@ -0,0 +1,35 @@
+#include <Orbito.h>
+
+// Frases que el robot va diciendo (la ultima es larga: se ve en varias paginas)
+const char* frases[] = {
+    "Hola! Soy Orbito.",
+    "Me encanta aprender cosas nuevas.",
+    "Puedo ver con mi camara, escuchar con mi microfono y mover los ojos. Ademas, si el texto es muy largo, lo muestro en varias paginas que pasan solas."
+};
+
+int indice = 0;
+unsigned long ultimoCambio = 0;
+
+void setup() {
+    Orbito.begin();
+    Orbito.Action.setExpression(OrbitoRobot::ActionModule::HAPPY);
+    Orbito.Action.animateEyes(true); // Los ojos siguen parpadeando con el bocadillo
+}
+
+void loop() {
+    Orbito.update(); // Aqui se pasan las paginas del bocadillo
+
+    if (millis() - ultimoCambio > 8000) {
+        ultimoCambio = millis();
+
+        if (indice < 3) {
+            // La primera vez se reparte el texto en lineas, las siguientes ya esta calculado
+            Orbito.Action.say(frases[indice]);
+            indice++;
+        } else {
+            // Al quitar el bocadillo solo se redibuja la boca
+            Orbito.Action.hideBubble();
+            indice = 0;
+        }
+    }
+}
@@ -1,27 +1,28 @@
 #include <Orbito.h>
 
+// Posiciones de las pupilas: izquierda, derecha, arriba y centro
+int miradas[][2] = { {-15, 0}, {15, 0}, {0, -15}, {0, 0} };
+
+int paso = 0;
+unsigned long ultimo_cambio = 0;
+
 void setup() {
     Orbito.begin();
     Orbito.Action.setExpression(OrbitoRobot::ActionModule::HAPPY);
 }
 
 void loop() {
+    // Sin delay(): update() tiene que ejecutarse a menudo para que los ojos se vuelvan a abrir
     Orbito.update();
 
-    // Mirar Izquierda
-    Orbito.Action.lookAt(-15, 0); 
-    delay(1000);
+    // Cambiar de posicion cada segundo
+    if (millis() - ultimo_cambio > 1000) {
+        ultimo_cambio = millis();
+        Orbito.Action.lookAt(miradas[paso][0], miradas[paso][1]);
 
-    // Mirar Derecha
-    Orbito.Action.lookAt(15, 0); 
-    delay(1000);
+        // En el centro, parpadear
+        if (paso == 3) Orbito.Action.blink();
 
-    // Mirar Arriba
-    Orbito.Action.lookAt(0, -15); 
-    delay(1000);
-
-    // Centro y Parpadear
-    Orbito.Action.lookAt(0, 0);
-    Orbito.Action.blink();
-    delay(1000);
-}
\ No newline at end of file
+        paso = (paso + 1) % 4;
+    }
+}
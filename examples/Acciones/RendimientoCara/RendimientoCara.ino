@@ -0,0 +1,114 @@
+#include <Orbito.h>
+
+// Mide cuanto tarda en dibujarse cada expresion:
+//  - ANTES: las figuras de la cara calculadas con decimales (sqrtf, sinf, cosf)
+//  - AHORA: Orbito.Action.setExpression(), que solo usa numeros enteros
+//  - CACHE: la misma expresion otra vez, ya guardada como imagen comprimida
+
+OrbitoRobot::ActionModule::Emotion emotions[] = {
+    OrbitoRobot::ActionModule::NEUTRAL,
+    OrbitoRobot::ActionModule::HAPPY,
+    OrbitoRobot::ActionModule::SAD,
+    OrbitoRobot::ActionModule::ANGRY,
+    OrbitoRobot::ActionModule::SURPRISE,
+    OrbitoRobot::ActionModule::WORRY,
+    OrbitoRobot::ActionModule::SLEEPY
+};
+const char* names[] = { "NEUTRAL", "HAPPY", "SAD", "ANGRY", "SURPRISE", "WORRY", "SLEEPY" };
+
+// Lista para la version antigua (global, es grande)
+StaticDrawList<1024> lista;
+
+// -----------------------------------------------------
+// VERSION ANTIGUA (con decimales)
+// -----------------------------------------------------
+void arcoAntiguo(int16_t x, int16_t y, int16_t r, int16_t inicio, int16_t fin) {
+    float rad = inicio * 0.0174532925f;
+    int16_t x1 = x + (int16_t)(cosf(rad) * r);
+    int16_t y1 = y + (int16_t)(sinf(rad) * r);
+    for (int i = inicio + 6; i <= fin; i += 6) {
+        rad = i * 0.0174532925f;
+        int16_t x2 = x + (int16_t)(cosf(rad) * r);
+        int16_t y2 = y + (int16_t)(sinf(rad) * r);
+        lista.drawLine(x1, y1, x2, y2, 0xFFFF);
+        x1 = x2;
+        y1 = y2;
+    }
+}
+
+void arcoGruesoAntiguo(int16_t x, int16_t y, int16_t r, int16_t inicio, int16_t fin) {
+    // Un arco por cada pixel de grosor
+    for (int i = 0; i < 10; i++) arcoAntiguo(x, y, r - i, inicio, fin);
+}
+
+void elipseAntigua(int16_t x0, int16_t y0, int16_t rx, int16_t ry) {
+    for (int16_t y = -ry; y <= ry; y++) {
+        int16_t ancho = (int16_t)(rx * sqrtf(1.0f - (float)(y * y) / (float)(ry * ry)));
+        lista.drawFastHLine(x0 - ancho, y0 + y, 2 * ancho + 1, 0xFFFF);
+    }
+}
+
+void caraAntigua(int e) {
+    lista.fillScreen(0x0000);
+    // Boca (mismas medidas que la libreria)
+    switch (emotions[e]) {
+        case OrbitoRobot::ActionModule::WORRY:
+        case OrbitoRobot::ActionModule::SAD:      arcoGruesoAntiguo(160, 270, 100, 225, 315); break;
+        case OrbitoRobot::ActionModule::ANGRY:    arcoGruesoAntiguo(160, 270, 100, 240, 300); break;
+        case OrbitoRobot::ActionModule::HAPPY:    arcoGruesoAntiguo(160, 110, 100, 60, 120); break;
+        case OrbitoRobot::ActionModule::SURPRISE:
+            lista.fillRoundRect(120, 155, 80, 70, 20, 0xFFFF);
+            lista.fillRect(120, 210, 80, 30, 0x0000);
+            break;
+        case OrbitoRobot::ActionModule::SLEEPY:   lista.fillRoundRect(140, 185, 40, 10, 5, 0xFFFF); break;
+        default:                                  lista.fillRoundRect(120, 185, 80, 10, 5, 0xFFFF); break;
+    }
+    // Ojos (el cuerpo de la elipse es lo que cambia entre versiones)
+    float abierto = 0.8;
+    if (emotions[e] == OrbitoRobot::ActionModule::SURPRISE) abierto = 1.0;
+    if (emotions[e] == OrbitoRobot::ActionModule::SLEEPY) abierto = 0.4;
+    int16_t alto = 110 * abierto;
+    for (int16_t x = 75; x <= 245; x += 170) {
+        lista.fillRect(x - 50, 10, 100, 150, 0x0000);
+        elipseAntigua(x, 85, 30, alto / 2);
+    }
+    Orbito.Display.submit(lista);
+}
+
+// -----------------------------------------------------
+// PRUEBA
+// -----------------------------------------------------
+void setup() {
+
+    Serial.begin(115200);
+    Orbito.begin();
+
+}
+
+void loop() {
+
+    Orbito.update();
+
+    Serial.println("Expresion   Antes (us)   Ahora (us)   Cache (us)   Mejora");
+    for (int e = 0; e < 7; e++) {
+        unsigned long inicio = micros();
+        caraAntigua(e);
+        unsigned long antes = micros() - inicio;
+
+        inicio = micros();
+        Orbito.Action.setExpression(emotions[e]);
+        unsigned long ahora = micros() - inicio;
+
+        // La segunda vez la cara ya esta preparada
+        inicio = micros();
+        Orbito.Action.setExpression(emotions[e]);
+        unsigned long cache = micros() - inicio;
+
+        Serial.printf("%-10s  %10lu   %10lu   %10lu   x%.1f\n", names[e], antes, ahora, cache, (float)antes / cache);
+        delay(500);
+    }
+    Serial.println();
+
+    delay(3000);
+
+}
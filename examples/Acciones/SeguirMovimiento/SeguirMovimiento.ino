@@ -0,0 +1,28 @@
+#include <Orbito.h>
+
+unsigned long ultimoInforme = 0;
+
+void setup() {
+    Serial.begin(115200);
+    Orbito.begin(); // La camara arranca en MODE_AI (sin comprimir), que es el que necesitamos
+
+    Orbito.Action.setExpression(OrbitoRobot::ActionModule::NEUTRAL);
+    Orbito.Action.animateEyes(true); // Sigue parpadeando mientras mira
+
+    // Con 24 ignora el ruido de la camara; baja el numero si tu habitacion es oscura
+    Orbito.Action.setMotionSensitivity(24);
+
+    if (!Orbito.Action.followMotion(true)) {
+        Serial.println("No se puede seguir el movimiento: revisa la camara");
+    }
+}
+
+void loop() {
+    Orbito.update(); // Aqui se mueven los ojos hacia el movimiento
+
+    // Cada segundo mostramos cuantas imagenes por segundo se analizan
+    if (millis() - ultimoInforme >= 1000) {
+        ultimoInforme = millis();
+        Serial.printf("Seguimiento: %.1f fps\n", Orbito.Action.getTrackingFps());
+    }
+}
@@ -0,0 +1,42 @@
+#include <Orbito.h>
+
+// Array con todas las emociones disponibles
+OrbitoRobot::ActionModule::Emotion emotions[] = {
+    OrbitoRobot::ActionModule::NEUTRAL,
+    OrbitoRobot::ActionModule::HAPPY,
+    OrbitoRobot::ActionModule::SURPRISE,
+    OrbitoRobot::ActionModule::ANGRY,
+    OrbitoRobot::ActionModule::SAD,
+    OrbitoRobot::ActionModule::WORRY,
+    OrbitoRobot::ActionModule::SLEEPY
+};
+
+// Una curva distinta en cada cambio para ver la diferencia
+Easing curvas[] = { EASE_LINEAR, EASE_IN, EASE_OUT, EASE_IN_OUT };
+
+int index_emo = 0;
+int index_curva = 0;
+unsigned long last_change = 0;
+
+void setup() {
+    Orbito.begin();
+    Orbito.Action.setExpression(emotions[0]);
+    // Hasta 30 fotogramas por segundo, como mucho 10 ms de dibujo en cada uno
+    Orbito.Action.setAnimationRate(30, 10);
+}
+
+void loop() {
+    Orbito.update(); // Aqui se dibujan los pasos de la transicion
+
+    // Cambiar cada 2 segundos
+    if (millis() - last_change > 2000) {
+        last_change = millis();
+        index_emo = (index_emo + 1) % 7;
+        index_curva = (index_curva + 1) % 4;
+
+        // La cara pasa poco a poco a la nueva emocion en medio segundo
+        Orbito.Action.setExpression(emotions[index_emo], 500, curvas[index_curva]);
+    }
+
+    // El loop sigue libre durante la transicion
+}
@@ -0,0 +1,50 @@
+#include <Orbito.h>
+
+// Cada vez que pulses el boton la camara cambia de modo
+// y se muestra cuanto ha tardado en dar la primera foto buena.
+
+CameraHandler::Camera_Mode modos[] = {
+    CameraHandler::MODE_AI,
+    CameraHandler::MODE_GRAYSCALE,
+    CameraHandler::MODE_STREAMING,
+    CameraHandler::MODE_HIGH_RES,
+};
+const char* nombres[] = { "AI (RGB565)", "GRIS", "STREAMING (JPEG)", "ALTA CALIDAD (JPEG)" };
+int actual = 0;
+
+void setup() {
+    Serial.begin(115200);
+    Orbito.begin();
+
+    // Un ajuste propio: se conserva aunque la camara se reinicie
+    Orbito.Vision.setBrightness(1);
+
+    Orbito.Vision.setMode(modos[actual]);
+    Orbito.Display.consoleLog("Pulsa para cambiar de modo");
+}
+
+void loop() {
+    Orbito.update();
+
+    if (Orbito.System.getButtonStatus()) {
+        actual = (actual + 1) % 4;
+
+        if (Orbito.Vision.setMode(modos[actual])) {
+            CameraModeSwitch cambio = Orbito.Vision.getModeSwitchStats();
+            Orbito.Display.consoleLog(String("Modo ") + nombres[actual]);
+            Orbito.Display.consoleLog(String(cambio.total_us / 1000) + " ms" +
+                                      (cambio.reallocated ? " (reiniciada)" : " (al vuelo)"));
+            Serial.printf("%s: total %lu us | ajuste %lu us | descarte %lu us (%u fotos)\n",
+                          nombres[actual], cambio.total_us, cambio.reconfigure_us,
+                          cambio.flush_us, cambio.flushed);
+        } else {
+            Orbito.Display.consoleLog("No se pudo cambiar");
+        }
+
+        // Una foto con el modo nuevo (se comparte, no hay que soltarla)
+        FrameRef foto = Orbito.Vision.capture(100);
+        if (foto) Serial.printf("Foto: %ux%u, %u bytes\n", foto.width(), foto.height(), foto.length());
+
+        while (Orbito.System.getButtonStatus()) delay(10);
+    }
+}
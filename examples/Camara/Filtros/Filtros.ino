@@ -54,16 +54,10 @@ void loop() {
     Orbito.Display.consoleLog("Cargando " + obtenerNombreFiltro(filtro_actual) + "...");
 
     // -----------------------------------------------------
-    // 2. LIMPIEZA DE BUFFER (CRUCIAL AL CAMBIAR EFECTOS)
-    // -----------------------------------------------------
-    // Esperamos un poco y tiramos una foto a la basura.
-    delay(300); 
-    camera_fb_t* basura = Orbito.Vision.snapshot();
-    Orbito.Vision.release(basura);
-
-    // -----------------------------------------------------
-    // 3. CAPTURA REAL
+    // 2. CAPTURA
     // -----------------------------------------------------
+    // No hace falta tirar fotos a la basura: la camara descarta
+    // sola las que se tomaron antes de cambiar el filtro.
     camera_fb_t* frame = Orbito.Vision.snapshot();
 
     if (frame) {
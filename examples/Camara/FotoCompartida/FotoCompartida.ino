@@ -0,0 +1,33 @@
+#include <Orbito.h>
+
+// Una foto compartida (FrameRef) se puede pasar a la pantalla y a la IA
+// sin copiarla, y se suelta sola cuando nadie la usa.
+
+void setup() {
+    Serial.begin(115200);
+    Orbito.begin();
+
+    // RGB565: la pantalla la pinta sin descomprimir
+    Orbito.Vision.setMode(CameraHandler::MODE_AI);
+
+    // Si quieres, mira tambien la camara desde el movil: la retransmision
+    // y este programa se reparten las mismas fotos
+    // Orbito.Vision.startWebStream();
+}
+
+void loop() {
+    Orbito.update();
+
+    // Reutilizamos la ultima foto si tiene menos de 100 ms
+    FrameRef foto = Orbito.Vision.capture(100);
+    if (!foto) return;
+
+    Orbito.Display.drawSnapshot(foto);
+
+    // Una copia no duplica los pixeles: las dos miran la misma foto
+    FrameRef copia = foto;
+    Serial.printf("Foto %ux%u, %u usos, edad %lu ms\n",
+                  copia.width(), copia.height(), copia.useCount(), copia.age());
+
+    // No hace falta release(): las dos se sueltan al terminar loop()
+}
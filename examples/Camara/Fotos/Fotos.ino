@@ -11,7 +11,7 @@ void setup() {
     
     // 1. CONFIGURACIÓN
     // Ponemos la cámara en modo 'AI' (RGB565).
-    // Tu función drawSnapshot requiere RGB565, así que esto es obligatorio.
+    // drawSnapshot también acepta JPEG, pero en RGB565 se pinta sin descomprimir.
     Orbito.Vision.setMode(CameraHandler::MODE_AI);
 
     Orbito.Display.consoleLog("Listo.\nPulsa boton para FOTO");
@@ -37,7 +37,8 @@ void loop() {
 
             // 3. DIBUJAR
             // ¡Esta es la magia! Usamos tu función nativa.
-            // Ella sola se encarga de intercambiar los bytes de color y pintar.
+            // Ella sola ajusta la foto al tamaño de la pantalla y la pinta
+            // linea a linea, sin modificar la foto original.
             Orbito.Display.drawSnapshot(frame);
 
             // 4. LIBERAR MEMORIA
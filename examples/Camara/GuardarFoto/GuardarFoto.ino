@@ -0,0 +1,46 @@
+#include <Orbito.h>
+
+// Pulsa el boton para guardar una foto grande en la memoria permanente.
+// La foto pasa de la camara a la Flash poco a poco, sin copiarla en la RAM.
+
+int numero = 0;
+
+void setup() {
+    Serial.begin(115200);
+    Orbito.begin();
+
+    // Fotos JPEG de 1600x1200
+    Orbito.Vision.setMode(CameraHandler::MODE_HIGH_RES);
+
+    Orbito.Display.consoleLog("Pulsa para guardar foto");
+}
+
+void loop() {
+    Orbito.update();
+
+    if (Orbito.System.getButtonStatus()) {
+        // Solo guardamos 3 fotos: la cuarta sustituye a la primera
+        String nombre = "/foto" + String(numero) + ".jpg";
+        numero = (numero + 1) % 3;
+
+        unsigned long inicio = millis();
+        bool guardada = Orbito.Vision.saveSnapshot(nombre);
+        unsigned long tiempo = millis() - inicio;
+
+        if (guardada) {
+            // La foto es un archivo mas: la podemos leer con Storage
+            uint8_t cabecera[2];
+            Orbito.Storage.readBytes(nombre, 0, cabecera, 2);
+            bool esJpeg = (cabecera[0] == 0xFF && cabecera[1] == 0xD8);
+
+            Orbito.Display.consoleLog(nombre + " guardada en " + String(tiempo) + " ms");
+            Serial.printf("%s: %u bytes en %lu ms (%s) | Ocupado: %d bytes\n",
+                          nombre.c_str(), Orbito.Storage.fileSize(nombre), tiempo,
+                          esJpeg ? "JPEG correcto" : "JPEG roto", Orbito.Storage.getUsedSpace());
+        } else {
+            Orbito.Display.consoleLog("No se pudo guardar (memoria llena?)");
+        }
+
+        while (Orbito.System.getButtonStatus()) delay(10);
+    }
+}
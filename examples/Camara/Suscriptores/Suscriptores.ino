@@ -0,0 +1,56 @@
+#include <Orbito.h>
+
+// Una sola tarea lee la camara y reparte las fotos:
+// - la retransmision web recibe todas las que pueda enviar
+// - la pantalla solo 5 por segundo
+// - el "analisis" (aqui solo medimos el brillo) una de cada 4
+// Si alguien es lento se salta fotos, pero no frena a los demas.
+
+FrameSubscriber pantalla;
+FrameSubscriber analisis;
+
+unsigned long ultimoInforme = 0;
+
+void setup() {
+    Serial.begin(115200);
+    Orbito.begin();
+
+    // RGB565: la pantalla la pinta sin descomprimir
+    Orbito.Vision.setMode(CameraHandler::MODE_AI);
+
+    // Si hay WiFi, mira la camara desde el movil mientras tanto
+    // Orbito.Vision.startWebStream();
+
+    // La tarea de captura va en el nucleo 0, loop() sigue en el 1
+    Orbito.Vision.startCapture(0);
+    Orbito.Vision.subscribe(pantalla, 5);
+    Orbito.Vision.subscribe(analisis, 0, 4);
+}
+
+void loop() {
+    Orbito.update();
+
+    // Sin esperar: si no hay foto nueva seguimos con lo demas
+    FrameRef foto = pantalla.take();
+    if (foto) Orbito.Display.drawSnapshot(foto);
+
+    FrameRef muestra = analisis.take();
+    if (muestra) {
+        // Brillo medio del canal verde de unos pocos pixeles
+        const uint16_t* pixeles = (const uint16_t*)muestra.data();
+        uint32_t suma = 0;
+        size_t total = muestra.length() / 2;
+        for (size_t i = 0; i < total; i += 64) {
+            uint16_t p = __builtin_bswap16(pixeles[i]);
+            suma += (p >> 5) & 0x3F;
+        }
+        Serial.printf("Brillo: %lu\n", suma / (total / 64));
+    }
+
+    if (millis() - ultimoInforme >= 1000) {
+        ultimoInforme = millis();
+        Serial.printf("Camara: %.1f fps | Pantalla: %lu fotos, %lu saltadas | Analisis: %lu fotos\n",
+                      Orbito.Vision.getCaptureFps(), pantalla.delivered(), pantalla.dropped(),
+                      analisis.delivered());
+    }
+}
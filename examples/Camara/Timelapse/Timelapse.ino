@@ -0,0 +1,57 @@
+#include <Orbito.h>
+
+// Graba un timelapse (una foto cada 2 segundos) en la memoria permanente.
+// Pulsa el boton para terminar: despues repasamos las fotos guardadas.
+
+void setup() {
+    Serial.begin(115200);
+    Orbito.begin();
+
+    // Fotos JPEG de 320x240: caben muchas en la memoria
+    Orbito.Vision.setMode(CameraHandler::MODE_STREAMING);
+    Orbito.Vision.startCapture();
+
+    if (Orbito.Vision.startTimelapse("/timelapse", 2000)) {
+        Orbito.Display.consoleLog("Grabando... pulsa para parar");
+    } else {
+        Orbito.Display.consoleLog("No se pudo empezar a grabar");
+    }
+}
+
+void loop() {
+    Orbito.update();
+
+    if (Orbito.Vision.isRecording()) {
+        FrameLogStats datos = Orbito.Vision.getRecordingStats();
+        Serial.printf("Fotos: %u | Bytes: %lu | Memoria llena: %s\n",
+                      datos.frames, datos.bytes, datos.full ? "si" : "no");
+
+        if (Orbito.System.getButtonStatus()) {
+            // Al volver, el archivo ya esta completo
+            Orbito.Vision.stopRecording();
+            repasar();
+            while (Orbito.System.getButtonStatus()) delay(10);
+        }
+    }
+
+    delay(500);
+}
+
+void repasar() {
+    FrameLogReader lector;
+    if (!Orbito.Storage.openFrameLog("/timelapse", lector)) {
+        Orbito.Display.consoleLog("No hay grabacion");
+        return;
+    }
+    Orbito.Display.consoleLog(String(lector.count()) + " fotos guardadas");
+
+    // El lector solo lee la foto que toca, no el archivo entero
+    while (lector.next()) {
+        uint8_t cabecera[2];
+        lector.read(0, cabecera, 2);
+        bool esJpeg = (cabecera[0] == 0xFF && cabecera[1] == 0xD8);
+        Serial.printf("Foto %u: %lu bytes a los %lu ms (%s)\n",
+                      lector.index(), lector.length(), lector.timestamp(),
+                      esJpeg ? "JPEG correcto" : "JPEG roto");
+    }
+}
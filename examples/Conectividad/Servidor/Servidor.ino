@@ -67,7 +67,12 @@ void procesarComandoWeb(String id, int valor) {
     Orbito.System.tone(1800, 200); 
     
     Orbito.Action.blink();
-    delay(2000);
+    // Sin delay(): update() tiene que ejecutarse para que los ojos se vuelvan a abrir
+    unsigned long inicio = millis();
+    while (millis() - inicio < 2000) {
+      Orbito.update();
+      delay(10);
+    }
     Orbito.Action.setExpression(OrbitoRobot::ActionModule::NEUTRAL);
 
   } else if (id == "color") {
@@ -0,0 +1,34 @@
+#include <Orbito.h>
+
+// Todos los iconos que trae la libreria
+const char* iconos[] = {
+    "smile", "sad", "laugh", "heart", "star", "sun", "cloud", "rain",
+    "check", "cross", "warning", "battery", "wifi", "music", "question"
+};
+
+int actual = 0;
+unsigned long ultimoCambio = 0;
+
+void setup() {
+    Orbito.begin();
+    Orbito.Display.fillScreen(0x0000);
+
+    // Una fila de iconos pequeños (32x32)...
+    for (int i = 0; i < 8; i++) {
+        Orbito.Display.drawEmoji(iconos[i], 8 + i * 39, 10);
+    }
+    for (int i = 8; i < 15; i++) {
+        Orbito.Display.drawEmoji(iconos[i], 27 + (i - 8) * 39, 50);
+    }
+}
+
+void loop() {
+    Orbito.update();
+
+    // ...y uno grande (x4 = 128x128) que cambia cada segundo
+    if (millis() - ultimoCambio > 1000) {
+        ultimoCambio = millis();
+        Orbito.Display.drawEmoji(iconos[actual], 96, 100, 4, 0x0000);
+        actual = (actual + 1) % 15;
+    }
+}
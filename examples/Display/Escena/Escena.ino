@@ -0,0 +1,50 @@
+#include <Orbito.h>
+
+// La escena completa se apunta aqui y se vuelve a pintar en cada fotograma
+StaticDrawList<32> escena;
+
+// Posicion de la pelota
+int x = 40;
+int velocidad = 4;
+
+void setup() {
+
+  Serial.begin(115200);
+  Orbito.begin();
+
+  // Franjas de 40 filas: menos repeticiones, algo mas de memoria
+  Orbito.Display.setBandSize(40);
+  // Mientras se envia una franja, se pinta la siguiente en el otro nucleo
+  Orbito.Display.enableAsync(true);
+
+}
+
+void loop() {
+
+  Orbito.update();
+
+  // -----------------------------------------------------
+  // 1. APUNTAR LA ESCENA (fondo, pelota y texto encima)
+  // -----------------------------------------------------
+  escena.fillScreen(0x0010);
+  escena.fillRect(0, 200, 320, 40, 0x03E0);
+  escena.fillCircle(x, 150, 30, 0xF800);
+  escena.drawText(10, 10, "Sin parpadeos!", 0xFFFF, 2);
+
+  // -----------------------------------------------------
+  // 2. DIBUJARLA POR FRANJAS
+  // -----------------------------------------------------
+  // La pelota pasa por encima del texto y nunca se ve el fondo a medias
+  unsigned long inicio = micros();
+  Orbito.Display.drawScene(escena);
+  Serial.printf("Escena: %lu us\n", micros() - inicio);
+
+  // -----------------------------------------------------
+  // 3. MOVER LA PELOTA
+  // -----------------------------------------------------
+  x += velocidad;
+  if (x < 30 || x > 290) velocidad = -velocidad;
+
+  delay(20);
+
+}
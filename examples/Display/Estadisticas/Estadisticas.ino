@@ -0,0 +1,45 @@
+#include <Orbito.h>
+
+// IMPORTANTE: los contadores solo existen si la libreria se compila con
+// ORBITO_DISPLAY_STATS (PlatformIO: build_flags = -DORBITO_DISPLAY_STATS,
+// Arduino IDE: descomenta la linea en src/core/SPIHandler.h)
+
+unsigned long ultimoInforme = 0;
+int x = 0;
+
+void setup() {
+
+  Serial.begin(115200);
+  Orbito.begin();
+  Orbito.Display.enableCanvas(true);
+
+  // Empezamos a contar desde cero
+  DisplayStats datos;
+  if (!Orbito.Display.getStats(datos, true)) {
+    Serial.println("Estadisticas desactivadas: compila con ORBITO_DISPLAY_STATS");
+  }
+
+}
+
+void loop() {
+
+  // Una pequeña animacion para tener algo que medir
+  Orbito.Display.fillRect(x, 100, 20, 40, 0x0000);
+  x = (x + 4) % 300;
+  Orbito.Display.fillRect(x, 100, 20, 40, 0x07E0);
+
+  Orbito.update();
+
+  // Cada segundo mostramos los contadores y los ponemos a cero
+  if (millis() - ultimoInforme >= 1000) {
+    ultimoInforme = millis();
+    DisplayStats datos;
+    if (Orbito.Display.getStats(datos, true)) {
+      Serial.printf("FPS: %.1f | Figuras: %lu | Pixeles: %lu | Bytes: %lu\n",
+                    datos.fps, datos.primitives, datos.pixels, datos.bytes);
+      Serial.printf("Bus: %lu usos de la pantalla, %lu en total | Espera: %lu us | Ocupado: %lu us\n\n",
+                    datos.transactions, datos.bus.locks, datos.bus.wait_us, datos.bus.hold_us);
+    }
+  }
+
+}
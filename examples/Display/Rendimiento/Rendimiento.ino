@@ -0,0 +1,53 @@
+#include <Orbito.h>
+
+// Numero de figuras que se dibujan en cada prueba
+const int N = 300;
+
+// Lista de comandos (cada comando ocupa 16 bytes, por eso la declaramos global)
+StaticDrawList<N> lista;
+
+void setup() {
+
+  Serial.begin(115200);
+  Orbito.begin();
+
+}
+
+void loop() {
+
+  Orbito.update();
+
+  // -----------------------------------------------------
+  // 1. N LLAMADAS INDIVIDUALES
+  // -----------------------------------------------------
+  // Cada llamada bloquea el bus SPI y abre su propia transaccion
+  Orbito.Display.fillScreen(0x0000);
+  unsigned long inicio = micros();
+  for (int i = 0; i < N; i++) {
+    Orbito.Display.fillRect((i * 7) % 300, (i * 13) % 230, 20, 1, 0xF800);
+  }
+  unsigned long individual = micros() - inicio;
+
+  // -----------------------------------------------------
+  // 2. LAS MISMAS N FIGURAS EN UNA LISTA
+  // -----------------------------------------------------
+  // Se graban en memoria y se envian todas con un unico bloqueo del bus
+  Orbito.Display.fillScreen(0x0000);
+  inicio = micros();
+  lista.clear();
+  for (int i = 0; i < N; i++) {
+    lista.fillRect((i * 7) % 300, (i * 13) % 230, 20, 1, 0x07E0);
+  }
+  Orbito.Display.submit(lista);
+  unsigned long lote = micros() - inicio;
+
+  // -----------------------------------------------------
+  // 3. RESULTADOS
+  // -----------------------------------------------------
+  Serial.printf("Individual: %lu us (%.1f us/figura)\n", individual, (float)individual / N);
+  Serial.printf("En lista:   %lu us (%.1f us/figura)\n", lote, (float)lote / N);
+  Serial.printf("Mejora:     x%.1f\n\n", (float)individual / lote);
+
+  delay(2000);
+
+}
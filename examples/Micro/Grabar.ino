@@ -23,10 +23,9 @@ void loop() {
   if (Orbito.System.getButtonStatus()) {
 
     // 1. Feedback visual
-    Orbito.Display.fillScreen(0xF800); // Pantalla Roja (Grabando)
-    Orbito.Display.setCursor(80, 140);
-    Orbito.Display.setTextColor(0xFFFF);
-    Orbito.Display.print("GRABANDO...");
+    Orbito.Display.setConsoleStyle(3, 0xFFFF, 0xF800); // Pantalla Roja (Grabando)
+    Orbito.Display.consoleClear();
+    Orbito.Display.consoleLog("GRABANDO...");
 
     // 2. CAPTURAR (La librería gestiona la memoria y el hardware)
     int16_t* audio = Orbito.Ear.capture(DURACION_GRABACION);
@@ -34,7 +33,8 @@ void loop() {
     // 3. PROCESAR (Aquí el usuario decide qué hacer)
     if (audio != NULL) {
 
-      Orbito.Display.fillScreen(0x0000); // Negro
+      Orbito.Display.setConsoleStyle(2, 0xFFFF, 0x0000); // Negro
+      Orbito.Display.consoleClear();
       Orbito.Display.consoleLog("Enviando USB...");
 
       // Calculamos cuántas muestras hay: (16000 muestras/seg * ms) / 1000
@@ -59,7 +59,8 @@ void loop() {
 
     // Esperar a soltar botón
     while(Orbito.System.getButtonStatus()) delay(10);
-    Orbito.Display.fillScreen(0x0000);
+    Orbito.Display.setConsoleStyle(2, 0xFFFF, 0x0000);
+    Orbito.Display.consoleClear();
     Orbito.Display.consoleLog("Listo.");
 
   }
@@ -8,8 +8,7 @@ void setup() {
 
 void loop() {
     // 1. Fase Activa
-    Orbito.Display.fillScreen(0x0000); // Limpiar
-    Orbito.Display.setCursor(0,0);
+    Orbito.Display.consoleClear(); // Limpiar
     Orbito.Display.consoleLog("TRABAJANDO...");
     delay(2000);
 
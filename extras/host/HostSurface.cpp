@@ -0,0 +1,105 @@
+#include "HostSurface.h"
+#include <stdio.h>
+
+HostSurface::HostSurface(int16_t w, int16_t h) : Adafruit_GFX(w, h)
+{
+    _pixels = (uint16_t*)calloc((size_t)w * h, sizeof(uint16_t));
+    _written = 0;
+}
+
+HostSurface::~HostSurface()
+{
+    free(_pixels);
+}
+
+void HostSurface::drawPixel(int16_t x, int16_t y, uint16_t color)
+{
+    if (x < 0 || y < 0 || x >= _width || y >= _height) return;
+    _pixels[y * _width + x] = color;
+    _written++;
+}
+
+void HostSurface::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+    fillRect(x, y, w, 1, color);
+}
+
+void HostSurface::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+    fillRect(x, y, 1, h, color);
+}
+
+void HostSurface::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+    // Same clipping as the panel and the canvas
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (x + w > _width) w = _width - x;
+    if (y + h > _height) h = _height - y;
+    if (w <= 0 || h <= 0) return;
+    for (int16_t row = y ; row < y + h ; row++)
+    {
+        uint16_t* dst = &_pixels[row * _width + x];
+        for (int16_t i = 0 ; i < w ; i++) dst[i] = color;
+    }
+    _written += (uint32_t)w * h;
+}
+
+void HostSurface::fillScreen(uint16_t color)
+{
+    fillRect(0, 0, _width, _height, color);
+}
+
+uint16_t* HostSurface::pixels()
+{
+    return _pixels;
+}
+
+uint16_t HostSurface::pixel(int16_t x, int16_t y) const
+{
+    return _pixels[y * _width + x];
+}
+
+uint32_t HostSurface::written() const
+{
+    return _written;
+}
+
+void HostSurface::resetCount()
+{
+    _written = 0;
+}
+
+uint32_t HostSurface::diff(const HostSurface& other) const
+{
+    uint32_t count = 0;
+    for (int32_t i = 0 ; i < (int32_t)_width * _height ; i++)
+        if (_pixels[i] != other._pixels[i]) count++;
+    return count;
+}
+
+uint64_t HostSurface::checksum() const
+{
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (int32_t i = 0 ; i < (int32_t)_width * _height ; i++)
+    {
+        hash = (hash ^ (_pixels[i] & 0xFF)) * 0x100000001B3ULL;
+        hash = (hash ^ (_pixels[i] >> 8)) * 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+bool HostSurface::savePpm(const char* path) const
+{
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+    fprintf(f, "P6\n%d %d\n255\n", _width, _height);
+    for (int32_t i = 0 ; i < (int32_t)_width * _height ; i++)
+    {
+        uint16_t c = _pixels[i];
+        uint8_t rgb[3] = { (uint8_t)((c >> 8) & 0xF8), (uint8_t)((c >> 3) & 0xFC), (uint8_t)((c << 3) & 0xF8) };
+        fwrite(rgb, 1, 3, f);
+    }
+    fclose(f);
+    return true;
+}
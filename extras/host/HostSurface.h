@@ -0,0 +1,46 @@
+#ifndef HOST_SURFACE_H
+#define HOST_SURFACE_H
+
+#include <Adafruit_GFX.h>
+
+/**
+ * @brief RGB565 frame in memory (CPU byte order) that counts every pixel
+ * written, so a DrawList can be replayed on a computer exactly as on the robot.
+ */
+class HostSurface : public Adafruit_GFX {
+
+    public:
+
+        HostSurface(int16_t w, int16_t h);
+        ~HostSurface();
+
+        void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+        void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+        void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+        void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+        void fillScreen(uint16_t color) override;
+
+        uint16_t* pixels();
+        uint16_t pixel(int16_t x, int16_t y) const;
+
+        // Pixels written since the last reset (the same pixel may count twice)
+        uint32_t written() const;
+        void resetCount();
+
+        // Pixels that differ from another surface of the same size
+        uint32_t diff(const HostSurface& other) const;
+
+        // FNV-1a hash of the whole frame (any changed pixel changes it)
+        uint64_t checksum() const;
+
+        // Saves the frame as a binary PPM image
+        bool savePpm(const char* path) const;
+
+    private:
+
+        uint16_t* _pixels;
+        uint32_t _written;
+
+};
+
+#endif
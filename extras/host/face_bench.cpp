@@ -0,0 +1,205 @@
+/**
+ * @file face_bench.cpp
+ * @brief Renders every expression of the Orbito face on the computer and
+ * measures it: drawing speed, pixels written and pixels that change between
+ * expressions. Same code as the robot (src/core/FaceRenderer), replayed on an
+ * RGB565 frame in memory instead of the panel.
+ *
+ * Usage: ./face_bench [frames] [--dump folder]
+ *        ./face_bench --test golden [--update] [--dump folder]
+ * --dump saves each expression as a PPM image, to compare faces before and
+ * after a change.
+ * --test compares every expression (still, looking aside and with the eyes
+ * closed) with the checksums in the golden folder and exits with 1 if any
+ * pixel differs (make test). --update rewrites them after an intended change.
+ */
+
+#include "HostSurface.h"
+#include "../../src/core/FaceRenderer.h"
+#include "../../src/core/RleSprite.h"
+#include <stdio.h>
+#include <chrono>
+
+static const char* EMOTION_NAMES[FACE_EMOTIONS] = { "WORRY", "ANGRY", "HAPPY", "NEUTRAL", "SURPRISE", "SLEEPY", "SAD" };
+
+// Commands of a whole face fit with room to spare (the robot uses 512)
+static StaticDrawList<512> _list;
+
+// Draws a whole face with the pupils moved
+static void _drawFace(HostSurface& surface, FaceEmotion e, int16_t pupil_x = 0, int16_t pupil_y = 0)
+{
+    _list.clear();
+    _list.fillScreen(0x0000);
+    faceRenderMouth(_list, faceMouthParams(e));
+    faceRedrawEyes(_list, e, pupil_x, pupil_y);
+    _list.replay(surface);
+}
+
+// Views of each expression checked by --test
+#define GOLDEN_VIEWS 3
+static const char* VIEW_NAMES[GOLDEN_VIEWS] = { "still", "look", "closed" };
+
+// Draws one view of an expression
+static void _drawView(HostSurface& surface, FaceEmotion e, uint8_t view)
+{
+    switch (view)
+    {
+        case 0: _drawFace(surface, e); break;
+        case 1: _drawFace(surface, e, 5, -3); break;
+        case 2:
+            _drawFace(surface, e);
+            _list.clear();
+            faceRecordPart(_list, e, FACE_EYES_CLOSED);
+            _list.replay(surface);
+            break;
+    }
+}
+
+// Reads the checksums of a reference file (lines "view hash", # = comment)
+static void _readGolden(const char* path, uint64_t* hashes, bool* found)
+{
+    for (uint8_t v = 0 ; v < GOLDEN_VIEWS ; v++) found[v] = false;
+    FILE* f = fopen(path, "r");
+    if (!f) return;
+    char line[128], name[32];
+    unsigned long long hash;
+    while (fgets(line, sizeof(line), f))
+    {
+        if (line[0] == '#' || sscanf(line, "%31s %llx", name, &hash) != 2) continue;
+        for (uint8_t v = 0 ; v < GOLDEN_VIEWS ; v++)
+        {
+            if (strcmp(name, VIEW_NAMES[v]) != 0) continue;
+            hashes[v] = hash;
+            found[v] = true;
+        }
+    }
+    fclose(f);
+}
+
+// Checks every view against the golden folder (or rewrites it), returns the failures
+static int _goldenTest(const char* folder, bool update, const char* dump)
+{
+    HostSurface surface(FACE_SCREEN_W, FACE_SCREEN_H);
+    int failures = 0;
+    for (uint8_t i = 0 ; i < FACE_EMOTIONS ; i++)
+    {
+        char path[256];
+        snprintf(path, sizeof(path), "%s/face_%s.txt", folder, EMOTION_NAMES[i]);
+        uint64_t expected[GOLDEN_VIEWS], actual[GOLDEN_VIEWS];
+        bool found[GOLDEN_VIEWS];
+        if (!update) _readGolden(path, expected, found);
+        for (uint8_t v = 0 ; v < GOLDEN_VIEWS ; v++)
+        {
+            _drawView(surface, (FaceEmotion)i, v);
+            actual[v] = surface.checksum();
+            if (update || (found[v] && actual[v] == expected[v])) continue;
+            failures++;
+            printf("%-9s %-7s %s (got %016llx)\n", EMOTION_NAMES[i], VIEW_NAMES[v],
+                   found[v] ? "MISMATCH" : "NO REFERENCE", (unsigned long long)actual[v]);
+            if (dump)
+            {
+                char image[256];
+                snprintf(image, sizeof(image), "%s/face_%s_%s.ppm", dump, EMOTION_NAMES[i], VIEW_NAMES[v]);
+                if (!surface.savePpm(image)) printf("Cannot write %s\n", image);
+            }
+        }
+        if (!update) continue;
+        FILE* f = fopen(path, "w");
+        if (!f)
+        {
+            printf("Cannot write %s\n", path);
+            return 1;
+        }
+        fprintf(f, "# %s %dx%d RGB565, FNV-1a of each view (./face_bench --test golden --update)\n",
+                EMOTION_NAMES[i], FACE_SCREEN_W, FACE_SCREEN_H);
+        for (uint8_t v = 0 ; v < GOLDEN_VIEWS ; v++) fprintf(f, "%s %016llx\n", VIEW_NAMES[v], (unsigned long long)actual[v]);
+        fclose(f);
+    }
+    if (update) printf("Golden checksums written to %s\n", folder);
+    else if (failures) printf("%d of %d views differ from %s (--dump folder saves them)\n", failures, FACE_EMOTIONS * GOLDEN_VIEWS, folder);
+    else printf("All %d views match %s\n", FACE_EMOTIONS * GOLDEN_VIEWS, folder);
+    return failures;
+}
+
+// Frames per second of a drawing function (recording and rasterizing)
+template <typename F>
+static float _fps(uint32_t frames, F draw)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0 ; i < frames ; i++) draw();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return seconds > 0 ? frames / seconds : 0;
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t frames = 200;
+    const char* dump = NULL;
+    const char* golden = NULL;
+    bool update = false;
+    for (int i = 1 ; i < argc ; i++)
+    {
+        if (strcmp(argv[i], "--dump") == 0 && i + 1 < argc) dump = argv[++i];
+        else if (strcmp(argv[i], "--test") == 0 && i + 1 < argc) golden = argv[++i];
+        else if (strcmp(argv[i], "--update") == 0) update = true;
+        else frames = max(atoi(argv[i]), 1);
+    }
+    if (golden) return _goldenTest(golden, update, dump) ? 1 : 0;
+    HostSurface surface(FACE_SCREEN_W, FACE_SCREEN_H);
+    HostSurface* faces[FACE_EMOTIONS];
+    printf("Orbito face on the host: %dx%d RGB565, %u frames per measure\n\n", FACE_SCREEN_W, FACE_SCREEN_H, frames);
+    printf("%-9s %5s %10s %9s %9s %9s %9s\n", "Emotion", "Cmds", "Written", "Face fps", "Eyes fps", "Look px", "Sprite B");
+    for (uint8_t i = 0 ; i < FACE_EMOTIONS ; i++)
+    {
+        FaceEmotion e = (FaceEmotion)i;
+        // Reference frame of the expression and the pixels written to draw it
+        faces[i] = new HostSurface(FACE_SCREEN_W, FACE_SCREEN_H);
+        _drawFace(*faces[i], e);
+        uint16_t commands = _list.size();
+        uint32_t written = faces[i]->written();
+        // Whole face (instant change without sprites) and eyes only (blinks, pupils, transitions)
+        float face_fps = _fps(frames, [&]() { _drawFace(surface, e); });
+        float eyes_fps = _fps(frames, [&]() {
+            _list.clear();
+            faceRedrawEyes(_list, e, 0, 0);
+            _list.replay(surface);
+        });
+        // Pixels that change when the pupils move 5 px to the right
+        _drawFace(surface, e, 5, 0);
+        uint32_t look = surface.diff(*faces[i]);
+        // Memory of the pre-rendered face
+        RleSprite sprite;
+        _list.clear();
+        faceRecordPart(_list, e, FACE_WHOLE);
+        sprite.build(_list, FACE_SCREEN_W, FACE_SCREEN_H, 0, 0, FACE_SCREEN_W, FACE_SCREEN_H, 0x0000);
+        printf("%-9s %5u %10u %9.0f %9.0f %9u %9u\n", EMOTION_NAMES[i], commands, written, face_fps, eyes_fps, look, sprite.memoryUsed());
+        if (dump)
+        {
+            char path[256];
+            snprintf(path, sizeof(path), "%s/face_%s.ppm", dump, EMOTION_NAMES[i]);
+            if (!faces[i]->savePpm(path)) printf("Cannot write %s\n", path);
+        }
+    }
+    // Pixels that differ between two expressions: what an expression change has to send
+    printf("\nPixels that change from one expression (row) to another (column)\n%-9s", "");
+    for (uint8_t j = 0 ; j < FACE_EMOTIONS ; j++) printf(" %8.8s", EMOTION_NAMES[j]);
+    printf("\n");
+    uint64_t total = 0;
+    for (uint8_t i = 0 ; i < FACE_EMOTIONS ; i++)
+    {
+        printf("%-9s", EMOTION_NAMES[i]);
+        for (uint8_t j = 0 ; j < FACE_EMOTIONS ; j++)
+        {
+            uint32_t changed = faces[i]->diff(*faces[j]);
+            total += changed;
+            printf(" %8u", changed);
+        }
+        printf("\n");
+    }
+    uint32_t changes = FACE_EMOTIONS * (FACE_EMOTIONS - 1);
+    uint32_t screen = FACE_SCREEN_W * FACE_SCREEN_H;
+    printf("\nAverage change: %llu px (%.1f%% of the %u px a full redraw sends)\n",
+           (unsigned long long)(total / changes), 100.0 * total / changes / screen, screen);
+    for (uint8_t i = 0 ; i < FACE_EMOTIONS ; i++) delete faces[i];
+    return 0;
+}
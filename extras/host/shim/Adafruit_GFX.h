@@ -0,0 +1,48 @@
+#ifndef HOST_ADAFRUIT_GFX_H
+#define HOST_ADAFRUIT_GFX_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Host stand-in for the Adafruit GFX base class: only what DrawList,
+ * BandCanvas and the face code use. Every primitive ends in drawPixel(),
+ * drawFastHLine(), drawFastVLine() or fillRect(), the same virtual calls the
+ * real library makes, so a surface that overrides them sees the same pixels.
+ */
+class Adafruit_GFX {
+
+    public:
+
+        Adafruit_GFX(int16_t w, int16_t h);
+        virtual ~Adafruit_GFX() {}
+
+        // Surface hooks
+        virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+        virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+        virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+        virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+        virtual void fillScreen(uint16_t color);
+
+        // Transaction API used by DrawList::replay()
+        virtual void startWrite();
+        virtual void endWrite();
+        virtual void writePixel(int16_t x, int16_t y, uint16_t color);
+        virtual void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+        virtual void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+        virtual void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+        virtual void writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+
+        // Text is not part of the face: characters are skipped
+        void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size);
+
+        int16_t width() const;
+        int16_t height() const;
+
+    protected:
+
+        int16_t WIDTH, HEIGHT;
+        int16_t _width, _height;
+
+};
+
+#endif
@@ -0,0 +1,55 @@
+// Word wrap checks: make test builds this with AddressSanitizer
+
+#include <stdio.h>
+#include "TextLayout.h"
+
+static int failures = 0;
+
+static void expect(const char* name, const char* text, uint8_t columns, const char* const* lines, uint16_t count)
+{
+    TextLayout layout;
+    if (!layout.build(text, columns))
+    {
+        printf("FAIL %s: build\n", name);
+        failures++;
+        return;
+    }
+    bool ok = layout.lineCount() == count;
+    for (uint16_t i = 0; ok && i < count; i++) ok = strcmp(layout.line(i), lines[i]) == 0;
+    if (!ok)
+    {
+        printf("FAIL %s: %u lines\n", name, layout.lineCount());
+        for (uint16_t i = 0; i < layout.lineCount(); i++) printf("  [%s]\n", layout.line(i));
+        failures++;
+        return;
+    }
+    printf("ok   %s\n", name);
+}
+
+int main()
+{
+    const char* words[] = { "hola que", "tal" };
+    expect("words", "hola que tal", 8, words, 2);
+
+    const char* breaks[] = { "uno", "", "dos" };
+    expect("breaks", "uno\n\ndos", 10, breaks, 3);
+
+    // Cut inside the word: every line but the last is full, none ends at a space
+    char word[101];
+    memset(word, 'a', 100);
+    word[100] = '\0';
+    const char* cut[] = { "aaaaaaaaaaaaaaaaaaaaaaa", "aaaaaaaaaaaaaaaaaaaaaaa", "aaaaaaaaaaaaaaaaaaaaaaa",
+                          "aaaaaaaaaaaaaaaaaaaaaaa", "aaaaaaaa" };
+    expect("long word", word, 23, cut, 5);
+
+    const char* one[] = { "a", "b", "c", "d" };
+    expect("one column", "abcd", 1, one, 4);
+
+    char mixed[200];
+    snprintf(mixed, sizeof(mixed), "ok %s fin", word);
+    const char* split[] = { "ok", "aaaaaaaaaaaaaaaaaaaaaaa", "aaaaaaaaaaaaaaaaaaaaaaa", "aaaaaaaaaaaaaaaaaaaaaaa",
+                            "aaaaaaaaaaaaaaaaaaaaaaa", "aaaaaaaa fin" };
+    expect("word between words", mixed, 23, split, 6);
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,276 @@
+#!/usr/bin/env python3
+"""
+Builds src/core/EmojiData.h, the emoji atlas used by Orbito.Display.drawEmoji().
+
+    python3 make_emoji_atlas.py                       # built-in icons only
+    python3 make_emoji_atlas.py --png-dir mis_iconos  # + every PNG of a folder
+
+Every icon is stored as indexed-palette RLE (up to 15 colors + transparent)
+and names are found through a perfect hash: the seed below places every name
+in its own slot, so the library does one hash and one string compare.
+PNG icons need Pillow (pip install pillow), the file name is the emoji name.
+
+RLE byte: high nibble = palette index (0 = transparent), low nibble = run - 1.
+A low nibble of 15 means the run is 16 + the next byte. Runs go on from one
+row to the next.
+"""
+
+import argparse
+import math
+import os
+import sys
+
+SIZE = 32
+MAX_SIDE = 64   # EMOJI_MAX_SIDE in src/core/EmojiAtlas.h
+OUTPUT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "..", "src", "core", "EmojiData.h")
+
+# --- Tiny rasterizer for the built-in icons (pixel centers, no antialiasing) ---
+
+
+def circle(cx, cy, r):
+    return lambda x, y: (x - cx) ** 2 + (y - cy) ** 2 <= r * r
+
+
+def ellipse(cx, cy, rx, ry):
+    return lambda x, y: ((x - cx) / rx) ** 2 + ((y - cy) / ry) ** 2 <= 1
+
+
+def rect(x0, y0, x1, y1):
+    return lambda x, y: x0 <= x <= x1 and y0 <= y <= y1
+
+
+def ring(cx, cy, r0, r1, a0=0, a1=360):
+    # Angles in degrees, counterclockwise with y up
+    def inside(x, y):
+        d = math.hypot(x - cx, y - cy)
+        a = math.degrees(math.atan2(cy - y, x - cx)) % 360
+        return r0 <= d <= r1 and (a0 <= a <= a1 or a0 <= a + 360 <= a1)
+    return inside
+
+
+def line(x0, y0, x1, y1, width):
+    def inside(x, y):
+        dx, dy = x1 - x0, y1 - y0
+        t = max(0, min(1, ((x - x0) * dx + (y - y0) * dy) / float(dx * dx + dy * dy)))
+        return math.hypot(x - x0 - t * dx, y - y0 - t * dy) <= width / 2.0
+    return inside
+
+
+def poly(points):
+    def inside(x, y):
+        result = False
+        j = len(points) - 1
+        for i in range(len(points)):
+            xi, yi = points[i]
+            xj, yj = points[j]
+            if (yi > y) != (yj > y) and x < (xj - xi) * (y - yi) / float(yj - yi) + xi:
+                result = not result
+            j = i
+        return result
+    return inside
+
+
+def star(cx, cy, r_out, r_in, tips=5):
+    points = []
+    for i in range(tips * 2):
+        r = r_out if i % 2 == 0 else r_in
+        a = math.pi / tips * i - math.pi / 2
+        points.append((cx + r * math.cos(a), cy + r * math.sin(a)))
+    return poly(points)
+
+
+def union(*shapes):
+    return lambda x, y: any(s(x, y) for s in shapes)
+
+
+YELLOW = (255, 204, 0)
+ORANGE = (255, 140, 0)
+BROWN = (90, 50, 10)
+BLACK = (0, 0, 0)
+WHITE = (255, 255, 255)
+GREY = (170, 180, 190)
+RED = (230, 30, 40)
+GREEN = (40, 190, 60)
+BLUE = (40, 120, 230)
+LIGHT_BLUE = (120, 200, 255)
+
+C = 15.5    # Center of a 32x32 icon
+FACE = [(circle(C, C, 15), BROWN), (circle(C, C, 14), YELLOW)]
+
+ICONS = {
+    "smile": FACE + [
+        (ellipse(10.5, 11.5, 2, 3), BROWN), (ellipse(20.5, 11.5, 2, 3), BROWN),
+        (ring(C, 16, 7, 9.5, 200, 340), BROWN)],
+    "sad": FACE + [
+        (ellipse(10.5, 11.5, 2, 3), BROWN), (ellipse(20.5, 11.5, 2, 3), BROWN),
+        (ring(C, 28, 7, 9.5, 30, 150), BROWN),
+        (union(circle(8.5, 19, 2.5), poly([(6.2, 18.5), (10.8, 18.5), (8.5, 14)])), LIGHT_BLUE)],
+    "laugh": FACE + [
+        (ring(10.5, 13, 2, 3.5, 20, 160), BROWN), (ring(20.5, 13, 2, 3.5, 20, 160), BROWN),
+        (union(ring(C, 16, 0, 9.5, 180, 360)), BROWN), (ring(C, 16, 0, 8, 200, 340), RED),
+        (rect(7, 16, 24, 18), WHITE)],
+    "heart": [(union(circle(10, 11, 7.5), circle(21, 11, 7.5), poly([(3, 13.5), (28, 13.5), (15.5, 28)])), RED),
+              (ellipse(8.5, 8.5, 2, 1.5), WHITE)],
+    "star": [(star(C, 17, 15.5, 6.5), ORANGE), (star(C, 17, 13, 5.2), YELLOW)],
+    "sun": [(union(*[line(C + 10 * math.cos(a), C + 10 * math.sin(a), C + 15 * math.cos(a), C + 15 * math.sin(a), 3)
+                     for a in [i * math.pi / 4 for i in range(8)]]), ORANGE),
+            (circle(C, C, 8.5), ORANGE), (circle(C, C, 7), YELLOW)],
+    "cloud": [(union(circle(10, 19, 6.5), circle(17, 14, 8.5), circle(24, 19, 6), rect(10, 19, 24, 25.5)), GREY),
+              (union(circle(10, 19, 5.5), circle(17, 14, 7.5), circle(24, 19, 5), rect(10, 19, 24, 24.5)), WHITE)],
+    "rain": [(union(circle(10, 12, 6.5), circle(17, 8, 7.5), circle(24, 12, 6), rect(10, 12, 24, 18.5)), GREY),
+             (union(circle(10, 12, 5.5), circle(17, 8, 6.5), circle(24, 12, 5), rect(10, 12, 24, 17.5)), WHITE),
+             (union(line(9, 22, 7, 28, 2), line(16, 22, 14, 28, 2), line(23, 22, 21, 28, 2)), BLUE)],
+    "check": [(circle(C, C, 15), GREEN), (union(line(8, 16, 13.5, 21.5, 4), line(13.5, 21.5, 24, 10, 4)), WHITE)],
+    "cross": [(circle(C, C, 15), RED), (union(line(10, 10, 21, 21, 4), line(21, 10, 10, 21, 4)), WHITE)],
+    "warning": [(poly([(C, 1), (31, 29), (0, 29)]), BLACK), (poly([(C, 4.5), (28, 27), (3, 27)]), YELLOW),
+                (union(line(C, 11, C, 19, 3.5), circle(C, 23.5, 2)), BLACK)],
+    "battery": [(rect(1, 8, 28, 23), BLACK), (rect(29, 12, 31, 19), BLACK), (rect(3, 10, 26, 21), WHITE),
+                (union(rect(5, 12, 10, 19), rect(12, 12, 17, 19), rect(19, 12, 24, 19)), GREEN)],
+    "wifi": [(union(ring(C, 27, 19, 23, 45, 135), ring(C, 27, 11, 15, 45, 135), circle(C, 26, 3.5)), BLUE)],
+    "music": [(union(ellipse(9, 25, 5, 3.8), ellipse(24, 21, 5, 3.8), rect(12, 5, 14, 24), rect(27, 2, 29, 20),
+                     poly([(12, 5), (29, 1), (29, 6), (12, 10)])), BLACK)],
+    "question": [(circle(C, C, 15), BLUE),
+                 (union(ring(C, 12, 3.5, 7, -90, 180), rect(14, 16.5, 17, 21), circle(C, 25, 2)), WHITE)],
+}
+
+
+def render_builtin(shapes):
+    pixels = []
+    for y in range(SIZE):
+        row = []
+        for x in range(SIZE):
+            color = None
+            for shape, c in shapes:
+                if shape(x, y):
+                    color = c
+            row.append(color)
+        pixels.append(row)
+    return SIZE, SIZE, pixels
+
+
+def load_png(path):
+    try:
+        from PIL import Image
+    except ImportError:
+        sys.exit("error: PNG icons need Pillow: pip install pillow")
+    image = Image.open(path).convert("RGBA")
+    w, h = image.size
+    if w > MAX_SIDE or h > 255:
+        sys.exit("error: %s is larger than %dx255" % (path, MAX_SIDE))
+    data = list(image.getdata())
+    pixels = [[(r, g, b) if a >= 128 else None for r, g, b, a in data[y * w:(y + 1) * w]] for y in range(h)]
+    return w, h, pixels
+
+
+# --- Encoding ---
+
+
+def rgb565(c):
+    r, g, b = c
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)
+
+
+def encode(name, w, h, pixels):
+    palette = []
+    indices = []
+    for row in pixels:
+        for c in row:
+            if c is None:
+                indices.append(0)
+                continue
+            value = rgb565(c)
+            if value not in palette:
+                palette.append(value)
+            indices.append(palette.index(value) + 1)
+    if len(palette) > 15:
+        sys.exit("error: %s has %d colors (15 at most)" % (name, len(palette)))
+    rle = bytearray()
+    i = 0
+    while i < len(indices):
+        run = 1
+        while i + run < len(indices) and indices[i + run] == indices[i] and run < 16 + 255:
+            run += 1
+        if run < 16:
+            rle.append((indices[i] << 4) | (run - 1))
+        else:
+            rle += bytes([(indices[i] << 4) | 15, run - 16])
+        i += run
+    return palette, rle
+
+
+def fnv1a(name, seed):
+    h = (2166136261 ^ seed) & 0xFFFFFFFF
+    for ch in name.encode():
+        h = ((h ^ ch) * 16777619) & 0xFFFFFFFF
+    # Final mix, so the low bits used for the slot depend on every character
+    h ^= h >> 16
+    h = (h * 0x85EBCA6B) & 0xFFFFFFFF
+    h ^= h >> 13
+    return h
+
+
+def perfect_hash(names):
+    # Smallest power of two with a seed that gives every name its own slot
+    size = 1
+    while size < len(names):
+        size *= 2
+    while True:
+        for seed in range(1000000):
+            slots = set(fnv1a(n, seed) & (size - 1) for n in names)
+            if len(slots) == len(names):
+                return size, seed
+        size *= 2
+
+
+def write_header(icons, path):
+    names = [n for n, _, _, _ in icons]
+    size, seed = perfect_hash(names)
+    slots = [-1] * size
+    for i, n in enumerate(names):
+        slots[fnv1a(n, seed) & (size - 1)] = i
+    palettes, data, table = [], bytearray(), []
+    raw = 0
+    for name, w, h, pixels in icons:
+        palette, rle = encode(name, w, h, pixels)
+        table.append((name, w, h, len(palettes), len(palette), len(data)))
+        palettes += palette
+        data += rle
+        raw += w * h * 2
+    with open(path, "w") as out:
+        out.write("// Generated by extras/tools/make_emoji_atlas.py, do not edit\n")
+        out.write("// %d icons, %d bytes of RLE (%d as raw RGB565)\n\n" % (len(icons), len(data), raw))
+        out.write("#define EMOJI_COUNT %d\n" % len(icons))
+        out.write("#define EMOJI_HASH_SIZE %d\n" % size)
+        out.write("#define EMOJI_HASH_SEED %du\n" % seed)
+        out.write("#define EMOJI_MAX_WIDTH %d\n\n" % max(w for _, w, _, _ in icons))
+        out.write("static const int8_t emoji_slots[EMOJI_HASH_SIZE] = { %s };\n\n" % ", ".join(str(s) for s in slots))
+        out.write("static const uint16_t emoji_palette[] = {\n")
+        for i in range(0, len(palettes), 12):
+            out.write("    " + ", ".join("0x%04X" % c for c in palettes[i:i + 12]) + ",\n")
+        out.write("};\n\n")
+        out.write("static const uint8_t emoji_rle[] = {\n")
+        for i in range(0, len(data), 16):
+            out.write("    " + ", ".join("0x%02X" % b for b in data[i:i + 16]) + ",\n")
+        out.write("};\n\n")
+        out.write("static const EmojiInfo emoji_table[EMOJI_COUNT] = {\n")
+        for name, w, h, pal, colors, offset in table:
+            out.write("    { \"%s\", %d, %d, %d, %d, %d },\n" % (name, w, h, colors, pal, offset))
+        out.write("};\n")
+    print("%s: %d icons, %d bytes of RLE (raw: %d), hash %d slots seed %d" % (path, len(icons), len(data), raw, size, seed))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Orbito emoji atlas generator")
+    parser.add_argument("--png-dir", help="folder with extra PNG icons (name.png)")
+    parser.add_argument("--output", default=OUTPUT)
+    args = parser.parse_args()
+    icons = [(name,) + render_builtin(shapes) for name, shapes in ICONS.items()]
+    if args.png_dir:
+        for f in sorted(os.listdir(args.png_dir)):
+            if f.lower().endswith(".png"):
+                icons.append((os.path.splitext(f)[0].lower(),) + load_png(os.path.join(args.png_dir, f)))
+    write_header(icons, os.path.normpath(args.output))
+
+
+if __name__ == "__main__":
+    main()
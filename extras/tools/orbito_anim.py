@@ -0,0 +1,139 @@
+#!/usr/bin/env python3
+"""
+Converts a JSON animation description into the ORBA binary format played by
+Orbito.Action.playAnimation() (see src/core/KeyframeStream.h).
+
+    python3 orbito_anim.py saludo.json saludo.orba
+    python3 orbito_anim.py saludo.json saludo.h --name saludo
+
+JSON description (times in milliseconds):
+
+    {
+      "loop": false,
+      "duration": 3000,
+      "keys": [
+        {"t": 0,    "expression": "HAPPY", "ms": 400, "easing": "EASE_OUT"},
+        {"t": 800,  "look": [12, -5], "ms": 300},
+        {"t": 1500, "blink": true},
+        {"t": 2000, "frame": "logo.png", "x": 120, "y": 80}
+      ]
+    }
+
+"frame" images need Pillow (pip install pillow). With a .h output the file is
+written as a C array ready to pass to Orbito.Action.storeAnimation().
+"""
+
+import argparse
+import json
+import os
+import struct
+import sys
+
+MAGIC = b"ORBA"
+VERSION = 1
+FLAG_LOOP = 0x01
+
+TRACK_EXPRESSION = 0
+TRACK_GAZE = 1
+TRACK_BLINK = 2
+TRACK_FRAME = 3
+
+# Same order as OrbitoRobot::ActionModule::Emotion and the Easing enum
+EMOTIONS = ["WORRY", "ANGRY", "HAPPY", "NEUTRAL", "SURPRISE", "SLEEPY", "SAD"]
+EASINGS = ["EASE_LINEAR", "EASE_IN", "EASE_OUT", "EASE_IN_OUT"]
+
+SCREEN_W = 320
+SCREEN_H = 240
+
+
+def fail(message):
+    sys.exit("error: " + message)
+
+
+def easing_of(key):
+    name = key.get("easing", "EASE_IN_OUT").upper()
+    if not name.startswith("EASE_"):
+        name = "EASE_" + name
+    if name not in EASINGS:
+        fail("unknown easing '%s' (use %s)" % (name, ", ".join(EASINGS)))
+    return EASINGS.index(name)
+
+
+def frame_payload(key, base_dir):
+    try:
+        from PIL import Image
+    except ImportError:
+        fail("'frame' keys need Pillow: pip install pillow")
+    image = Image.open(os.path.join(base_dir, key["frame"])).convert("RGB")
+    x, y = int(key.get("x", 0)), int(key.get("y", 0))
+    w, h = image.size
+    if x < 0 or y < 0 or x + w > SCREEN_W or y + h > SCREEN_H:
+        fail("frame '%s' (%dx%d at %d,%d) does not fit on the screen" % (key["frame"], w, h, x, y))
+    pixels = bytearray()
+    for r, g, b in image.getdata():
+        # Big-endian RGB565, as the display expects it
+        pixels += struct.pack(">H", ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3))
+    return struct.pack("<hhHH", x, y, w, h) + bytes(pixels)
+
+
+def encode_key(key, base_dir):
+    if "expression" in key:
+        name = key["expression"].upper()
+        if name not in EMOTIONS:
+            fail("unknown expression '%s' (use %s)" % (name, ", ".join(EMOTIONS)))
+        return TRACK_EXPRESSION, struct.pack("<BBH", EMOTIONS.index(name), 0, int(key.get("ms", 0)))
+    if "look" in key:
+        x, y = key["look"]
+        return TRACK_GAZE, struct.pack("<bbH", int(x), int(y), int(key.get("ms", 0)))
+    if key.get("blink"):
+        return TRACK_BLINK, b""
+    if "frame" in key:
+        return TRACK_FRAME, frame_payload(key, base_dir)
+    fail("key at t=%s has nothing to animate" % key.get("t"))
+
+
+def convert(description, base_dir):
+    keys = sorted(description.get("keys", []), key=lambda k: int(k.get("t", 0)))
+    if len(keys) > 0xFFFF:
+        fail("too many keys")
+    data = bytearray()
+    for key in keys:
+        track, payload = encode_key(key, base_dir)
+        data += struct.pack("<IBBHI", int(key.get("t", 0)), track, easing_of(key), 0, len(payload))
+        data += payload
+    last = int(keys[-1].get("t", 0)) if keys else 0
+    duration = int(description.get("duration", last))
+    flags = FLAG_LOOP if description.get("loop") else 0
+    header = MAGIC + struct.pack("<BBHII", VERSION, flags, len(keys), duration, len(data))
+    return header + bytes(data)
+
+
+def write_header(path, name, blob):
+    with open(path, "w") as out:
+        out.write("// Generated by extras/tools/orbito_anim.py, do not edit\n")
+        out.write("#pragma once\n\n")
+        out.write("const uint8_t %s[%d] = {\n" % (name, len(blob)))
+        for i in range(0, len(blob), 16):
+            out.write("    " + ", ".join("0x%02X" % b for b in blob[i:i + 16]) + ",\n")
+        out.write("};\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="JSON to Orbito animation (ORBA) converter")
+    parser.add_argument("input", help="JSON description")
+    parser.add_argument("output", help=".orba binary or .h C array")
+    parser.add_argument("--name", default="animacion", help="array name for .h outputs")
+    args = parser.parse_args()
+    with open(args.input) as f:
+        description = json.load(f)
+    blob = convert(description, os.path.dirname(os.path.abspath(args.input)))
+    if args.output.endswith(".h"):
+        write_header(args.output, args.name, blob)
+    else:
+        with open(args.output, "wb") as out:
+            out.write(blob)
+    print("%s: %d keys, %d bytes" % (args.output, struct.unpack("<H", blob[6:8])[0], len(blob)))
+
+
+if __name__ == "__main__":
+    main()
@@ -9,6 +9,7 @@
 
 #include "Orbito.h"
 #include <esp_sleep.h>
+#include <esp_timer.h>
 #include <vector>
 
 // Aux Structure for BLE updates
@@ -29,6 +30,19 @@ static bool _is_animating = false;
 static int16_t _current_pupil_x = 0;
 static int16_t _current_pupil_y = 0;
 static OrbitoRobot::ActionModule::Emotion _current_emotion = OrbitoRobot::ActionModule::NEUTRAL;
+// Face animation steps, they draw one frame at most and never wait (see the Action module)
+static bool _tweenStep();
+static void _eyesStep();
+static void _animStep();
+static void _sayStep();
+static void _trackStep();
+static void _faceStep();
+// Face animation task (see ActionModule::enableAnimationTask())
+static portMUX_TYPE _face_mux = portMUX_INITIALIZER_UNLOCKED;
+static struct {
+    bool enabled = false;
+    bool running = false;       // The task is alive
+} _face_task;
 
 // Main Objtect creation
 OrbitoRobot Orbito;
@@ -44,6 +58,8 @@ OrbitoRobot::OrbitoRobot() :
     // Driver initialization
     _ioDriver(_uart_bus),
     _flashDriver(&_spi_bus, PIN_FLASH_CS),
+    _files(&_flashDriver),
+    _frameLog(&_files, &_cameraDriver),
     _displayDriver(&_spi_bus),
     _nfcDriver(_i2c_bus),
     // Sub-module initialization
@@ -65,6 +81,9 @@ bool OrbitoRobot::begin()
     //_i2c_bus.begin(PIN_I2C_SDA, PIN_I2C_SCL);
     // Start the Flash external memory
     _flashDriver.begin();
+    _files.begin();
+    // A recording cut by a reset keeps its complete frames
+    _frameLog.recover();
     // Starts the TFT Display
     _displayDriver.begin();
     // UART inits in PortHandler::begin()
@@ -81,7 +100,7 @@ bool OrbitoRobot::begin()
 
 /**
  * @brief Main system loop. Must be called inside the Arduino loop().
- * Handles WiFi reconnection, OTA, BLE events, and Eye Animations.
+ * Handles WiFi reconnection, OTA, BLE events, Eye Animations and screen refresh.
  */
 void OrbitoRobot::update()
 {
@@ -106,23 +125,10 @@ void OrbitoRobot::update()
             }
         }
     }
-    // Maintain animations
-    if (_is_animating)
-    {
-        unsigned long now = millis();
-        if (now - _last_blink_time > _next_blink_interval)
-        {
-            Action.blink();
-            _last_blink_time = now;
-            _next_blink_interval = random(3000, 6000);
-            if (_current_emotion == ActionModule::NEUTRAL)
-            {
-                int rx = random(-10, 11);
-                int ry = random(-5, 6);
-                Action.lookAt(rx, ry);
-            }
-        }
-    }
+    // Maintain animations (unless the face task does it at its own pace)
+    if (!_face_task.enabled) _faceStep();
+    // Push the canvas changes of this loop (only in canvas mode, in background if enabled)
+    _displayDriver.flushAsync();
 }
 
  // =============================================================
@@ -339,13 +345,50 @@ camera_fb_t* OrbitoRobot::VisionModule::snapshot()
     return Orbito._cameraDriver.getFrame();
 }
 
+/**
+ * @brief Captures a frame that can be shared: copies of the FrameRef point to
+ * the same pixels and it is freed by itself when the last copy is gone.
+ * @param max_age_ms Reuses the last frame captured (by the web stream, the AI or
+ * your code) if it is this recent, instead of asking the camera again (0 = always new).
+ */
+FrameRef OrbitoRobot::VisionModule::capture(uint32_t max_age_ms)
+{
+    return Orbito._cameraDriver.latestFrame(max_age_ms);
+}
+
+// Receives the JPEG encoder output and writes it to the file. The encoder ignores a
+// short count and goes on, the writer remembers it (FlashFileWriter::failed()).
+static size_t _jpegToFile(void* arg, size_t index, const void* data, size_t len)
+{
+    if (len == 0) return 0;
+    return ((FlashFileWriter*)arg)->write((const uint8_t*)data, len);
+}
+
 /**
  * @brief Captures a frame and saves it directly to Flash memory as JPEG.
- * @param filename Path to save (e.g., "/photo1.jpg").
+ * The bytes go from the camera buffer to the flash page by page (RGB565 and
+ * grayscale frames are encoded on the way). Read it back with Storage.
+ * @param filename Path to save (e.g., "/photo1.jpg", up to 19 characters).
+ * @return False if there is no room (a UXGA photo needs about 200 KB).
  */
 bool OrbitoRobot::VisionModule::saveSnapshot(String filename)
 {
-    return false;
+    FrameRef frame = Orbito._cameraDriver.captureFrame();
+    if (!frame) return false;
+    bool is_jpeg = (frame.format() == PIXFORMAT_JPEG);
+    FlashFileWriter file;
+    // The size of an encoded frame is not known yet: it gets the largest gap
+    if (!file.open(Orbito._files, filename.c_str(), is_jpeg ? frame.length() : 0)) return false;
+    bool written;
+    if (is_jpeg) written = (file.write(frame.data(), frame.length()) == frame.length());
+    else written = Orbito._cameraDriver.convertFrameToJpeg(const_cast<camera_fb_t*>(frame.get()), _jpegToFile, &file);
+    // A truncated JPEG is discarded (the old file with that name, if any, is kept)
+    if (!written || file.failed())
+    {
+        file.abort();
+        return false;
+    }
+    return file.close();
 }
 
 /**
@@ -356,10 +399,105 @@ void OrbitoRobot::VisionModule::release(camera_fb_t* fb)
     Orbito._cameraDriver.releaseFrame(fb);
 }
 
+// --- Shared Capture ---
+
+/**
+ * @brief Starts a task (pinned to a core) that reads the camera at its own speed
+ * and hands every frame to the subscribers, the web stream and capture().
+ * Nobody waits for anybody: a slow reader just skips frames.
+ * @param core Core of the task (0 leaves core 1 for the loop and the face).
+ */
+bool OrbitoRobot::VisionModule::startCapture(uint8_t core)
+{
+    return Orbito._cameraDriver.startCapture(core);
+}
+
+/**
+ * @brief Stops the capture task, each reader asks the camera by itself again.
+ */
+void OrbitoRobot::VisionModule::stopCapture()
+{
+    Orbito._cameraDriver.stopCapture();
+}
+
+/**
+ * @brief Frames per second read by the capture task (0 if it is off).
+ */
+float OrbitoRobot::VisionModule::getCaptureFps()
+{
+    return Orbito._cameraDriver.getCaptureFps();
+}
+
+/**
+ * @brief Registers a mailbox that always holds the newest frame (unread ones are replaced).
+ * @param max_fps Maximum frames per second it receives (0 = all).
+ * @param every_nth Receives one frame out of every N (1 = all).
+ */
+bool OrbitoRobot::VisionModule::subscribe(FrameSubscriber& subscriber, uint8_t max_fps, uint8_t every_nth)
+{
+    return Orbito._cameraDriver.subscribe(subscriber, max_fps, every_nth);
+}
+
+/**
+ * @brief Removes a mailbox (also done when it is destroyed).
+ */
+void OrbitoRobot::VisionModule::unsubscribe(FrameSubscriber& subscriber)
+{
+    Orbito._cameraDriver.unsubscribe(subscriber);
+}
+
+// --- Bursts and Timelapses ---
+
+/**
+ * @brief Records every frame the sensor gives into one file (in the background).
+ * With startCapture() running a QVGA burst keeps the sensor rate.
+ * @param path File of the log (read it with Storage.openFrameLog()).
+ * @param frames Frames to record (0 = until stopRecording() or the flash is full).
+ */
+bool OrbitoRobot::VisionModule::startBurst(String path, uint16_t frames)
+{
+    path = StorageModule::_cleanPath(path);
+    return Orbito._frameLog.start(path.c_str(), 0, frames);
+}
+
+/**
+ * @brief Records one frame every interval_ms into one file (in the background).
+ * @param frames Frames to record (0 = until stopRecording() or the flash is full).
+ */
+bool OrbitoRobot::VisionModule::startTimelapse(String path, uint32_t interval_ms, uint16_t frames)
+{
+    if (interval_ms == 0) return false;
+    path = StorageModule::_cleanPath(path);
+    return Orbito._frameLog.start(path.c_str(), interval_ms, frames);
+}
+
+/**
+ * @brief Ends the recording, the file is ready when it returns.
+ */
+void OrbitoRobot::VisionModule::stopRecording()
+{
+    Orbito._frameLog.stop();
+}
+
+bool OrbitoRobot::VisionModule::isRecording()
+{
+    return Orbito._frameLog.isRecording();
+}
+
+FrameLogStats OrbitoRobot::VisionModule::getRecordingStats()
+{
+    return Orbito._frameLog.getStats();
+}
+
 // --- Hardware Adjustment ---
-void OrbitoRobot::VisionModule::setMode(CameraHandler::Camera_Mode mode)
+bool OrbitoRobot::VisionModule::setMode(CameraHandler::Camera_Mode mode)
+{
+    return Orbito._cameraDriver.setMode(mode);
+}
+
+CameraModeSwitch OrbitoRobot::VisionModule::getModeSwitchStats()
 {
-    Orbito._cameraDriver.setMode(mode);
+    return Orbito._cameraDriver.getModeSwitchStats();
 }
 
 void OrbitoRobot::VisionModule::setResolution(framesize_t size)
@@ -402,150 +540,207 @@ void OrbitoRobot::VisionModule::setNightMode(bool enable)
 
 void OrbitoRobot::DisplayModule::fillScreen(uint16_t color)
 {
-    Orbito._displayDriver.draw([=](Adafruit_ST7789 &tft) {
+    Orbito._displayDriver.render([=](Adafruit_GFX &tft) {
         tft.fillScreen(color);
     });
 }
 
 void OrbitoRobot::DisplayModule::drawPixel(int x, int y, uint16_t color)
 {
-    Orbito._displayDriver.draw([=](Adafruit_ST7789 &tft) {
+    Orbito._displayDriver.render([=](Adafruit_GFX &tft) {
         tft.drawPixel(x, y, color);
     });
 }
 
 void OrbitoRobot::DisplayModule::drawLine(int x0, int y0, int x1, int y1, uint16_t color)
 {
-    Orbito._displayDriver.draw([=](Adafruit_ST7789 &tft) {
+    Orbito._displayDriver.render([=](Adafruit_GFX &tft) {
         tft.drawLine(x0, y0, x1, y1, color);
     });
 }
 
 void OrbitoRobot::DisplayModule::drawRect(int x, int y, int w, int h, uint16_t color)
 {
-    Orbito._displayDriver.draw([=](Adafruit_ST7789 &tft) {
+    Orbito._displayDriver.render([=](Adafruit_GFX &tft) {
         tft.drawRect(x, y, w, h, color);
     });
 }
 
 void OrbitoRobot::DisplayModule::fillRect(int x, int y, int w, int h, uint16_t color)
 {
-    Orbito._displayDriver.draw([=](Adafruit_ST7789 &tft) {
+    Orbito._displayDriver.render([=](Adafruit_GFX &tft) {
         tft.fillRect(x, y, w, h, color);
     });
 }
 
 void OrbitoRobot::DisplayModule::drawCircle(int x, int y, int r, uint16_t color)
 {
-    Orbito._displayDriver.draw([=](Adafruit_ST7789 &tft) {
+    Orbito._displayDriver.render([=](Adafruit_GFX &tft) {
         tft.drawCircle(x, y, r, color);
     });
 }
 
 void OrbitoRobot::DisplayModule::fillCircle(int x, int y, int r, uint16_t color)
 {
-    Orbito._displayDriver.draw([=](Adafruit_ST7789 &tft) {
+    Orbito._displayDriver.render([=](Adafruit_GFX &tft) {
         tft.fillCircle(x, y, r, color);
     });
 }
 
 void OrbitoRobot::DisplayModule::drawRoundRect(int x, int y, int w, int h, int r, uint16_t color)
 {
-    Orbito._displayDriver.draw([=](Adafruit_ST7789 &tft) {
+    Orbito._displayDriver.render([=](Adafruit_GFX &tft) {
         tft.drawRoundRect(x, y, w, h, r, color);
     });
 }
 
 void OrbitoRobot::DisplayModule::fillRoundRect(int x, int y, int w, int h, int r, uint16_t color)
 {
-    Orbito._displayDriver.draw([=](Adafruit_ST7789 &tft) {
+    Orbito._displayDriver.render([=](Adafruit_GFX &tft) {
         tft.fillRoundRect(x, y, w, h, r, color);
     });
 }
 
 void OrbitoRobot::DisplayModule::drawTriangle(int x0, int y0, int x1, int y1, int x2, int y2, uint16_t color)
 {
-    Orbito._displayDriver.draw([=](Adafruit_ST7789 &tft) {
+    Orbito._displayDriver.render([=](Adafruit_GFX &tft) {
         tft.drawTriangle(x0, y0, x1, y1, x2, y2, color);
     });
 }
 
 void OrbitoRobot::DisplayModule::fillTriangle(int x0, int y0, int x1, int y1, int x2, int y2, uint16_t color)
 {
-    Orbito._displayDriver.draw([=](Adafruit_ST7789 &tft) {
+    Orbito._displayDriver.render([=](Adafruit_GFX &tft) {
         tft.fillTriangle(x0, y0, x1, y1, x2, y2, color);
     });
 }
 
 void OrbitoRobot::DisplayModule::print(String text)
 {
-    Orbito._displayDriver.draw([=](Adafruit_ST7789 &tft) {
-        tft.print(text);
-    });
+    // Glyph cache: one block per line of text instead of one rect per font pixel
+    Orbito._displayDriver.print(text.c_str());
 }
 
 void OrbitoRobot::DisplayModule::setCursor(int x, int y)
 {
-    Orbito._displayDriver.draw([=](Adafruit_ST7789 &tft) {
+    Orbito._displayDriver.render([=](Adafruit_GFX &tft) {
         tft.setCursor(x, y);
     });
 }
 
 void OrbitoRobot::DisplayModule::setTextColor(uint16_t color)
 {
-    Orbito._displayDriver.draw([=](Adafruit_ST7789 &tft) {
-        tft.setTextColor(color);
-    });
+    Orbito._displayDriver.setTextColor(color);
+}
+
+/**
+ * @brief Sets the text color with a solid background. Text is drawn faster
+ * and overwrites what was below (useful for values that change).
+ */
+void OrbitoRobot::DisplayModule::setTextColor(uint16_t color, uint16_t background)
+{
+    Orbito._displayDriver.setTextColor(color, background);
+}
+
+/**
+ * @brief Draws a whole list of recorded primitives at once.
+ * Much faster than calling the functions above one by one.
+ */
+void OrbitoRobot::DisplayModule::submit(const DrawList& list)
+{
+    Orbito._displayDriver.submit(list);
+}
+
+/**
+ * @brief Draws a pre-rendered sprite (see RleSprite) on its area of the screen.
+ * @param shift_x Moves the content inside the area (the rest is background).
+ * @param shift_y Moves the content inside the area (the rest is background).
+ */
+void OrbitoRobot::DisplayModule::drawSprite(const RleSprite& sprite, int16_t shift_x, int16_t shift_y)
+{
+    Orbito._displayDriver.drawSprite(sprite, shift_x, shift_y);
+}
+
+/**
+ * @brief Replaces a sprite drawn before with another one of the same area
+ * sending only the pixels that change (ideal to move a small detail).
+ * @param shown Sprite on the screen and the displacement it was drawn with.
+ * @param sprite Sprite to show and its displacement.
+ */
+void OrbitoRobot::DisplayModule::drawSpriteDelta(const RleSprite& shown, int16_t shown_x, int16_t shown_y,
+                                                 const RleSprite& sprite, int16_t shift_x, int16_t shift_y)
+{
+    Orbito._displayDriver.drawSpriteDelta(shown, shown_x, shown_y, sprite, shift_x, shift_y);
+}
+
+/**
+ * @brief Draws an image produced a few rows at a time, without keeping it
+ * whole in RAM (for example, read from the flash).
+ * @param source Fills rows (w pixels each, big-endian RGB565) into dst.
+ */
+void OrbitoRobot::DisplayModule::streamPixels(int16_t x, int16_t y, int16_t w, int16_t h,
+                                              std::function<void(uint16_t* dst, int16_t row, int16_t rows)> source)
+{
+    Orbito._displayDriver.streamPixels(x, y, w, h, source);
+}
+
+/**
+ * @brief Draws a full scene without flicker and without PSRAM. The list is
+ * composed in RAM by horizontal bands and each band is sent complete.
+ * @param scene Commands of the whole frame (start it with fillScreen()).
+ * @param y First row to compose.
+ * @param h Rows to compose (-1 = down to the bottom).
+ */
+void OrbitoRobot::DisplayModule::drawScene(const DrawList& scene, int y, int h)
+{
+    Orbito._displayDriver.renderScene(scene, y, h);
+}
+
+/**
+ * @brief Height (rows) of the bands used by drawScene(). Taller bands are
+ * faster but use more RAM (default 16).
+ * @return False if there is not enough memory for that size.
+ */
+bool OrbitoRobot::DisplayModule::setBandSize(int lines)
+{
+    if (lines <= 0) return false;
+    return Orbito._displayDriver.setBandLines(lines);
 }
 
 // --- Multimedia ---
 
 /**
- * @brief Draws a raw Camera Frame (RGB565) onto the screen.
+ * @brief Draws a Camera Frame (RGB565, Grayscale or JPEG) onto the screen.
+ * The frame is not modified, it can still be saved or sent after this.
+ * @param fit_screen True to scale any resolution to the screen (keeping
+ * the proportions), false to draw it at its real size, centered.
  */
-void OrbitoRobot::DisplayModule::drawSnapshot(camera_fb_t* fb)
+void OrbitoRobot::DisplayModule::drawSnapshot(camera_fb_t* fb, bool fit_screen)
 {
     if (!fb) return;
-    // We only can only print an image directly if it's in RGB565 or Grayscale
-    // For JPEG we need a complex decoder, not implemented
-    if (fb->format != PIXFORMAT_RGB565) return;
-    // Print the Camera Frame given
-    Orbito._displayDriver.draw([=](Adafruit_ST7789 &tft) {
-        // If it's Grayscale (1 byte per pixel), we need to convert or use gray bitmap
-        if (fb->format == PIXFORMAT_GRAYSCALE)
-        {
-            int w = fb->width;
-            int h = fb->height;
-            // Hold a buffer for ONE line (w * 2 bytes per color)
-            uint16_t* line_buffer = (uint16_t*)malloc(w * sizeof(uint16_t));
-            if (!line_buffer) return;
-            for (int y = 0 ; y < h ; y++)
-            {
-                for (int x = 0 ; x < w ; x++)
-                {
-                    // Read the brightness
-                    uint8_t gray = fb->buf[y * w + x];
-                    // Convert 8-bit to RGB565 (R:5, G:6, B:5)
-                    // R = gray >> 3, G = gray >> 2, B = gray >> 3
-                    uint16_t color = ((gray >> 3) << 11) | ((gray >> 2) << 5) | (gray >> 3);
-                    line_buffer[x] = color;
-                }
-                // Draw the complete line
-                tft.drawRGBBitmap(0, y, line_buffer, w, 1);
-            }
-            // Free buffer holded from memory
-            free(line_buffer);
-        } else {
-            // Invert every 2 bytes of all images
-            for (uint32_t i = 0; i < fb->len; i += 2) {
-                uint8_t temp = fb->buf[i];
-                fb->buf[i] = fb->buf[i+1];
-                fb->buf[i+1] = temp;
-            }
-            // Asume RGB565 (2 bytes per pixel)
-            tft.drawRGBBitmap(0, 0, (uint16_t*)fb->buf, fb->width, fb->height);
-        }
-    });
+    ImageFit fit = fit_screen ? IMAGE_FIT_LETTERBOX : IMAGE_FIT_NONE;
+    // The camera gives RGB565 in the same byte order as the screen: rows are copied as they are
+    switch (fb->format)
+    {
+        case PIXFORMAT_RGB565:
+            Orbito._displayDriver.drawImage(fb->buf, fb->width, fb->height, IMAGE_RGB565_BE, fit);
+            break;
+        case PIXFORMAT_GRAYSCALE:
+            Orbito._displayDriver.drawImage(fb->buf, fb->width, fb->height, IMAGE_GRAY8, fit);
+            break;
+        case PIXFORMAT_JPEG:
+            // Decoded block by block, big captures are reduced while decoding
+            Orbito._displayDriver.drawJpeg(fb->buf, fb->len, fit);
+            break;
+        default:
+            break;
+    }
+}
+
+void OrbitoRobot::DisplayModule::drawSnapshot(const FrameRef& frame, bool fit_screen)
+{
+    // Only read: the shared pixels are not modified
+    drawSnapshot(const_cast<camera_fb_t*>(frame.get()), fit_screen);
 }
 
 /**
@@ -553,17 +748,24 @@ void OrbitoRobot::DisplayModule::drawSnapshot(camera_fb_t* fb)
  */
 void OrbitoRobot::DisplayModule::drawBitmap(int x, int y, const uint8_t* bmp, int w, int h, uint16_t color)
 {
-    Orbito._displayDriver.draw([=](Adafruit_ST7789 &tft) {
+    Orbito._displayDriver.render([=](Adafruit_GFX &tft) {
         tft.drawBitmap(x, y, bmp, w, h, color);
     });
 }
 
 /**
- * @brief Draws a pre-loaded icon/emoji by name.
+ * @brief Draws a pre-loaded icon/emoji by name ("smile", "heart", "star"...,
+ * see extras/tools/make_emoji_atlas.py). Icons are 32x32 pixels.
+ * @param scale Size multiplier (2 = 64x64).
+ * @param background Color of the transparent pixels.
+ * @return False if there is no icon with that name.
  */
-void OrbitoRobot::DisplayModule::drawEmoji(String emojiName, int x, int y)
+bool OrbitoRobot::DisplayModule::drawEmoji(String emojiName, int x, int y, uint8_t scale, uint16_t background)
 {
-    // TODO: Switch - case with Every Emoji available.
+    const EmojiInfo* emoji = EmojiAtlas::find(emojiName.c_str());
+    if (!emoji) return false;
+    Orbito._displayDriver.drawEmoji(*emoji, x, y, scale, background);
+    return true;
 }
 
 // --- Visual Console ---
@@ -573,11 +775,33 @@ void OrbitoRobot::DisplayModule::drawEmoji(String emojiName, int x, int y)
  */
 void OrbitoRobot::DisplayModule::consoleLog(String text)
 {
-    Orbito._displayDriver.draw([=](Adafruit_ST7789 &tft) {
-        tft.setTextColor(0xFFFF);
-        tft.setTextSize(2);
-        tft.println(text);
-    });
+    // The console keeps its own history, style and position (not the print cursor)
+    Orbito._displayDriver.consoleWrite(text.c_str());
+}
+
+/**
+ * @brief Clears the screen and the console history.
+ */
+void OrbitoRobot::DisplayModule::consoleClear()
+{
+    Orbito._displayDriver.consoleClear();
+}
+
+/**
+ * @brief Shows again the last console lines (e.g. after drawing over them).
+ */
+void OrbitoRobot::DisplayModule::consoleRedraw()
+{
+    Orbito._displayDriver.consoleRedraw();
+}
+
+/**
+ * @brief Text size and colors of the console (the background must be
+ * solid). The lines shown are drawn again with the new style.
+ */
+void OrbitoRobot::DisplayModule::setConsoleStyle(uint8_t size, uint16_t color, uint16_t background)
+{
+    Orbito._displayDriver.setConsoleStyle(size, color, background);
 }
 
 /**
@@ -585,9 +809,98 @@ void OrbitoRobot::DisplayModule::consoleLog(String text)
  */
 void OrbitoRobot::DisplayModule::setFont(int size)
 {
-    Orbito._displayDriver.draw([=](Adafruit_ST7789 &tft) {
-        tft.setTextSize(size);
-    });
+    Orbito._displayDriver.setTextSize(size);
+}
+
+// --- Rendering ---
+
+/**
+ * @brief Enables the off-screen canvas (needs PSRAM). Drawings are done in RAM
+ * and only the changed regions are sent to the screen in update().
+ * @return True if the canvas mode is active.
+ */
+bool OrbitoRobot::DisplayModule::enableCanvas(bool enable)
+{
+    if (enable) return Orbito._displayDriver.beginCanvas();
+    Orbito._displayDriver.endCanvas();
+    return false;
+}
+
+/**
+ * @brief Sends the pending canvas changes to the screen right now.
+ */
+void OrbitoRobot::DisplayModule::flush()
+{
+    Orbito._displayDriver.flush();
+}
+
+/**
+ * @brief Sends the screen updates from a background task on the other core,
+ * so update() does not wait for the pixels to reach the screen.
+ * @return True if the background sending is active.
+ */
+bool OrbitoRobot::DisplayModule::enableAsync(bool enable)
+{
+    if (enable) return Orbito._displayDriver.beginAsync();
+    Orbito._displayDriver.endAsync();
+    return false;
+}
+
+/**
+ * @brief Waits until every pending update is on the screen.
+ */
+void OrbitoRobot::DisplayModule::waitFlush()
+{
+    Orbito._displayDriver.waitFlush();
+}
+
+/**
+ * @brief Sets a function called when a background update reaches the screen.
+ * CAUTION: it runs in the display task, keep it short.
+ */
+void OrbitoRobot::DisplayModule::onFlushDone(std::function<void()> callback)
+{
+    Orbito._displayDriver.onFlushDone(callback);
+}
+
+/**
+ * @brief Reads the display counters (primitives, pixels, bus time, fps).
+ * The library must be built with ORBITO_DISPLAY_STATS.
+ * @param reset Starts counting again after reading.
+ * @return False if the counters are not compiled in.
+ */
+bool OrbitoRobot::DisplayModule::getStats(DisplayStats& stats, bool reset)
+{
+    return Orbito._displayDriver.getStats(stats, reset);
+}
+
+/**
+ * @brief Reserves the screen for this task until unlock(). Use it around a
+ * group of drawings when the face animation runs in its own task, so the
+ * face is never drawn in the middle (calls can be nested).
+ * @param timeout_ms Maximum wait (by default it waits as long as needed).
+ * @return False if the screen was still busy after the timeout.
+ */
+bool OrbitoRobot::DisplayModule::lock(uint32_t timeout_ms)
+{
+    return Orbito._displayDriver.lock(timeout_ms);
+}
+
+/**
+ * @brief Frees the screen reserved with lock().
+ */
+void OrbitoRobot::DisplayModule::unlock()
+{
+    Orbito._displayDriver.unlock();
+}
+
+/**
+ * @brief Number that changes every time something is drawn. Save it after
+ * drawing and compare it later to know if the screen was drawn over.
+ */
+uint32_t OrbitoRobot::DisplayModule::generation()
+{
+    return Orbito._displayDriver.generation();
 }
 
 // --- Hardware ---
@@ -609,195 +922,311 @@ void OrbitoRobot::DisplayModule::turnOff()
 // =============================================================
 // 4. ACTION MODULE (Personality & Emotions)
 // =============================================================
-// --- Helper to render Faces ---
-static void _drawArc(int16_t x, int16_t y, int16_t r, int16_t start_angle, int16_t end_angle, uint16_t color)
-{
-    // Draw a dot if radius is too small
-    if (r < 2)
+// --- Helper to render Faces (shapes in core/FaceRenderer) ---
+// Every face redraw is recorded here and sent in a single bus transaction
+static StaticDrawList<512> _face_list;
+
+// Expression transitions: frame rate cap and drawing time allowed per frame
+#define FACE_TWEEN_FPS       25
+#define FACE_TWEEN_BUDGET_MS 12
+
+// Pre-rendered parts of every emotion (pupils centered), built the first time they are used
+static_assert(OrbitoRobot::ActionModule::SAD + 1 == FACE_EMOTIONS, "Emotion and FaceEmotion must match");
+static RleSprite _face_sprites[FACE_EMOTIONS][FACE_PARTS];
+
+// Eye sprite on the screen, so the next one only sends what changes. Any
+// other drawing changes the display generation and the sprite is sent whole
+static struct {
+    bool valid = false;
+    OrbitoRobot::ActionModule::Emotion emotion;
+    FacePart part;
+    int16_t shift_x, shift_y;
+    uint32_t generation;
+} _eyes_shown;
+
+// Speech bubble: below the eye area, so blinks and pupils never touch it
+#define SAY_BUBBLE_X      8
+#define SAY_BUBBLE_Y      (FACE_EYES_Y + FACE_EYES_H + 2)
+#define SAY_BUBBLE_W      (FACE_SCREEN_W - 2 * SAY_BUBBLE_X)
+#define SAY_BUBBLE_H      64
+#define SAY_BUBBLE_R      10
+#define SAY_PADDING       10
+#define SAY_TEXT_SIZE     2
+#define SAY_LINES         3                                                     // Lines per page
+#define SAY_COLUMNS       ((SAY_BUBBLE_W - 2 * SAY_PADDING) / (GLYPH_WIDTH * SAY_TEXT_SIZE))
+#define SAY_CACHE         4                                                     // Texts whose layout is kept
+#define SAY_PAGE_MIN_MS   1500
+#define SAY_CHAR_MS       60                                                    // Reading time per character
+
+// Bubble on the screen (it covers the mouth)
+static struct {
+    bool visible = false;
+    const TextLayout* layout;
+    uint16_t page;
+    unsigned long next_page;
+} _say;
+
+// Gets a face sprite, rasterizing it the first time (NULL if there is no memory)
+static const RleSprite* _faceSprite(OrbitoRobot::ActionModule::Emotion e, FacePart part)
+{
+    RleSprite& sprite = _face_sprites[e][part];
+    if (!sprite.isReady())
     {
-        Orbito.Display.drawPixel(x, y, color);
-        return;
+        _face_list.clear();
+        faceRecordPart(_face_list, (FaceEmotion)e, part);
+        if (part == FACE_WHOLE) sprite.build(_face_list, FACE_SCREEN_W, FACE_SCREEN_H, 0, 0, FACE_SCREEN_W, FACE_SCREEN_H, 0x0000);
+        else sprite.build(_face_list, FACE_SCREEN_W, FACE_SCREEN_H, FACE_EYES_X, FACE_EYES_Y, FACE_EYES_W, FACE_EYES_H, 0x0000);
+        _face_list.clear();
     }
-    // Dynamic resolution
-    int step = 6;
-    float deg2rad = 0.0174532925f;
-    float rad = start_angle * deg2rad;
-    // Calculate the starting line coordinates
-    int16_t x1 = x + (int16_t)(cosf(rad) * r);
-    int16_t y1 = y + (int16_t)(sinf(rad) * r);
-    int16_t x2, y2;
-    // Draw all the lines for every step
-    for (int i = start_angle + step ; i <=end_angle ; i += step)
+    return sprite.isReady() ? &sprite : NULL;
+}
+
+// --- Expression transitions ---
+
+// Parameters of every face part in one frame
+struct FaceFrame {
+    OrbitoRobot::ActionModule::EyeParams eyes[2];
+    OrbitoRobot::ActionModule::MouthParams mouth;
+};
+
+// Transition in progress (from/to in parameters, shown = last frame drawn)
+static struct {
+    bool active = false;
+    unsigned long start;
+    unsigned long next_frame;
+    uint16_t duration;
+    Easing easing;
+    FaceFrame from, to, shown;
+} _tween;
+static uint8_t _tween_fps = FACE_TWEEN_FPS;
+static uint8_t _tween_budget = FACE_TWEEN_BUDGET_MS;
+
+// Face of an emotion as parameters
+static FaceFrame _faceFrame(OrbitoRobot::ActionModule::Emotion e, int16_t pupil_x, int16_t pupil_y)
+{
+    FaceFrame frame;
+    frame.eyes[0] = faceEyeParams((FaceEmotion)e, true,  pupil_x, pupil_y);
+    frame.eyes[1] = faceEyeParams((FaceEmotion)e, false, pupil_x, pupil_y);
+    frame.mouth = faceMouthParams((FaceEmotion)e);
+    return frame;
+}
+
+// Frame at progress t (Q14) between two faces
+static FaceFrame _lerpFrame(const FaceFrame& a, const FaceFrame& b, int32_t t)
+{
+    const int32_t HALF = TRIG_ONE / 2;
+    FaceFrame frame = b;
+    // Eyes open/close and pupils slide, eyebrows switch halfway
+    for (uint8_t i = 0 ; i < 2 ; i++)
+    {
+        OrbitoRobot::ActionModule::EyeParams& eye = frame.eyes[i];
+        eye.pupil_x = lerp16(a.eyes[i].pupil_x, b.eyes[i].pupil_x, t);
+        eye.pupil_y = lerp16(a.eyes[i].pupil_y, b.eyes[i].pupil_y, t);
+        eye.open_factor = a.eyes[i].open_factor + (b.eyes[i].open_factor - a.eyes[i].open_factor) * t / TRIG_ONE;
+        if (t < HALF)
+        {
+            eye.has_eyebrown = a.eyes[i].has_eyebrown;
+            eye.eyebr_type = a.eyes[i].eyebr_type;
+        }
+    }
+    // Same mouth: it stretches. Different: the old one shrinks and the new one grows
+    if (a.mouth.shape == b.mouth.shape)
     {
-        rad = i * deg2rad;
-        x2 = x + (int16_t)(cosf(rad) * r);
-        y2 = y + (int16_t)(sinf(rad) * r);
-        Orbito.Display.drawLine(x1, y1, x2, y2, color);
-        x1 = x2;
-        y1 = y2;
+        frame.mouth.width = lerp16(a.mouth.width, b.mouth.width, t);
+        frame.mouth.height = lerp16(a.mouth.height, b.mouth.height, t);
+    } else if (t < HALF) {
+        frame.mouth = a.mouth;
+        frame.mouth.width = lerp16(a.mouth.width, 0, t * 2);
+    } else {
+        frame.mouth.width = lerp16(0, b.mouth.width, (t - HALF) * 2);
     }
+    return frame;
 }
 
-static void _drawThickArc(int16_t x, int16_t y, int16_t r, uint8_t thickness, int16_t start, int16_t end, uint16_t color)
+// True if two eyes would be drawn differently
+static bool _eyeChanged(const OrbitoRobot::ActionModule::EyeParams& a, const OrbitoRobot::ActionModule::EyeParams& b)
 {
-    for (int i = 0 ; i < thickness ; i++) _drawArc(x, y, r - i, start, end, color);
+    return a.pupil_x != b.pupil_x || a.pupil_y != b.pupil_y ||
+           (int16_t)(a.height * a.open_factor) != (int16_t)(b.height * b.open_factor) ||
+           a.has_eyebrown != b.has_eyebrown || a.eyebr_type != b.eyebr_type;
 }
 
-static void _drawEllipse(int16_t x0, int16_t y0, int16_t rx, int16_t ry, uint16_t color)
+// Row below the lowest one an eye reaches (pupil shift and opening included)
+static int16_t _eyeBottom(const OrbitoRobot::ActionModule::EyeParams& e)
 {
-    float deg2rad = 0.0174532925f;
-    int16_t x1 = x0 + rx;
-    int16_t y1 = y0;
-    // Draw a poligon with many faces
-    for (int i = 5 ; i <= 360 ; i += 5)
-    {
-        float rad = i * deg2rad;
-        int16_t x2 = x0 + (int16_t)(cosf(rad) * rx);
-        int16_t y2 = y0 + (int16_t)(sinf(rad) * ry);
-        Orbito.Display.drawLine(x1, y1, x2, y2, color);
-        x1 = x2;
-        y1 = y2;
-    }
+    int16_t h = max((int16_t)2, (int16_t)(e.height * e.open_factor));
+    return e.y + e.pupil_y + h / 2 + 1;
 }
 
-static void _fillEllipse(int16_t x0, int16_t y0, int16_t rx, int16_t ry, uint16_t color)
+// True if two mouths would be drawn differently
+static bool _mouthChanged(const OrbitoRobot::ActionModule::MouthParams& a, const OrbitoRobot::ActionModule::MouthParams& b)
 {
-    // Draw line by line from top to bottom
-    for (int16_t y = -ry ; y <= ry ; y++)
-    {
-        int16_t width = (int16_t)(rx * sqrtf(1.0f - (float)(y * y) / (float)(ry * ry)));
-        Orbito.Display.drawLine(x0 - width, y0 + y, x0 + width, y0 + y, color);
-    }
-}
-
-static void _renderEye(OrbitoRobot::ActionModule::EyeParams p) {
-    uint16_t COLOR_BG = 0x0000;
-    uint16_t COLOR_FG = 0xFFFF;
-    int16_t current_h = p.height * p.open_factor;
-    if (current_h < 2) current_h = 2;
-    int16_t draw_x = p.x + p.pupil_x;
-    int16_t draw_y = p.y + p.pupil_y;
-    Orbito.Display.fillRect( p.x - (p.width / 2) - 20, p.y - (p.height / 2) - 20, p.width + 40, p.height + 40, COLOR_BG);
-    _fillEllipse(draw_x, draw_y, p.width / 2, current_h / 2, COLOR_FG);
-    int16_t brow_radius = (p.width / 2) + (p.width / 4);
-    int16_t brow_y = draw_y - brow_radius * 2 + 10;
-    if (p.has_eyebrown)
-    {
-        if (p.is_left_eye)
-        {
-            switch (p.eyebr_type)
-            {
-                case 1: Orbito.Display.fillCircle(draw_x - (p.width / 2), brow_y + 20, brow_radius, COLOR_BG); break;
-                case 2: Orbito.Display.fillTriangle(draw_x + (p.width / 2), draw_y, draw_x - p.width, draw_y - (p.height / 2), draw_x + (p.width / 2), draw_y - (p.height / 2), COLOR_BG); break;
-                case 3: Orbito.Display.fillCircle(draw_x, draw_y - (current_h / 5), p.width - (p.width / 3), COLOR_BG); break;
-            }
-        } else {
-            switch (p.eyebr_type)
-            {
-                case 1: Orbito.Display.fillCircle(draw_x + (p.width / 2), brow_y + 20, brow_radius, COLOR_BG); break;
-                case 2: Orbito.Display.fillTriangle(draw_x - (p.width / 2), draw_y, draw_x + p.width, draw_y - (p.height / 2), draw_x - (p.width / 2), draw_y - (p.height / 2), COLOR_BG); break;
-                case 3: Orbito.Display.fillCircle(draw_x, draw_y - (current_h / 5), p.width - (p.width / 3), COLOR_BG); break;
-            }
-        }
-    }
+    return a.shape != b.shape || a.width != b.width || a.height != b.height;
 }
 
-static void _redrawEyes(float override_open = -1.0)
+// Draws the parts of a frame that differ from the one on the screen
+static void _drawFrame(const FaceFrame& frame, const FaceFrame& shown)
 {
-    // Constant values for the designs
-    int16_t EYE_Y    = 85;
-    int16_t EYE_W    = 60;
-    int16_t EYE_H    = 110;
-    int16_t GAP      = 85;
-    int16_t CENTER_X = 160;
-    // Basic configuration
-    OrbitoRobot::ActionModule::EyeParams left  = { (int16_t)(CENTER_X - GAP), EYE_Y, EYE_W, EYE_H, _current_pupil_x, _current_pupil_y, 20, 0.8, true,  0 };
-    OrbitoRobot::ActionModule::EyeParams right = { (int16_t)(CENTER_X + GAP), EYE_Y, EYE_W, EYE_H, _current_pupil_x, _current_pupil_y, 20, 0.8, false, 0 };
-    // Apply actual emotion
-    switch (_current_emotion)
+    bool eyes = _eyeChanged(frame.eyes[0], shown.eyes[0]) || _eyeChanged(frame.eyes[1], shown.eyes[1]);
+    // The mouth is under the speech bubble, it shows up when the bubble goes away
+    bool mouth = !_say.visible && _mouthChanged(frame.mouth, shown.mouth);
+    if (!eyes && !mouth) return;
+    // Rows to compose: eyes (down to the lowest row they reach now or before), mouth or both
+    int16_t y0 = eyes ? FACE_EYES_Y : FACE_MOUTH_AREA_Y;
+    int16_t y1 = FACE_MOUTH_AREA_Y + FACE_MOUTH_AREA_H;
+    if (!mouth)
     {
-        case OrbitoRobot::ActionModule::WORRY:
-            left.open_factor = 0.8;
-            left.eyebr_type = 1;
-            left.has_eyebrown = true;
-            left.is_left_eye = true;
-            right.open_factor = 0.8;
-            right.eyebr_type = 1;
-            right.has_eyebrown = true;
-            right.is_left_eye = false;
-            break;
-        case OrbitoRobot::ActionModule::ANGRY:
-            left.open_factor = 0.8;
-            left.eyebr_type = 2;
-            left.has_eyebrown = true;
-            left.is_left_eye = true;
-            right.open_factor = 0.8;
-            right.eyebr_type = 2;
-            right.has_eyebrown = true;
-            right.is_left_eye = false;
-            break;
-        case OrbitoRobot::ActionModule::HAPPY:
-            break;
-        case OrbitoRobot::ActionModule::NEUTRAL:
-            break;
-        case OrbitoRobot::ActionModule::SURPRISE:
-            left.open_factor = 1.0;
-            right.open_factor = 1.0;
-            break;
-        case OrbitoRobot::ActionModule::SLEEPY:
-            left.open_factor = 0.4;
-            right.open_factor = 0.3;
-            break;
-        case OrbitoRobot::ActionModule::SAD:
-            left.open_factor = 0.8;
-            left.eyebr_type = 3;
-            left.has_eyebrown = true;
-            left.is_left_eye = true;
-            right.open_factor = 0.8;
-            right.eyebr_type = 3;
-            right.has_eyebrown = true;
-            right.is_left_eye = false;
-            break;
+        y1 = max(max(_eyeBottom(frame.eyes[0]), _eyeBottom(frame.eyes[1])), max(_eyeBottom(shown.eyes[0]), _eyeBottom(shown.eyes[1])));
+        y1 = min(y1, (int16_t)(FACE_EYES_Y + FACE_EYES_H));
     }
-    if (override_open >= 0) {
-        left.open_factor = override_open;
-        right.open_factor = override_open;
+    // The band is composed over black: if the eyes reach the mouth area the mouth goes in too
+    bool mouth_layer = mouth || (!_say.visible && y1 > FACE_MOUTH_AREA_Y);
+    _face_list.clear();
+    if (mouth_layer) _face_list.fillRect(FACE_MOUTH_AREA_X, FACE_MOUTH_AREA_Y, FACE_MOUTH_AREA_W, FACE_MOUTH_AREA_H, 0x0000);
+    faceRenderEye(_face_list, frame.eyes[0]);
+    faceRenderEye(_face_list, frame.eyes[1]);
+    // The two areas share a few rows: the mouth goes after the background of the eyes
+    if (mouth_layer) faceRenderMouth(_face_list, frame.mouth);
+    Orbito.Display.drawScene(_face_list, y0, y1 - y0);
+    if (eyes) _eyes_shown.valid = false;
+}
+
+// Advances the transition in progress (called from update()). False if there is none
+static bool _tweenStep()
+{
+    if (!_tween.active) return false;
+    unsigned long now = millis();
+    if ((long)(now - _tween.next_frame) < 0) return true;
+    // The frame shown is always the one of this moment, late frames are skipped, never queued
+    uint32_t elapsed = now - _tween.start;
+    int32_t t = (elapsed >= _tween.duration) ? TRIG_ONE : (int32_t)(elapsed * TRIG_ONE / _tween.duration);
+    FaceFrame frame = _lerpFrame(_tween.from, _tween.to, ease(_tween.easing, t));
+    unsigned long cost = millis();
+    _drawFrame(frame, _tween.shown);
+    cost = millis() - cost;
+    _tween.shown = frame;
+    if (t >= TRIG_ONE)
+    {
+        _tween.active = false;
+        return true;
     }
-    _renderEye(left);
-    _renderEye(right);
+    // A frame over budget pushes the next one back, so drawing keeps its share of the loop
+    uint32_t interval = 1000 / _tween_fps;
+    if (cost > _tween_budget) interval = max(interval, (uint32_t)(cost * interval / _tween_budget));
+    _tween.next_frame = now + interval;
+    return true;
 }
 
-static void _renderMouth(OrbitoRobot::ActionModule::MouthParams p)
+// --- Blink and gaze ---
+
+// Draws both eyes with the current emotion and pupils
+static void _drawEyes(FacePart part)
 {
-    uint16_t COLOR_BG = 0x0000;
-    uint16_t COLOR_FG = 0xFFFF;
-    int16_t x0 = p.x - (p.width / 2);
-    int16_t y0 = p.y - (p.height / 2);
-    switch (p.shape)
+    // The sprite can move the pupils inside the cleared margin only
+    const RleSprite* eyes = NULL;
+    if (abs(_current_pupil_x) <= FACE_EYE_CLEAR && abs(_current_pupil_y) <= FACE_EYE_CLEAR)
+        eyes = _faceSprite(_current_emotion, part);
+    if (eyes)
     {
-        case 0: // Worry
-            _drawThickArc(p.x, p.y + 80, 100, 10, 225, 315, COLOR_FG);
-            break;
-        case 1: // ANGRY
-            _drawThickArc(p.x, p.y + 80, 100, 10, 240, 300, COLOR_FG);
-            break;
-        case 2: // HAPPY
-            _drawThickArc(p.x, p.y - 80, 100, 10, 60, 120, COLOR_FG);
-            break;
-        case 3: // NEUTRAL
-            Orbito.Display.fillRoundRect(x0, y0, p.width, p.height, p.height / 2, COLOR_FG);
-            break;
-        case 4: // SURPRISE
-            Orbito.Display.fillRoundRect(x0, y0 - 30, p.width, 70, 20, COLOR_FG);
-            Orbito.Display.fillRect(x0, y0 + 25, p.width, 30, COLOR_BG);
-            break;
-        case 5: // SLEEPY
-            Orbito.Display.fillRoundRect(x0 + (p.width / 4), y0, p.width / 2, p.height, p.height / 2, COLOR_FG);
-            break;
-        case 6: // SAD
-            _drawThickArc(p.x, p.y + 80, 100, 10, 225, 315, COLOR_FG);
+        // Pupil moves and blinks only send the pixels that change
+        bool intact = _eyes_shown.valid && _eyes_shown.generation == Orbito.Display.generation();
+        const RleSprite* shown = intact ? _faceSprite(_eyes_shown.emotion, _eyes_shown.part) : NULL;
+        if (shown) Orbito.Display.drawSpriteDelta(*shown, _eyes_shown.shift_x, _eyes_shown.shift_y, *eyes, _current_pupil_x, _current_pupil_y);
+        else Orbito.Display.drawSprite(*eyes, _current_pupil_x, _current_pupil_y);
+        _eyes_shown = { true, _current_emotion, part, _current_pupil_x, _current_pupil_y, Orbito.Display.generation() };
+        return;
+    }
+    _eyes_shown.valid = false;
+    _face_list.clear();
+    faceRedrawEyes(_face_list, (FaceEmotion)_current_emotion, _current_pupil_x, _current_pupil_y, (part == FACE_EYES_CLOSED) ? FACE_BLINK : -1.0);
+    Orbito.Display.submit(_face_list);
+}
+
+// Timings of the eye animations
+#define FACE_BLINK_MS        100    // Eyes kept closed
+#define FACE_SACCADE_STEPS   2      // Frames of a pupil jump
+#define FACE_SACCADE_STEP_MS 20     // Time between those frames
+
+enum GazeState : uint8_t { GAZE_IDLE, GAZE_CLOSED, GAZE_SACCADE };
+
+// Blink or saccade in progress
+static struct {
+    GazeState state = GAZE_IDLE;
+    unsigned long due;          // When the next step runs
+    bool look_after = false;    // Start a saccade when the eyes open
+    uint8_t step;
+    int16_t from_x, from_y;
+    int16_t to_x, to_y;
+} _gaze;
+
+// Motion tracking: the camera task writes the pupils, update() moves the eyes
+static portMUX_TYPE _track_mux = portMUX_INITIALIZER_UNLOCKED;
+static struct {
+    bool enabled = false;
+    bool running = false;       // The task is alive
+    bool fresh = false;         // New pupils since the last update()
+    uint8_t threshold = MOTION_THRESHOLD;
+    int16_t x, y;
+    float fps = 0;
+} _track;
+
+// Starts a saccade: the pupils jump to (x, y) in a few quick frames
+static void _startSaccade(int16_t x, int16_t y, unsigned long now)
+{
+    _gaze.from_x = _current_pupil_x;
+    _gaze.from_y = _current_pupil_y;
+    _gaze.to_x = x;
+    _gaze.to_y = y;
+    _gaze.step = 0;
+    _gaze.due = now + FACE_SACCADE_STEP_MS;
+    _gaze.state = GAZE_SACCADE;
+}
+
+// Closes the eyes, they open again from _eyesStep()
+static void _startBlink(unsigned long now)
+{
+    _drawEyes(FACE_EYES_CLOSED);
+    _gaze.due = now + FACE_BLINK_MS;
+    _gaze.state = GAZE_CLOSED;
+}
+
+// Advances blinks and saccades (called from update()). Worst case per call:
+// one eye frame (270x150 px), about 16 ms of SPI in direct mode or a copy
+// to RAM of about 1 ms with the canvas and the async flush.
+static void _eyesStep()
+{
+    unsigned long now = millis();
+    switch (_gaze.state)
+    {
+        case GAZE_CLOSED:
+            if ((long)(now - _gaze.due) < 0) return;
+            _gaze.state = GAZE_IDLE;
+            _drawEyes(FACE_EYES_OPEN);
+            // Look somewhere else now that the eyes are open
+            if (_gaze.look_after)
+            {
+                _gaze.look_after = false;
+                _startSaccade(random(-10, 11), random(-5, 6), now);
+            }
+            return;
+        case GAZE_SACCADE:
+            if ((long)(now - _gaze.due) < 0) return;
+            _gaze.step++;
+            _current_pupil_x = _gaze.from_x + (_gaze.to_x - _gaze.from_x) * _gaze.step / FACE_SACCADE_STEPS;
+            _current_pupil_y = _gaze.from_y + (_gaze.to_y - _gaze.from_y) * _gaze.step / FACE_SACCADE_STEPS;
+            _drawEyes(FACE_EYES_OPEN);
+            if (_gaze.step >= FACE_SACCADE_STEPS) _gaze.state = GAZE_IDLE;
+            else _gaze.due = now + FACE_SACCADE_STEP_MS;
+            return;
+        default:
             break;
     }
+    // Automatic blinking
+    if (!_is_animating || now - _last_blink_time <= _next_blink_interval) return;
+    _last_blink_time = now;
+    _next_blink_interval = random(3000, 6000);
+    _gaze.look_after = (_current_emotion == OrbitoRobot::ActionModule::NEUTRAL) && !_track.enabled;
+    _startBlink(now);
 }
 
 // --- Expressivity ---
@@ -807,27 +1236,100 @@ static void _renderMouth(OrbitoRobot::ActionModule::MouthParams p)
  */
 void OrbitoRobot::ActionModule::setExpression(Emotion e)
 {
+    DisplayLock guard(Orbito._displayDriver);
+    _tween.active = false;
+    _gaze.state = GAZE_IDLE;
     _current_emotion = e;
     _current_pupil_x = 0;
     _current_pupil_y = 0;
-    // Clean the display
-    Orbito.Display.fillScreen(0x0000);
-    // Draw the mouth
-    int16_t MOUTH_Y  = 190;
-    int16_t CENTER_X = 160;
-    OrbitoRobot::ActionModule::MouthParams mouth = { CENTER_X, MOUTH_Y, 80, 10, 3 };
-    // Apply actual emotion
-    switch (e) {
-        case WORRY:    mouth.shape = 0; break;
-        case ANGRY:    mouth.shape = 1; break;
-        case HAPPY:    mouth.shape = 2; break;
-        case NEUTRAL:  mouth.shape = 3; break;
-        case SURPRISE: mouth.shape = 4; break;
-        case SLEEPY:   mouth.shape = 5; break;
-        case SAD:      mouth.shape = 6; break;
+    // With the speech bubble only the eyes change, the mouth waits under it
+    if (_say.visible)
+    {
+        _drawEyes(FACE_EYES_OPEN);
+        return;
+    }
+    // The whole face is one pre-rendered sprite
+    const RleSprite* face = _faceSprite(e, FACE_WHOLE);
+    if (face)
+    {
+        Orbito.Display.drawSprite(*face);
+        // The eye area now holds the open eyes with the pupils centered
+        _eyes_shown = { true, e, FACE_EYES_OPEN, 0, 0, Orbito.Display.generation() };
+        return;
     }
-    _renderMouth(mouth);
-    _redrawEyes();
+    // No memory for sprites: rasterize it
+    _eyes_shown.valid = false;
+    _face_list.clear();
+    faceRecordPart(_face_list, (FaceEmotion)e, FACE_WHOLE);
+    Orbito.Display.submit(_face_list);
+}
+
+/**
+ * @brief Changes the expression gradually: eyes, eyebrows and mouth are
+ * interpolated over the given time. Frames are drawn from Orbito.update().
+ * @param duration_ms Length of the transition (0 = instant).
+ * @param easing Speed profile of the movement.
+ */
+void OrbitoRobot::ActionModule::setExpression(Emotion e, uint16_t duration_ms, Easing easing)
+{
+    DisplayLock guard(Orbito._displayDriver);
+    if (duration_ms == 0)
+    {
+        setExpression(e);
+        return;
+    }
+    // Starts from what is on the screen (even if it is another transition)
+    FaceFrame from = _tween.active ? _tween.shown : _faceFrame(_current_emotion, _current_pupil_x, _current_pupil_y);
+    // Eyes closed by a blink open with the transition
+    if (_gaze.state == GAZE_CLOSED) from.eyes[0].open_factor = from.eyes[1].open_factor = FACE_BLINK;
+    _gaze.state = GAZE_IDLE;
+    _current_emotion = e;
+    _current_pupil_x = 0;
+    _current_pupil_y = 0;
+    _tween.from = from;
+    _tween.shown = from;
+    _tween.to = _faceFrame(e, 0, 0);
+    _tween.start = millis();
+    _tween.next_frame = _tween.start;
+    _tween.duration = duration_ms;
+    _tween.easing = easing;
+    _tween.active = true;
+}
+
+/**
+ * @brief Frame rate and drawing time per frame of the expression transitions.
+ * When a frame takes longer than the budget, the next ones are spaced out
+ * (intermediate frames are skipped) instead of slowing down the loop.
+ * @param fps Maximum frames per second.
+ * @param budget_ms Drawing time allowed per frame.
+ */
+void OrbitoRobot::ActionModule::setAnimationRate(uint8_t fps, uint8_t budget_ms)
+{
+    _tween_fps = max(fps, (uint8_t)1);
+    _tween_budget = max(budget_ms, (uint8_t)1);
+}
+
+/**
+ * @brief Checks if an expression transition is running.
+ */
+bool OrbitoRobot::ActionModule::isTransitioning()
+{
+    return _tween.active;
+}
+
+/**
+ * @brief Pre-renders the sprites of every expression now, so the first change
+ * to each of them is as fast as the rest.
+ * @return False if they do not fit in memory (faces are then drawn from shapes).
+ */
+bool OrbitoRobot::ActionModule::cacheExpressions()
+{
+    DisplayLock guard(Orbito._displayDriver);
+    bool ok = true;
+    for (uint8_t e = WORRY ; e <= SAD ; e++)
+        for (uint8_t part = FACE_WHOLE ; part < FACE_PARTS ; part++)
+            ok &= (_faceSprite((Emotion)e, (FacePart)part) != NULL);
+    return ok;
 }
 
 /**
@@ -835,6 +1337,7 @@ void OrbitoRobot::ActionModule::setExpression(Emotion e)
  */
 void OrbitoRobot::ActionModule::animateEyes(bool enable)
 {
+    DisplayLock guard(Orbito._displayDriver);
     _is_animating = enable;
     if (enable)
     {
@@ -848,29 +1351,521 @@ void OrbitoRobot::ActionModule::animateEyes(bool enable)
  */
 void OrbitoRobot::ActionModule::lookAt(int x, int y)
 {
+    DisplayLock guard(Orbito._displayDriver);
     _current_pupil_x = x;
     _current_pupil_y = y;
-    _redrawEyes();
+    // With the eyes closed they just open looking there
+    if (_gaze.state == GAZE_CLOSED)
+    {
+        _gaze.look_after = false;
+        return;
+    }
+    _gaze.state = GAZE_IDLE;
+    // During a transition the pupils move with it
+    if (_tween.active)
+    {
+        for (uint8_t i = 0 ; i < 2 ; i++)
+        {
+            _tween.to.eyes[i].pupil_x = x;
+            _tween.to.eyes[i].pupil_y = y;
+        }
+        return;
+    }
+    _drawEyes(FACE_EYES_OPEN);
 }
 
 /**
- * @brief Forces an immediate blink animation.
+ * @brief Forces an immediate blink animation. Returns at once, the eyes
+ * open again from Orbito.update().
  */
 void OrbitoRobot::ActionModule::blink()
 {
-    _redrawEyes(0.1);
-    delay(100);
-    _redrawEyes(-1.0);
+    DisplayLock guard(Orbito._displayDriver);
+    if (_tween.active || _gaze.state == GAZE_CLOSED) return;
+    _gaze.look_after = false;
+    _startBlink(millis());
+}
+
+// --- Keyframe Animations ---
+
+// Animation playing from the flash and the pupil movement of its last gaze keyframe
+static KeyframeStream _anim;
+static Keyframe _anim_key;          // Next keyframe to apply
+static bool _anim_pending = false;  // _anim_key holds a keyframe
+static unsigned long _anim_start;
+static struct {
+    bool active = false;
+    unsigned long start;
+    uint16_t duration;
+    Easing easing;
+    int16_t from_x, from_y;
+    int16_t to_x, to_y;
+} _anim_gaze;
+
+// Streams the pixels of a frame keyframe to the screen
+static void _animDrawFrame(const Keyframe& key)
+{
+    int16_t x = (int16_t)animRead16(&key.params[0]);
+    int16_t y = (int16_t)animRead16(&key.params[2]);
+    int16_t w = (int16_t)animRead16(&key.params[4]);
+    int16_t h = (int16_t)animRead16(&key.params[6]);
+    if (key.length < ANIM_PARAM_BYTES + (uint32_t)w * h * 2) return;
+    Orbito.Display.streamPixels(x, y, w, h, [&](uint16_t* dst, int16_t row, int16_t rows) {
+        _anim.readData(key, ANIM_PARAM_BYTES + (uint32_t)row * w * 2, (uint8_t*)dst, (size_t)w * rows * 2);
+    });
+}
+
+// Applies one keyframe
+static void _animApply(const Keyframe& key, unsigned long now)
+{
+    switch (key.track)
+    {
+        case ANIM_TRACK_EXPRESSION:
+            if (key.params[0] > OrbitoRobot::ActionModule::SAD) return;
+            Orbito.Action.setExpression((OrbitoRobot::ActionModule::Emotion)key.params[0], animRead16(&key.params[2]), (Easing)key.easing);
+            return;
+        case ANIM_TRACK_GAZE:
+            _anim_gaze.from_x = _current_pupil_x;
+            _anim_gaze.from_y = _current_pupil_y;
+            _anim_gaze.to_x = (int8_t)key.params[0];
+            _anim_gaze.to_y = (int8_t)key.params[1];
+            _anim_gaze.duration = animRead16(&key.params[2]);
+            _anim_gaze.easing = (Easing)key.easing;
+            _anim_gaze.start = now;
+            _anim_gaze.active = true;
+            return;
+        case ANIM_TRACK_BLINK:
+            Orbito.Action.blink();
+            return;
+        case ANIM_TRACK_FRAME:
+            _animDrawFrame(key);
+            return;
+        default:
+            // Unknown tracks (newer files) are skipped
+            return;
+    }
+}
+
+// Applies the keyframes that are due and moves the pupils (called from update())
+static void _animStep()
+{
+    if (!_anim.isOpen()) return;
+    unsigned long now = millis();
+    uint32_t elapsed = now - _anim_start;
+    // Only the next keyframe is in RAM, the rest stays in the flash
+    while (_anim_pending && _anim_key.time_ms <= elapsed)
+    {
+        _animApply(_anim_key, now);
+        _anim_pending = _anim.next(_anim_key);
+    }
+    if (_anim_gaze.active)
+    {
+        // Shifted only below the duration (16 bits), a gaze left running long can't overflow
+        uint32_t gaze_elapsed = now - _anim_gaze.start;
+        uint32_t t = (gaze_elapsed >= _anim_gaze.duration) ? TRIG_ONE : (gaze_elapsed << TRIG_SHIFT) / _anim_gaze.duration;
+        if (t >= TRIG_ONE) _anim_gaze.active = false;
+        int32_t k = ease(_anim_gaze.easing, t);
+        int16_t x = lerp16(_anim_gaze.from_x, _anim_gaze.to_x, k);
+        int16_t y = lerp16(_anim_gaze.from_y, _anim_gaze.to_y, k);
+        if (x != _current_pupil_x || y != _current_pupil_y) Orbito.Action.lookAt(x, y);
+    }
+    if (_anim_pending || _anim_gaze.active || elapsed < _anim.duration()) return;
+    // End: start again or close
+    if (!_anim.loops())
+    {
+        _anim.close();
+        return;
+    }
+    _anim.rewind();
+    _anim_start = now;
+    _anim_pending = _anim.next(_anim_key);
+}
+
+/**
+ * @brief Copies an animation made with extras/tools/orbito_anim.py to the
+ * flash (erases the sectors it needs, do it once and not every boot).
+ * @param addr Flash address, multiple of 4096. Animations go between sector 2
+ * (0x2000, after the Storage directory) and 0x100000 (Storage files).
+ * @return False if the data is not a valid animation or does not fit there.
+ */
+bool OrbitoRobot::ActionModule::storeAnimation(uint32_t addr, const uint8_t* data, size_t len)
+{
+    DisplayLock guard(Orbito._displayDriver);
+    // The one playing could be overwritten
+    if (_anim.isOpen()) stopAnimation();
+    return KeyframeStream::store(Orbito._flashDriver, addr, data, len);
+}
+
+/**
+ * @brief Starts an animation stored in the flash. Keyframes are read one by
+ * one while it plays from Orbito.update(), so it can be as long as the flash.
+ * @return False if there is no valid animation at that address.
+ */
+bool OrbitoRobot::ActionModule::playAnimation(uint32_t addr)
+{
+    DisplayLock guard(Orbito._displayDriver);
+    _anim_gaze.active = false;
+    if (!_anim.open(&Orbito._flashDriver, addr)) return false;
+    _anim_start = millis();
+    _anim_pending = _anim.next(_anim_key);
+    return true;
+}
+
+/**
+ * @brief Stops the animation (the face stays as it is).
+ */
+void OrbitoRobot::ActionModule::stopAnimation()
+{
+    DisplayLock guard(Orbito._displayDriver);
+    _anim.close();
+    _anim_pending = false;
+    _anim_gaze.active = false;
+}
+
+/**
+ * @brief Checks if an animation is playing.
+ */
+bool OrbitoRobot::ActionModule::isPlaying()
+{
+    return _anim.isOpen();
+}
+
+// --- Motion Tracking ---
+
+// Camera task: core, priority and stack
+#define TRACK_CORE     0
+#define TRACK_PRIORITY 1
+#define TRACK_STACK    4096
+// Gaze: pupil range, smoothing per frame (out of 256) and time before going back to the center
+#define TRACK_RANGE    15
+#define TRACK_SMOOTH   96
+#define TRACK_IDLE_MS  1500
+
+// Reads frames, finds the motion and publishes smoothed pupils until tracking is disabled
+static void _trackLoop()
+{
+    MotionTracker tracker;
+    uint8_t threshold = MOTION_THRESHOLD;
+    int32_t gaze_x = 0, gaze_y = 0;     // Pupils x 256
+    unsigned long last_motion = millis();
+    unsigned long fps_start = last_motion;
+    uint16_t frames = 0;
+    // Frames from the capture task if it runs (shared with the stream), from the camera otherwise
+    FrameSubscriber camera;
+    Orbito.Vision.subscribe(camera);
+    for (;;)
+    {
+        portENTER_CRITICAL(&_track_mux);
+        bool stop = !_track.enabled;
+        if (stop) _track.running = false;
+        uint8_t wanted = _track.threshold;
+        portEXIT_CRITICAL(&_track_mux);
+        if (stop) break;
+        if (wanted != threshold)
+        {
+            threshold = wanted;
+            tracker.configure(MOTION_STEP, threshold);
+        }
+        // The loop can share the same frame with Vision.capture(max_age_ms)
+        FrameRef frame = camera.wait(CAPTURE_WAIT_MS);
+        if (!frame)
+        {
+            vTaskDelay(pdMS_TO_TICKS(20));
+            continue;
+        }
+        bool moved = false;
+        if (frame.format() == PIXFORMAT_GRAYSCALE || frame.format() == PIXFORMAT_RGB565)
+            moved = tracker.update(frame.data(), frame.width(), frame.height(), frame.format() == PIXFORMAT_RGB565);
+        frame.reset();
+        // Follow the motion, hold still for a while and then look ahead again
+        unsigned long now = millis();
+        int32_t target_x = gaze_x, target_y = gaze_y;
+        if (moved)
+        {
+            last_motion = now;
+            target_x = tracker.x() * TRACK_RANGE * 256 / 100;
+            target_y = tracker.y() * TRACK_RANGE * 256 / 100;
+        }
+        else if (now - last_motion > TRACK_IDLE_MS) target_x = target_y = 0;
+        gaze_x += (target_x - gaze_x) * TRACK_SMOOTH / 256;
+        gaze_y += (target_y - gaze_y) * TRACK_SMOOTH / 256;
+        frames++;
+        portENTER_CRITICAL(&_track_mux);
+        _track.x = (gaze_x + 128) >> 8;
+        _track.y = (gaze_y + 128) >> 8;
+        _track.fresh = true;
+        if (now - fps_start >= 1000)
+        {
+            _track.fps = frames * 1000.0f / (now - fps_start);
+            frames = 0;
+            fps_start = now;
+        }
+        portEXIT_CRITICAL(&_track_mux);
+        // Let the lower priority tasks of this core run
+        vTaskDelay(1);
+    }
+}
+
+// Camera task (runs on TRACK_CORE): the loop returns first so its buffers are freed
+static void _trackTask(void* param)
+{
+    _trackLoop();
+    vTaskDelete(NULL);
+}
+
+// Moves the eyes to the last pupils found by the camera task (called from update())
+static void _trackStep()
+{
+    if (!_track.enabled) return;
+    portENTER_CRITICAL(&_track_mux);
+    bool fresh = _track.fresh;
+    int16_t x = _track.x;
+    int16_t y = _track.y;
+    _track.fresh = false;
+    portEXIT_CRITICAL(&_track_mux);
+    if (!fresh || (x == _current_pupil_x && y == _current_pupil_y)) return;
+    Orbito.Action.lookAt(x, y);
+}
+
+/**
+ * @brief Makes the eyes follow whatever moves in front of the camera. Frames are
+ * analysed in a task on core 0, the eyes move from Orbito.update().
+ * The camera must be in an uncompressed mode (MODE_AI or MODE_GRAYSCALE).
+ * @return False if the camera is not ready or sends JPEG.
+ */
+bool OrbitoRobot::ActionModule::followMotion(bool enable)
+{
+    if (!enable)
+    {
+        _track.enabled = false;
+        return true;
+    }
+    if (!Orbito._cameraDriver.isInitialized() || Orbito._cameraDriver.getPixelFormat() == PIXFORMAT_JPEG) return false;
+    // The task may still be alive if it was just stopped: it simply goes on
+    portENTER_CRITICAL(&_track_mux);
+    _track.enabled = true;
+    bool start = !_track.running;
+    _track.running = true;
+    portEXIT_CRITICAL(&_track_mux);
+    if (!start) return true;
+    if (xTaskCreatePinnedToCore(_trackTask, "orbito_track", TRACK_STACK, NULL, TRACK_PRIORITY, NULL, TRACK_CORE) == pdPASS) return true;
+    _track.enabled = _track.running = false;
+    return false;
+}
+
+/**
+ * @brief Brightness change (0-255) that counts as motion. Lower values react
+ * to smaller movements but also to camera noise (default 24).
+ */
+void OrbitoRobot::ActionModule::setMotionSensitivity(uint8_t threshold)
+{
+    _track.threshold = threshold;
+}
+
+/**
+ * @brief Frames per second analysed by the motion tracking (0 if it is off).
+ */
+float OrbitoRobot::ActionModule::getTrackingFps()
+{
+    return _track.enabled ? _track.fps : 0;
 }
 
 // --- Communication ---
 
+// Layouts of the last texts said (the oldest one is replaced)
+static TextLayout _say_layouts[SAY_CACHE];
+static uint8_t _say_oldest = 0;
+
+// Finds the layout of a text or makes it (NULL if there is no memory)
+static const TextLayout* _sayLayout(const char* text)
+{
+    for (uint8_t i = 0 ; i < SAY_CACHE ; i++)
+        if (_say_layouts[i].matches(text, SAY_COLUMNS)) return &_say_layouts[i];
+    TextLayout& layout = _say_layouts[_say_oldest];
+    _say_oldest = (_say_oldest + 1) % SAY_CACHE;
+    return layout.build(text, SAY_COLUMNS) ? &layout : NULL;
+}
+
+// Pages of the text on the bubble
+static uint16_t _sayPages()
+{
+    return max(1, (_say.layout->lineCount() + SAY_LINES - 1) / SAY_LINES);
+}
+
+// Draws the bubble with the current page and sets when the next one is shown
+static void _drawBubble()
+{
+    const TextLayout& layout = *_say.layout;
+    int16_t bottom = SAY_BUBBLE_Y + SAY_BUBBLE_H;
+    _face_list.clear();
+    _face_list.fillRect(0, SAY_BUBBLE_Y, FACE_SCREEN_W, FACE_SCREEN_H - SAY_BUBBLE_Y, 0x0000);
+    _face_list.fillRoundRect(SAY_BUBBLE_X, SAY_BUBBLE_Y, SAY_BUBBLE_W, SAY_BUBBLE_H, SAY_BUBBLE_R, 0xFFFF);
+    // Comic tail under the bubble
+    _face_list.fillTriangle(SAY_BUBBLE_X + 20, bottom - 1, SAY_BUBBLE_X + 44, bottom - 1, SAY_BUBBLE_X + 14, FACE_SCREEN_H - 2, 0xFFFF);
+    // Lines are recorded by pointer, they live in the layout cache
+    uint16_t first = _say.page * SAY_LINES;
+    uint16_t chars = 0;
+    int16_t text_y = SAY_BUBBLE_Y + (SAY_BUBBLE_H - SAY_LINES * GLYPH_HEIGHT * SAY_TEXT_SIZE) / 2;
+    for (uint16_t i = first ; i < first + SAY_LINES && i < layout.lineCount() ; i++)
+    {
+        _face_list.drawText(SAY_BUBBLE_X + SAY_PADDING, text_y, layout.line(i), 0x0000, SAY_TEXT_SIZE);
+        text_y += GLYPH_HEIGHT * SAY_TEXT_SIZE;
+        chars += strlen(layout.line(i));
+    }
+    // More pages to come: small arrow in the corner
+    if (_say.page + 1 < _sayPages())
+    {
+        int16_t x = SAY_BUBBLE_X + SAY_BUBBLE_W - SAY_PADDING;
+        _face_list.fillTriangle(x - 8, bottom - 10, x, bottom - 10, x - 4, bottom - 5, 0x0000);
+    }
+    Orbito.Display.drawScene(_face_list, SAY_BUBBLE_Y, FACE_SCREEN_H - SAY_BUBBLE_Y);
+    _say.next_page = millis() + max((uint32_t)SAY_PAGE_MIN_MS, (uint32_t)chars * SAY_CHAR_MS);
+}
+
+// Turns the pages of a long text (called from update())
+static void _sayStep()
+{
+    if (!_say.visible || _say.page + 1 >= _sayPages() || (long)(millis() - _say.next_page) < 0) return;
+    _say.page++;
+    _drawBubble();
+}
+
 /**
- * @brief Displays a comic-style speech bubble with text.
+ * @brief Displays a comic-style speech bubble with text over the mouth.
+ * Long texts are shown in pages of 3 lines that turn by themselves from
+ * Orbito.update(). The bubble stays until hideBubble() (or say("")).
  */
 void OrbitoRobot::ActionModule::say(String text)
 {
+    DisplayLock guard(Orbito._displayDriver);
+    if (text.length() == 0)
+    {
+        hideBubble();
+        return;
+    }
+    // Same text as before: it is not laid out again
+    const TextLayout* layout = _sayLayout(text.c_str());
+    if (!layout) return;
+    _say.layout = layout;
+    _say.page = 0;
+    _say.visible = true;
+    _drawBubble();
+}
+
+/**
+ * @brief Removes the speech bubble. Only the rows it covered are drawn
+ * again (the mouth of the current expression), the rest of the face stays.
+ */
+void OrbitoRobot::ActionModule::hideBubble()
+{
+    DisplayLock guard(Orbito._displayDriver);
+    if (!_say.visible) return;
+    _say.visible = false;
+    _face_list.clear();
+    _face_list.fillRect(0, SAY_BUBBLE_Y, FACE_SCREEN_W, FACE_SCREEN_H - SAY_BUBBLE_Y, 0x0000);
+    faceRenderMouth(_face_list, _tween.active ? _tween.shown.mouth : faceMouthParams((FaceEmotion)_current_emotion));
+    Orbito.Display.drawScene(_face_list, SAY_BUBBLE_Y, FACE_SCREEN_H - SAY_BUBBLE_Y);
+}
+
+/**
+ * @brief Checks if the speech bubble is on the screen.
+ */
+bool OrbitoRobot::ActionModule::isSaying()
+{
+    return _say.visible;
+}
+
+// --- Animation Task ---
+
+// Face task: time step, priority (loop() runs with 1) and stack
+#define FACE_TASK_PERIOD_US 10000
+#define FACE_TASK_PRIORITY  2
+#define FACE_TASK_STACK     4096
+
+static esp_timer_handle_t _face_timer = NULL;
+static SemaphoreHandle_t _face_tick = NULL;
+
+// Timer callback: lets the face task run one step. Ticks missed during a
+// slow frame are merged into one (the steps follow the clock, none is lost)
+static void _faceTimer(void* arg)
+{
+    xSemaphoreGive(_face_tick);
+}
+
+// Advances every face animation (keyframes start transitions, which have
+// priority over blinks and saccades). The screen is held for the whole step,
+// so a frame is never mixed with the drawings of another task
+static void _faceStep()
+{
+    Orbito.Display.lock();
+    _trackStep();
+    _animStep();
+    if (!_tweenStep()) _eyesStep();
+    _sayStep();
+    Orbito.Display.unlock();
+}
+
+/**
+ * @brief Body of the face task: one animation step per timer tick.
+ */
+void OrbitoRobot::_faceTask(void* param)
+{
+    for (;;)
+    {
+        xSemaphoreTake(_face_tick, portMAX_DELAY);
+        portENTER_CRITICAL(&_face_mux);
+        bool stop = !_face_task.enabled;
+        if (stop) _face_task.running = false;
+        portEXIT_CRITICAL(&_face_mux);
+        if (stop) break;
+        _faceStep();
+        Orbito._displayDriver.flushAsync();
+    }
+    vTaskDelete(NULL);
+}
 
+/**
+ * @brief Moves the face animation (blinks, transitions, keyframes, speech bubble
+ * and motion tracking) to its own task, woken at a fixed rate by a timer, so
+ * its speed does not depend on how often the loop calls Orbito.update().
+ * @param core Core of the task (loop() runs in core 1, WiFi and BLE in core 0).
+ * @return True if the task is running.
+ */
+bool OrbitoRobot::ActionModule::enableAnimationTask(bool enable, uint8_t core)
+{
+    if (!enable)
+    {
+        // The task exits on its next tick, update() takes over right now
+        _face_task.enabled = false;
+        if (_face_timer) esp_timer_stop(_face_timer);
+        if (_face_tick) xSemaphoreGive(_face_tick);
+        return false;
+    }
+    if (_face_task.enabled) return true;
+    if (!_face_tick) _face_tick = xSemaphoreCreateBinary();
+    if (!_face_tick) return false;
+    if (!_face_timer)
+    {
+        esp_timer_create_args_t args = {};
+        args.callback = _faceTimer;
+        args.dispatch_method = ESP_TIMER_TASK;
+        args.name = "orbito_face";
+        if (esp_timer_create(&args, &_face_timer) != ESP_OK) return false;
+    }
+    // The task may still be alive if it was just stopped: it simply goes on
+    portENTER_CRITICAL(&_face_mux);
+    _face_task.enabled = true;
+    bool start = !_face_task.running;
+    _face_task.running = true;
+    portEXIT_CRITICAL(&_face_mux);
+    if (start && xTaskCreatePinnedToCore(OrbitoRobot::_faceTask, "orbito_face", FACE_TASK_STACK, NULL,
+                                         FACE_TASK_PRIORITY, NULL, core) != pdPASS)
+    {
+        _face_task.enabled = _face_task.running = false;
+        return false;
+    }
+    esp_timer_start_periodic(_face_timer, FACE_TASK_PERIOD_US);
+    return true;
 }
 
 // =============================================================
@@ -903,6 +1898,12 @@ AIResult OrbitoRobot::BrainModule::predict(camera_fb_t* image)
     return Orbito._aiAdapter->predict(image);
 }
 
+AIResult OrbitoRobot::BrainModule::predict(const FrameRef& image)
+{
+    // The model only reads the pixels, other holders of the frame see them unchanged
+    return predict(const_cast<camera_fb_t*>(image.get()));
+}
+
 /**
  * @brief Runs inference on raw sensor data (Gestures / Audio).
  */
@@ -941,14 +1942,8 @@ bool OrbitoRobot::BrainModule::isLoaded()
 
 bool OrbitoRobot::StorageModule::writeFile(String path, String content)
 {
-    Orbito._flashDriver.eraseSector(0);
-    Orbito._flashDriver.waitForReady(); 
-    uint32_t len = content.length();
-    if (len > 4092) len = 4092; 
-    Orbito._flashDriver.write(0, (const uint8_t*)&len, 4);
-    if (len > 0) Orbito._flashDriver.write(4, (const uint8_t*)content.c_str(), len);
-    Orbito._flashDriver.waitForReady();
-    return true;
+    path = _cleanPath(path);
+    return Orbito._files.write(path.c_str(), (const uint8_t*)content.c_str(), content.length());
 }
 
 bool OrbitoRobot::StorageModule::appendFile(String path, String content)
@@ -960,13 +1955,12 @@ bool OrbitoRobot::StorageModule::appendFile(String path, String content)
 
 String OrbitoRobot::StorageModule::readFile(String path)
 {
-    uint32_t len = 0;
-    Orbito._flashDriver.read(0, (uint8_t*)&len, 4);
-    if (len == 0xFFFFFFFF || len == 0) return "";
-    if (len > 4092) return "ERROR: Data corrupted";
+    path = _cleanPath(path);
+    uint32_t len = Orbito._files.size(path.c_str());
+    if (len == 0) return "";
     char* buffer = (char*)malloc(len + 1); 
     if (!buffer) return "";
-    Orbito._flashDriver.read(4, (uint8_t*)buffer, len);
+    len = Orbito._files.read(path.c_str(), 0, (uint8_t*)buffer, len);
     buffer[len] = '\0';
     String resultado = String(buffer);
     free(buffer);
@@ -975,24 +1969,44 @@ String OrbitoRobot::StorageModule::readFile(String path)
 
 bool OrbitoRobot::StorageModule::exists(String path)
 {
-    uint32_t len = 0;
-    Orbito._flashDriver.read(0, (uint8_t*)&len, 4);
-    return (len > 0 && len <= 4092);
+    path = _cleanPath(path);
+    return Orbito._files.exists(path.c_str());
 }
 
 bool OrbitoRobot::StorageModule::remove(String path)
 {
-    Orbito._flashDriver.eraseSector(0);
-    Orbito._flashDriver.waitForReady();
-    return true;
+    path = _cleanPath(path);
+    return Orbito._files.remove(path.c_str());
+}
+
+size_t OrbitoRobot::StorageModule::fileSize(String path)
+{
+    path = _cleanPath(path);
+    return Orbito._files.size(path.c_str());
+}
+
+size_t OrbitoRobot::StorageModule::readBytes(String path, uint32_t offset, uint8_t* buffer, size_t len)
+{
+    path = _cleanPath(path);
+    return Orbito._files.read(path.c_str(), offset, buffer, len);
+}
+
+bool OrbitoRobot::StorageModule::openFrameLog(String path, FrameLogReader& reader)
+{
+    path = _cleanPath(path);
+    return reader.open(Orbito._files, path.c_str());
 }
 
 // --- Management ---
 
 void OrbitoRobot::StorageModule::format()
 {
+    // A recording would go on writing into the erased chip
+    Orbito._frameLog.stop();
+    FlashLock guard(Orbito._flashDriver);
     Orbito._flashDriver.eraseChip();
     Orbito._flashDriver.waitForReady();
+    Orbito._files.format();
 }
 
 int OrbitoRobot::StorageModule::getTotalSpace()
@@ -1005,10 +2019,7 @@ int OrbitoRobot::StorageModule::getTotalSpace()
 
 int OrbitoRobot::StorageModule::getUsedSpace()
 {
-    uint32_t len = 0;
-    Orbito._flashDriver.read(0, (uint8_t*)&len, 4);
-    if (len == 0xFFFFFFFF) return 0;
-    return (int)len;
+    return (int)Orbito._files.usedSpace();
 }
 
 String OrbitoRobot::StorageModule::_cleanPath(String path)
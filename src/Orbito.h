@@ -25,7 +25,14 @@
 #include "./core/NFCHandler.h"
 #include "./core/PortHandler.h"
 #include "./core/DisplayHandler.h"
+#include "./core/FaceRenderer.h"
+#include "./core/Easing.h"
+#include "./core/KeyframeStream.h"
+#include "./core/TextLayout.h"
+#include "./core/MotionTracker.h"
 #include "./core/FlashHandler.h"
+#include "./core/FlashFiles.h"
+#include "./core/FrameLog.h"
 #include "./core/BLEHandler.h"
 #include "./core/WiFiHandler.h"
 #include "./core/WebServerHandler.h"
@@ -176,9 +183,20 @@ class OrbitoRobot {
              */
             camera_fb_t* snapshot();
 
+            /**
+             * @brief Captures a frame that can be shared: copies of the FrameRef point to
+             * the same pixels and it is freed by itself when the last copy is gone.
+             * @param max_age_ms Reuses the last frame captured (by the web stream, the AI or
+             * your code) if it is this recent, instead of asking the camera again (0 = always new).
+             */
+            FrameRef capture(uint32_t max_age_ms = 0);
+
             /**
              * @brief Captures a frame and saves it directly to Flash memory as JPEG.
-             * @param filename Path to save (e.g., "/photo1.jpg").
+             * The bytes go from the camera buffer to the flash page by page (RGB565 and
+             * grayscale frames are encoded on the way). Read it back with Storage.
+             * @param filename Path to save (e.g., "/photo1.jpg", up to 19 characters).
+             * @return False if there is no room (a UXGA photo needs about 200 KB).
              */
             bool saveSnapshot(String filename);
 
@@ -187,9 +205,66 @@ class OrbitoRobot {
              */
             void release(camera_fb_t* fb);
 
+            // --- Shared Capture ---
+
+            /**
+             * @brief Starts a task (pinned to a core) that reads the camera at its own speed
+             * and hands every frame to the subscribers, the web stream and capture().
+             * Nobody waits for anybody: a slow reader just skips frames.
+             * @param core Core of the task (0 leaves core 1 for the loop and the face).
+             */
+            bool startCapture(uint8_t core = 0);
+
+            /**
+             * @brief Stops the capture task, each reader asks the camera by itself again.
+             */
+            void stopCapture();
+
+            /**
+             * @brief Frames per second read by the capture task (0 if it is off).
+             */
+            float getCaptureFps();
+
+            /**
+             * @brief Registers a mailbox that always holds the newest frame (unread ones are replaced).
+             * @param max_fps Maximum frames per second it receives (0 = all).
+             * @param every_nth Receives one frame out of every N (1 = all).
+             */
+            bool subscribe(FrameSubscriber& subscriber, uint8_t max_fps = 0, uint8_t every_nth = 1);
+
+            /**
+             * @brief Removes a mailbox (also done when it is destroyed).
+             */
+            void unsubscribe(FrameSubscriber& subscriber);
+
+            // --- Bursts and Timelapses ---
+
+            /**
+             * @brief Records every frame the sensor gives into one file (in the background).
+             * Frames that arrive while the flash is still busy are skipped (see getRecordingStats()).
+             * @param path File of the log (read it with Storage.openFrameLog()).
+             * @param frames Frames to record (0 = until stopRecording() or the flash is full).
+             */
+            bool startBurst(String path, uint16_t frames);
+
+            /**
+             * @brief Records one frame every interval_ms into one file (in the background).
+             * @param frames Frames to record (0 = until stopRecording() or the flash is full).
+             */
+            bool startTimelapse(String path, uint32_t interval_ms, uint16_t frames = 0);
+
+            /**
+             * @brief Ends the recording, the file is ready when it returns.
+             */
+            void stopRecording();
+
+            bool isRecording();                 // False once the file is ready
+            FrameLogStats getRecordingStats();  // Frames, bytes, fps and dropped frames
+
             // --- Hardware Adjustment ---
 
-            void setMode(CameraHandler::Camera_Mode mode);
+            bool setMode(CameraHandler::Camera_Mode mode);  // Also while running (see getModeSwitchStats)
+            CameraModeSwitch getModeSwitchStats();  // Time taken by the last setMode()
             void setResolution(framesize_t size);   // QVGA, VGA, SVGA, UXGA...
             void setQuality(int quality);           // JPEG Quality (0-63)
             void setEffect(int effect);             // Hardware FX (Sepia, Negative...)
@@ -224,12 +299,68 @@ class OrbitoRobot {
             void setCursor(int x, int y);
             void setTextColor(uint16_t color);
 
+            /**
+             * @brief Sets the text color with a solid background. Text is drawn faster
+             * and overwrites what was below (useful for values that change).
+             */
+            void setTextColor(uint16_t color, uint16_t background);
+
+            /**
+             * @brief Draws a whole list of recorded primitives at once.
+             * Much faster than calling the functions above one by one.
+             */
+            void submit(const DrawList& list);
+
+            /**
+             * @brief Draws a full scene without flicker and without PSRAM. The list is
+             * composed in RAM by horizontal bands and each band is sent complete.
+             * @param scene Commands of the whole frame (start it with fillScreen()).
+             * @param y First row to compose.
+             * @param h Rows to compose (-1 = down to the bottom).
+             */
+            void drawScene(const DrawList& scene, int y = 0, int h = -1);
+
+            /**
+             * @brief Height (rows) of the bands used by drawScene(). Taller bands are
+             * faster but use more RAM (default 16).
+             * @return False if there is not enough memory for that size.
+             */
+            bool setBandSize(int lines);
+
+            /**
+             * @brief Draws a pre-rendered sprite (see RleSprite) on its area of the screen.
+             * @param shift_x Moves the content inside the area (the rest is background).
+             * @param shift_y Moves the content inside the area (the rest is background).
+             */
+            void drawSprite(const RleSprite& sprite, int16_t shift_x = 0, int16_t shift_y = 0);
+
+            /**
+             * @brief Replaces a sprite drawn before with another one of the same area
+             * sending only the pixels that change (ideal to move a small detail).
+             * @param shown Sprite on the screen and the displacement it was drawn with.
+             * @param sprite Sprite to show and its displacement.
+             */
+            void drawSpriteDelta(const RleSprite& shown, int16_t shown_x, int16_t shown_y,
+                                 const RleSprite& sprite, int16_t shift_x = 0, int16_t shift_y = 0);
+
+            /**
+             * @brief Draws an image produced a few rows at a time, without keeping it
+             * whole in RAM (for example, read from the flash).
+             * @param source Fills rows (w pixels each, big-endian RGB565) into dst.
+             */
+            void streamPixels(int16_t x, int16_t y, int16_t w, int16_t h,
+                              std::function<void(uint16_t* dst, int16_t row, int16_t rows)> source);
+
             // --- Multimedia ---
 
             /**
-             * @brief Draws a raw Camera Frame (RGB565) onto the screen.
+             * @brief Draws a Camera Frame (RGB565, Grayscale or JPEG) onto the screen.
+             * The frame is not modified, it can still be saved or sent after this.
+             * @param fit_screen True to scale any resolution to the screen (keeping
+             * the proportions), false to draw it at its real size, centered.
              */
-            void drawSnapshot(camera_fb_t* fb);
+            void drawSnapshot(camera_fb_t* fb, bool fit_screen = true);
+            void drawSnapshot(const FrameRef& frame, bool fit_screen = true);
 
             /**
              * @brief Draws a raw RGB565 bitmap array.
@@ -237,9 +368,13 @@ class OrbitoRobot {
             void drawBitmap(int x, int y, const uint8_t* bmp, int w, int h, uint16_t color);
 
             /**
-             * @brief Draws a pre-loaded icon/emoji by name.
+             * @brief Draws a pre-loaded icon/emoji by name ("smile", "heart", "star"...,
+             * see extras/tools/make_emoji_atlas.py). Icons are 32x32 pixels.
+             * @param scale Size multiplier (2 = 64x64).
+             * @param background Color of the transparent pixels.
+             * @return False if there is no icon with that name.
              */
-            void drawEmoji(String emojiName, int x, int y);
+            bool drawEmoji(String emojiName, int x, int y, uint8_t scale = 1, uint16_t background = 0x0000);
 
             // --- Visual Console ---
 
@@ -248,11 +383,87 @@ class OrbitoRobot {
              */
             void consoleLog(String text);
 
+            /**
+             * @brief Clears the screen and the console history.
+             */
+            void consoleClear();
+
+            /**
+             * @brief Shows again the last console lines (e.g. after drawing over them).
+             */
+            void consoleRedraw();
+
+            /**
+             * @brief Text size and colors of the console (the background must be
+             * solid). The lines shown are drawn again with the new style.
+             */
+            void setConsoleStyle(uint8_t size, uint16_t color, uint16_t background);
+
             /**
              * @brief Sets the text size (1, 2, 3...).
              */
             void setFont(int size);
 
+            // --- Rendering ---
+
+            /**
+             * @brief Enables the off-screen canvas (needs PSRAM). Drawings are done in RAM
+             * and only the changed regions are sent to the screen in update().
+             * @return True if the canvas mode is active.
+             */
+            bool enableCanvas(bool enable);
+
+            /**
+             * @brief Sends the pending canvas changes to the screen right now.
+             */
+            void flush();
+
+            /**
+             * @brief Sends the screen updates from a background task on the other core,
+             * so update() does not wait for the pixels to reach the screen.
+             * @return True if the background sending is active.
+             */
+            bool enableAsync(bool enable = true);
+
+            /**
+             * @brief Waits until every pending update is on the screen.
+             */
+            void waitFlush();
+
+            /**
+             * @brief Sets a function called when a background update reaches the screen.
+             * CAUTION: it runs in the display task, keep it short.
+             */
+            void onFlushDone(std::function<void()> callback);
+
+            /**
+             * @brief Reads the display counters (primitives, pixels, bus time, fps).
+             * The library must be built with ORBITO_DISPLAY_STATS.
+             * @param reset Starts counting again after reading.
+             * @return False if the counters are not compiled in.
+             */
+            bool getStats(DisplayStats& stats, bool reset = false);
+
+            /**
+             * @brief Reserves the screen for this task until unlock(). Use it around a
+             * group of drawings when the face animation runs in its own task, so the
+             * face is never drawn in the middle (calls can be nested).
+             * @param timeout_ms Maximum wait (by default it waits as long as needed).
+             * @return False if the screen was still busy after the timeout.
+             */
+            bool lock(uint32_t timeout_ms = DISPLAY_WAIT_FOREVER);
+
+            /**
+             * @brief Frees the screen reserved with lock().
+             */
+            void unlock();
+
+            /**
+             * @brief Number that changes every time something is drawn. Save it after
+             * drawing and compare it later to know if the screen was drawn over.
+             */
+            uint32_t generation();
+
             // --- Hardware ---
 
             void turnOn();
@@ -269,26 +480,8 @@ class OrbitoRobot {
         struct ActionModule
         {
             enum Emotion { WORRY, ANGRY, HAPPY, NEUTRAL, SURPRISE, SLEEPY, SAD };
-            struct EyeParams {
-                int16_t x;            // Position X (Center)
-                int16_t y;            // Position Y (Center)
-                int16_t width;        // Eye total width
-                int16_t height;       // Eye total height
-                int16_t pupil_x;      // Position X pupil (-15 to 15)
-                int16_t pupil_y;      // Position Y pupil (-15 to 15)
-                int16_t margin;       // Size difference between Eye and Pupil
-                float open_factor;    // 0.0 (Close) a 1.0 (Open)
-                bool has_eyebrown;    // Flag to draw an eyebrown
-                bool is_left_eye;     // Flag to draw left or right eyebrown
-                uint8_t eyebr_type;   // ID of eyebrown type to draw
-            };
-            struct MouthParams {
-                int16_t x;           // Position X (Center)
-                int16_t y;           // Position Y (Center)
-                int16_t width;       // Mouth total width
-                int16_t height;      // Mouth line thickness
-                int8_t shape;        // 0=Neutral, 1=Smile, 2=Sad, 3=Surprise
-            };
+            typedef FaceEyeParams EyeParams;
+            typedef FaceMouthParams MouthParams;
 
             // --- Expressivity ---
 
@@ -297,6 +490,31 @@ class OrbitoRobot {
              */
             void setExpression(Emotion e);
 
+            /**
+             * @brief Changes the expression gradually (eyes, eyebrows and mouth move
+             * from the current face to the new one). Needs Orbito.update() in the loop.
+             * @param duration_ms Length of the transition (0 = instant).
+             * @param easing EASE_LINEAR, EASE_IN, EASE_OUT or EASE_IN_OUT.
+             */
+            void setExpression(Emotion e, uint16_t duration_ms, Easing easing = EASE_IN_OUT);
+
+            /**
+             * @brief Frame rate of the transitions and drawing time allowed per frame.
+             * Slow frames make the next ones wait (skipping steps), the loop never stalls.
+             */
+            void setAnimationRate(uint8_t fps, uint8_t budget_ms);
+
+            /**
+             * @brief Checks if an expression transition is running.
+             */
+            bool isTransitioning();
+
+            /**
+             * @brief Renders every expression now instead of the first time it is shown.
+             * @return False if they do not fit in memory (faces are drawn from shapes then).
+             */
+            bool cacheExpressions();
+
             /**
              * @brief Enables automatic eye blinking and random pupil movement.
              */
@@ -308,17 +526,91 @@ class OrbitoRobot {
             void lookAt(int x, int y);
 
             /**
-             * @brief Forces an immediate blink animation.
+             * @brief Forces an immediate blink animation. It does not wait: the
+             * eyes open again from Orbito.update() after 100 ms.
              */
             void blink();
 
+            // --- Keyframe Animations ---
+
+            /**
+             * @brief Copies an animation made with extras/tools/orbito_anim.py to the
+             * flash (erases the sectors it needs, do it once and not every boot).
+             * @param addr Flash address, multiple of 4096. Animations go between sector 2
+             * (0x2000, after the Storage directory) and 0x100000 (Storage files).
+             * @return False if the data is not a valid animation or does not fit there.
+             */
+            bool storeAnimation(uint32_t addr, const uint8_t* data, size_t len);
+
+            /**
+             * @brief Starts an animation stored in the flash. Keyframes are read one by
+             * one while it plays from Orbito.update(), so it can be as long as the flash.
+             * @return False if there is no valid animation at that address.
+             */
+            bool playAnimation(uint32_t addr);
+
+            /**
+             * @brief Stops the animation (the face stays as it is).
+             */
+            void stopAnimation();
+
+            /**
+             * @brief Checks if an animation is playing.
+             */
+            bool isPlaying();
+
+            // --- Motion Tracking ---
+
+            /**
+             * @brief Makes the eyes follow whatever moves in front of the camera. Frames are
+             * analysed in a task on core 0, the eyes move from Orbito.update().
+             * The camera must be in an uncompressed mode (MODE_AI or MODE_GRAYSCALE).
+             * @return False if the camera is not ready or sends JPEG.
+             */
+            bool followMotion(bool enable);
+
+            /**
+             * @brief Brightness change (0-255) that counts as motion. Lower values react
+             * to smaller movements but also to camera noise (default 24).
+             */
+            void setMotionSensitivity(uint8_t threshold);
+
+            /**
+             * @brief Frames per second analysed by the motion tracking (0 if it is off).
+             */
+            float getTrackingFps();
+
             // --- Communication ---
 
             /**
-             * @brief Displays a comic-style speech bubble with text.
+             * @brief Displays a comic-style speech bubble with text over the mouth.
+             * Long texts are shown in pages of 3 lines that turn by themselves from
+             * Orbito.update(). The bubble stays until hideBubble() (or say("")).
              */
             void say(String text);
 
+            /**
+             * @brief Removes the speech bubble. Only the rows it covered are drawn
+             * again (the mouth of the current expression), the rest of the face stays.
+             */
+            void hideBubble();
+
+            /**
+             * @brief Checks if the speech bubble is on the screen.
+             */
+            bool isSaying();
+
+            // --- Animation Task ---
+
+            /**
+             * @brief Moves the face animation (blinks, transitions, keyframes, speech bubble
+             * and motion tracking) to its own task, woken at a fixed rate by a timer, so
+             * its speed does not depend on how often the loop calls Orbito.update().
+             * @param core Core of the task (loop() runs in core 1, WiFi and BLE in core 0).
+             * @return True if the task is running.
+             */
+            bool enableAnimationTask(bool enable = true, uint8_t core = 1);
+
         } Action;
 
         // =============================================================
@@ -343,6 +635,7 @@ class OrbitoRobot {
              * @brief Runs inference on a Camera Frame (Object Detection / Classification).
              */
             AIResult predict(camera_fb_t* image);
+            AIResult predict(const FrameRef& image);
 
             /**
              * @brief Runs inference on raw sensor data (Gestures / Audio).
@@ -367,7 +660,7 @@ class OrbitoRobot {
         // 6. STORAGE MODULE (Flash Memory)
         // =============================================================
         /**
-         * @brief File System Manager (LittleFS/FATFS).
+         * @brief File System Manager (named files in the external Flash, see FlashFiles).
          */
         struct StorageModule
         {
@@ -377,11 +670,14 @@ class OrbitoRobot {
             String readFile(String path);
             bool exists(String path);
             bool remove(String path);
+            size_t fileSize(String path);   // 0 if it does not exist
+            size_t readBytes(String path, uint32_t offset, uint8_t* buffer, size_t len); // Binary files (photos)
+            bool openFrameLog(String path, FrameLogReader& reader); // Bursts and timelapses
 
             // --- Management ---
             void format();      // Wipes the entire memory
             int getTotalSpace();
-            int getUsedSpace();
+            int getUsedSpace(); // Bytes of all the files
 
             // --- Helper ---
             static String _cleanPath(String path);
@@ -560,7 +856,7 @@ class OrbitoRobot {
 
         /**
          * @brief Main system loop. Must be called inside the Arduino loop().
-         * Handles WiFi reconnection, OTA, BLE events, and Eye Animations.
+         * Handles WiFi reconnection, OTA, BLE events, Eye Animations and screen refresh.
          */
         void update();
 
@@ -581,12 +877,18 @@ class OrbitoRobot {
         WebServerHandler _webDriver;
         PortHandler      _ioDriver;
         FlashHandler     _flashDriver;
+        FlashFiles       _files;
+        FrameLog         _frameLog;
         MicHandler       _micDriver;
         ExtModCommands   _modules;
 
         // --- INTERNAL STATE ---
         bool _initialized;
 
+        // --- BACKGROUND TASKS ---
+        // Face animation task (see ActionModule::enableAnimationTask())
+        static void _faceTask(void* param);
+
         // --- FRIENDSHIPS ---
         // Granting modules access to private drivers
         friend struct SystemModule;
@@ -0,0 +1,72 @@
+#include "BandCanvas.h"
+
+/**
+ * @brief Constructor.
+ * @param w Screen width in pixels.
+ * @param h Screen height in pixels.
+ */
+BandCanvas::BandCanvas(int16_t w, int16_t h)
+    : Adafruit_GFX(w, h)
+{
+    _buffer = NULL;
+    _band_y0 = _band_y1 = 0;
+}
+
+/**
+ * @brief Selects the rows this canvas represents.
+ * @param buffer Memory for w * lines pixels.
+ * @param y First screen row of the band.
+ * @param lines Number of rows.
+ */
+void BandCanvas::setBand(uint16_t* buffer, int16_t y, int16_t lines)
+{
+    _buffer = buffer;
+    _band_y0 = y;
+    _band_y1 = y + lines;
+}
+
+// --- Adafruit GFX rasterization hooks ---
+
+void BandCanvas::drawPixel(int16_t x, int16_t y, uint16_t color)
+{
+    if (x < 0 || x >= WIDTH || y < _band_y0 || y >= _band_y1) return;
+    _buffer[(y - _band_y0) * WIDTH + x] = __builtin_bswap16(color);
+}
+
+void BandCanvas::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+    if (y < _band_y0 || y >= _band_y1 || w <= 0) return;
+    if (x < 0) { w += x; x = 0; }
+    if (x + w > WIDTH) w = WIDTH - x;
+    if (w <= 0) return;
+    uint16_t swapped = __builtin_bswap16(color);
+    uint16_t* dst = &_buffer[(y - _band_y0) * WIDTH + x];
+    for (int16_t i = 0 ; i < w ; i++) dst[i] = swapped;
+}
+
+void BandCanvas::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+    fillRect(x, y, 1, h, color);
+}
+
+void BandCanvas::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+    if (w <= 0 || h <= 0) return;
+    // Most shapes are taller than the band, clip them to it
+    if (x < 0) { w += x; x = 0; }
+    if (y < _band_y0) { h -= _band_y0 - y; y = _band_y0; }
+    if (x + w > WIDTH) w = WIDTH - x;
+    if (y + h > _band_y1) h = _band_y1 - y;
+    if (w <= 0 || h <= 0) return;
+    uint16_t swapped = __builtin_bswap16(color);
+    for (int16_t row = 0 ; row < h ; row++)
+    {
+        uint16_t* dst = &_buffer[(y - _band_y0 + row) * WIDTH + x];
+        for (int16_t i = 0 ; i < w ; i++) dst[i] = swapped;
+    }
+}
+
+void BandCanvas::fillScreen(uint16_t color)
+{
+    fillRect(0, _band_y0, WIDTH, _band_y1 - _band_y0, color);
+}
@@ -0,0 +1,47 @@
+#ifndef BAND_CANVAS_H
+#define BAND_CANVAS_H
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+
+/**
+ * @brief Horizontal slice of the screen in RAM (big-endian RGB565).
+ * It answers to full screen coordinates, but only keeps the rows of the
+ * current band, so a scene can be composed in pieces with little memory.
+ * The buffer is given by the caller (see DisplayHandler::acquireBand()).
+ */
+class BandCanvas : public Adafruit_GFX {
+
+    public:
+
+        /**
+         * @brief Constructor.
+         * @param w Screen width in pixels.
+         * @param h Screen height in pixels.
+         */
+        BandCanvas(int16_t w, int16_t h);
+
+        /**
+         * @brief Selects the rows this canvas represents.
+         * @param buffer Memory for w * lines pixels.
+         * @param y First screen row of the band.
+         * @param lines Number of rows.
+         */
+        void setBand(uint16_t* buffer, int16_t y, int16_t lines);
+
+        // --- Adafruit GFX rasterization hooks ---
+        void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+        void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+        void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+        void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+        void fillScreen(uint16_t color) override;
+
+    private:
+
+        uint16_t* _buffer;
+        int16_t _band_y0;
+        int16_t _band_y1;   // First row AFTER the band
+
+};
+
+#endif
@@ -6,6 +6,27 @@ CameraHandler::CameraHandler()
     _sensor = NULL;
     _current_mode = MODE_STREAMING;
     _is_initialized = false;
+    portMUX_INITIALIZE(&_lease_mux);
+    for (uint8_t i = 0 ; i < FRAME_LEASES ; i++)
+    {
+        _leases[i].fb = NULL;
+        _leases[i].refs = 0;
+        _leases[i].owner = this;
+    }
+    _published = 0;
+    for (uint8_t i = 0 ; i < FRAME_SUBSCRIBERS ; i++) _subscribers[i] = NULL;
+    _subscribers_lock = NULL;
+    _capture_enabled = false;
+    _capture_running = false;
+    _capture_fps = 0;
+    _capture_core = 0;
+    _fb_count = 1;
+    _buffer_format = PIXFORMAT_JPEG;
+    _buffer_size = FRAMESIZE_QVGA;
+    _stale_frames = 0;
+    memset(&_last_switch, 0, sizeof(_last_switch));
+    _switching = false;
+    _grabbing = 0;
 }
 
 // Initialize the Camera
@@ -38,27 +59,8 @@ bool CameraHandler::init(Camera_Mode mode)
     // Basic camera hardware configuration
     config.xclk_freq_hz = 20000000;
     // Specific camera hardware configuration by mode
-    switch (mode) {
-        case MODE_AI:
-            config.pixel_format = PIXFORMAT_RGB565;
-            config.frame_size = FRAMESIZE_QVGA;
-            break;
-        case MODE_GRAYSCALE:
-            config.pixel_format = PIXFORMAT_GRAYSCALE;
-            config.frame_size = FRAMESIZE_QVGA;
-            break;
-        case MODE_HIGH_RES:
-            config.pixel_format = PIXFORMAT_JPEG;
-            config.frame_size = FRAMESIZE_UXGA;
-            config.jpeg_quality = 10;
-            break;
-        case MODE_STREAMING:
-        default:
-            config.pixel_format = PIXFORMAT_JPEG;
-            config.frame_size = FRAMESIZE_QVGA;
-            config.jpeg_quality = 12;
-            break;
-    }
+    _modeFormat(mode, config.pixel_format, config.frame_size);
+    config.jpeg_quality = (mode == MODE_HIGH_RES) ? 10 : 12;
     if (psramFound())
     {
         config.fb_location = CAMERA_FB_IN_PSRAM;
@@ -69,6 +71,10 @@ bool CameraHandler::init(Camera_Mode mode)
         config.fb_count = 1;
         config.grab_mode = CAMERA_GRAB_WHEN_EMPTY;
     }
+    _fb_count = config.fb_count;
+    _buffer_format = config.pixel_format;
+    _buffer_size = config.frame_size;
+    if (!_subscribers_lock) _subscribers_lock = xSemaphoreCreateMutex();
     // Camera initialization
     if (esp_camera_init(&config) != ESP_OK) return false;
     // Sensor initialization
@@ -90,8 +96,11 @@ bool CameraHandler::isInitialized()
 // Get a frame (a picture)
 camera_fb_t *CameraHandler::getFrame()
 {
-    if (!_is_initialized || _sensor == NULL) return nullptr;
+    if (!_is_initialized || _sensor == NULL || !_beginGrab()) return nullptr;
+    _dropLatest();
+    _skipStaleFrames();
     camera_fb_t *fb = esp_camera_fb_get();
+    _endGrab();
     return fb;
 }
 
@@ -102,13 +111,196 @@ void CameraHandler::releaseFrame(camera_fb_t *fb)
     esp_camera_fb_return(fb);
 }
 
-// Change the image mode
-void CameraHandler::setMode(CameraHandler::Camera_Mode mode)
+// Get a new frame shared by every copy of the handle (nothing to release)
+FrameRef CameraHandler::captureFrame()
 {
-    if (_is_initialized) return;
-    if (_current_mode == mode) return;
-    _current_mode = mode;
-    _configureCameraByMode();
+    // Mode change in progress: no frame, after a pause so polling loops don't spin
+    if (_switching)
+    {
+        vTaskDelay(pdMS_TO_TICKS(CAMERA_SWITCH_WAIT_MS));
+        return FrameRef();
+    }
+    if (!_is_initialized || _sensor == NULL) return FrameRef();
+    // The capture task owns the sensor: its next frame is shared
+    if (_capture_running)
+    {
+        FrameRef frame = _nextPublished();
+        if (frame || _capture_running) return frame;
+        // Stopped meanwhile: the sensor is free again
+    }
+    // Without PSRAM the driver has one buffer: the kept frame must go back first
+    _dropLatest();
+    FrameRef frame = _grabFrame();
+    if (frame) _keepLatest(frame);
+    return frame;
+}
+
+// Get the last frame captured if it is younger than max_age_ms, a new one otherwise
+FrameRef CameraHandler::latestFrame(uint32_t max_age_ms)
+{
+    if (max_age_ms > 0)
+    {
+        FrameRef frame;
+        portENTER_CRITICAL(&_lease_mux);
+        frame._lease = _latest._lease;
+        if (frame._lease) frame._lease->refs.fetch_add(1);
+        portEXIT_CRITICAL(&_lease_mux);
+        if (frame && frame.age() <= max_age_ms) return frame;
+    }
+    return captureFrame();
+}
+
+// Change the image mode, also while running (the buffers are only reallocated if they change)
+bool CameraHandler::setMode(CameraHandler::Camera_Mode mode)
+{
+    // Before init() the mode is only stored
+    if (!_is_initialized)
+    {
+        _current_mode = mode;
+        return true;
+    }
+    if (_current_mode == mode) return true;
+    // Other tasks get no frame until the switch ends (one switch at a time)
+    portENTER_CRITICAL(&_lease_mux);
+    bool busy = _switching;
+    _switching = true;
+    portEXIT_CRITICAL(&_lease_mux);
+    if (busy) return false;
+    unsigned long start = micros();
+    memset(&_last_switch, 0, sizeof(_last_switch));
+    // The capture task is paused while the sensor changes
+    bool capturing = _capture_running;
+    if (capturing) stopCapture();
+    // A grab started before the flag may still be waiting for the driver
+    if (!_waitGrabs())
+    {
+        _switching = false;
+        if (capturing) startCapture(_capture_core);
+        return false;
+    }
+    _invalidateFrames();
+    _stale_frames = 0;
+    pixformat_t format;
+    framesize_t size;
+    _modeFormat(mode, format, size);
+    // JPEG frames have variable length: a smaller size fits in the buffers of a bigger one.
+    // Raw frames fill the whole buffer, any other change needs new buffers.
+    bool live = (format == PIXFORMAT_JPEG && _buffer_format == PIXFORMAT_JPEG && size <= _buffer_size);
+    bool ok = true;
+    if (live)
+    {
+        _current_mode = mode;
+        _configureCameraByMode();
+    }
+    else ok = _restart(mode);
+    unsigned long configured = micros();
+    // Frames already in the driver have the old format or size: the first good one is kept
+    if (ok)
+    {
+        int width = getWidth();
+        for (uint8_t i = 0 ; i < CAMERA_FLUSH_FRAMES ; i++)
+        {
+            FrameRef frame = _takeFrame();
+            if (!frame) break;
+            if (frame.format() == format && frame.width() == width)
+            {
+                _keepLatest(frame);
+                break;
+            }
+            _last_switch.flushed++;
+        }
+    }
+    unsigned long end = micros();
+    _last_switch.reconfigure_us = configured - start;
+    _last_switch.flush_us = end - configured;
+    _last_switch.total_us = end - start;
+    _last_switch.reallocated = ok && !live;
+    _last_switch.ok = ok;
+    _switching = false;
+    if (capturing) startCapture(_capture_core);
+    return ok;
+}
+
+// Get the timing of the last mode change
+CameraModeSwitch CameraHandler::getModeSwitchStats()
+{
+    return _last_switch;
+}
+
+// Start the task that reads the sensor and feeds every subscriber (captureFrame() waits for it)
+bool CameraHandler::startCapture(uint8_t core)
+{
+    if (!_is_initialized || !_subscribers_lock) return false;
+    _capture_core = core;
+    // The task may still be alive if it was just stopped: it simply goes on
+    portENTER_CRITICAL(&_lease_mux);
+    _capture_enabled = true;
+    bool start = !_capture_running;
+    _capture_running = true;
+    portEXIT_CRITICAL(&_lease_mux);
+    if (!start) return true;
+    if (xTaskCreatePinnedToCore(_captureTask, "orbito_capture", CAPTURE_STACK, this, CAPTURE_PRIORITY, NULL, core) == pdPASS) return true;
+    _capture_enabled = _capture_running = false;
+    return false;
+}
+
+// Stop the capture task (subscribers go back to capturing on demand)
+void CameraHandler::stopCapture()
+{
+    if (!_subscribers_lock) return;
+    _capture_enabled = false;
+    // The task ends after its current frame
+    unsigned long start = millis();
+    while (_capture_running && millis() - start < CAPTURE_WAIT_MS) vTaskDelay(pdMS_TO_TICKS(5));
+    // Consumers blocked in wait() capture by themselves from now on
+    if (xSemaphoreTake(_subscribers_lock, portMAX_DELAY) != pdTRUE) return;
+    for (uint8_t i = 0 ; i < FRAME_SUBSCRIBERS ; i++)
+        if (_subscribers[i]) _subscribers[i]->_wake();
+    xSemaphoreGive(_subscribers_lock);
+}
+
+// Get the capture task status
+bool CameraHandler::isCapturing()
+{
+    return _capture_running;
+}
+
+// Get the frames per second read by the capture task
+float CameraHandler::getCaptureFps()
+{
+    return _capture_running ? _capture_fps : 0;
+}
+
+// Register a mailbox for the published frames (0 fps = no limit, every_nth 1 = all)
+bool CameraHandler::subscribe(FrameSubscriber& subscriber, uint8_t max_fps, uint8_t every_nth)
+{
+    if (!_subscribers_lock) return false;
+    if (subscriber._camera && subscriber._camera != this) subscriber._camera->unsubscribe(subscriber);
+    if (xSemaphoreTake(_subscribers_lock, portMAX_DELAY) != pdTRUE) return false;
+    int8_t slot = -1;
+    for (uint8_t i = 0 ; i < FRAME_SUBSCRIBERS ; i++)
+    {
+        if (_subscribers[i] == &subscriber) slot = i;
+        else if (!_subscribers[i] && slot < 0) slot = i;
+    }
+    bool done = (slot >= 0) && subscriber._attach(this, max_fps, every_nth);
+    if (done) _subscribers[slot] = &subscriber;
+    xSemaphoreGive(_subscribers_lock);
+    return done;
+}
+
+// Remove a mailbox (its unread frame is dropped)
+void CameraHandler::unsubscribe(FrameSubscriber& subscriber)
+{
+    if (subscriber._camera != this) return;
+    // Once the lock is ours the task is not writing into the mailbox
+    if (xSemaphoreTake(_subscribers_lock, portMAX_DELAY) != pdTRUE) return;
+    for (uint8_t i = 0 ; i < FRAME_SUBSCRIBERS ; i++)
+        if (_subscribers[i] == &subscriber) _subscribers[i] = NULL;
+    subscriber._camera = NULL;
+    subscriber._withdraw();
+    subscriber._wake();
+    xSemaphoreGive(_subscribers_lock);
 }
 
 // Configure the image resolution
@@ -116,6 +308,7 @@ void CameraHandler::setResolution(framesize_t size)
 {
     if (!_sensor) return;
     _sensor->set_framesize(_sensor, size);
+    _invalidateFrames();
 }
 
 // Configure the image quality
@@ -123,6 +316,7 @@ void CameraHandler::setQuality(int quality)
 {
     if (!_sensor) return;
     _sensor->set_quality(_sensor, quality);
+    _invalidateFrames();
 }
 
 // Configure the Vertical Image Flip
@@ -130,6 +324,7 @@ void CameraHandler::setVFlip(bool enable)
 {
     if (!_sensor) return;
     _sensor->set_vflip(_sensor, enable);
+    _invalidateFrames();
 }
 
 // Configure the Horizontal Image Mirror
@@ -137,6 +332,7 @@ void CameraHandler::setHMirror(bool enable)
 {
     if (!_sensor) return;
     _sensor->set_hmirror(_sensor, enable);
+    _invalidateFrames();
 }
 
 // Configure the image Brightness
@@ -144,6 +340,7 @@ void CameraHandler::setBrightness(int level)
 {
     if (!_sensor) return;
     _sensor->set_brightness(_sensor, level);
+    _invalidateFrames();
 }
 
 // Configure the image saturation
@@ -151,6 +348,7 @@ void CameraHandler::setSaturation(int level)
 {
     if (!_sensor) return;
     _sensor->set_saturation(_sensor, level);
+    _invalidateFrames();
 }
 
 // Configure the image contrast
@@ -158,6 +356,7 @@ void CameraHandler::setContrast(int level)
 {
     if (!_sensor) return;
     _sensor->set_contrast(_sensor, level);
+    _invalidateFrames();
 }
 
 // Configure the image White Balance
@@ -167,6 +366,7 @@ void CameraHandler::setWhiteBalance(bool enable, int mode)
     _sensor->set_whitebal(_sensor, enable ? 1 : 0);
     _sensor->set_awb_gain(_sensor, enable ? 1 : 0);
     if (enable) _sensor->set_wb_mode(_sensor, mode);
+    _invalidateFrames();
 }
 
 // Configure the image exposure control
@@ -177,6 +377,7 @@ void CameraHandler::setExposureControl(bool enable, int dsp_level)
     _sensor->set_aec2(_sensor, enable ? 1 : 0);
     if (enable && dsp_level >= -2 && dsp_level <= 2)
         _sensor->set_ae_level(_sensor, dsp_level);
+    _invalidateFrames();
 }
 
 // Configure the gain ceiling
@@ -184,6 +385,7 @@ void CameraHandler::setGainCeiling(gainceiling_t gain)
 {
     if (!_sensor) return;
     _sensor->set_gainceiling(_sensor, gain);
+    _invalidateFrames();
 }
 
 // Get last frame width
@@ -242,6 +444,7 @@ void CameraHandler::setSpecialEffect(Special_Effect effect)
 {
     if (!_sensor) return;
     _sensor->set_special_effect(_sensor, (int)effect);
+    _invalidateFrames();
 }
 
 // Test mode tool
@@ -249,6 +452,7 @@ void CameraHandler::setColorBar(bool enable)
 {
     if (!_sensor) return;
     _sensor->set_colorbar(_sensor, enable ? 1 : 0);
+    _invalidateFrames();
 }
 
 // Image converter tool
@@ -258,6 +462,179 @@ bool CameraHandler::convertFrameToJpeg(camera_fb_t* original, uint8_t **out_buf,
     return frame2jpg(original, 80, out_buf, out_len);
 }
 
+// Image converter tool, the JPEG is handed to out in pieces (no buffer for the whole image)
+bool CameraHandler::convertFrameToJpeg(camera_fb_t* original, jpg_out_cb out, void* arg)
+{
+    if (original == NULL || out == NULL) return false;
+    return frame2jpg_cb(original, 80, out, arg);
+}
+
+// Take a buffer from the driver into a lease (nothing during a mode change)
+FrameRef CameraHandler::_grabFrame()
+{
+    if (!_beginGrab()) return FrameRef();
+    FrameRef frame = _takeFrame();
+    _endGrab();
+    return frame;
+}
+
+// Same without the mode change check (used by setMode() itself)
+FrameRef CameraHandler::_takeFrame()
+{
+    _skipStaleFrames();
+    camera_fb_t* fb = esp_camera_fb_get();
+    if (!fb) return FrameRef();
+    FrameLease* lease = NULL;
+    portENTER_CRITICAL(&_lease_mux);
+    for (uint8_t i = 0 ; i < FRAME_LEASES && !lease ; i++)
+    {
+        if (_leases[i].fb) continue;
+        lease = &_leases[i];
+        lease->fb = fb;
+    }
+    portEXIT_CRITICAL(&_lease_mux);
+    if (!lease)
+    {
+        esp_camera_fb_return(fb);
+        return FrameRef();
+    }
+    lease->captured_ms = millis();
+    lease->refs.store(1);
+    return FrameRef(lease);
+}
+
+// Mark a grab in progress, false during a mode change
+bool CameraHandler::_beginGrab()
+{
+    portENTER_CRITICAL(&_lease_mux);
+    bool allowed = !_switching;
+    if (allowed) _grabbing++;
+    portEXIT_CRITICAL(&_lease_mux);
+    return allowed;
+}
+
+void CameraHandler::_endGrab()
+{
+    portENTER_CRITICAL(&_lease_mux);
+    _grabbing--;
+    portEXIT_CRITICAL(&_lease_mux);
+}
+
+// Wait until the grabs of other tasks are done
+bool CameraHandler::_waitGrabs()
+{
+    unsigned long start = millis();
+    while (_grabbing > 0)
+    {
+        if (millis() - start >= CAPTURE_WAIT_MS) return false;
+        vTaskDelay(pdMS_TO_TICKS(5));
+    }
+    return true;
+}
+
+// Keep a frame for latestFrame()
+void CameraHandler::_keepLatest(const FrameRef& frame)
+{
+    FrameRef previous(frame);
+    portENTER_CRITICAL(&_lease_mux);
+    std::swap(previous._lease, _latest._lease);
+    _published++;
+    portEXIT_CRITICAL(&_lease_mux);
+    // The frame kept before is dropped out of the lock
+}
+
+// Wait for the next frame kept by the capture task
+FrameRef CameraHandler::_nextPublished()
+{
+    uint32_t seen = _published;
+    unsigned long start = millis();
+    while (_capture_running && millis() - start < CAPTURE_WAIT_MS)
+    {
+        if (_published != seen)
+        {
+            FrameRef frame;
+            portENTER_CRITICAL(&_lease_mux);
+            frame._lease = _latest._lease;
+            if (frame._lease) frame._lease->refs.fetch_add(1);
+            portEXIT_CRITICAL(&_lease_mux);
+            if (frame) return frame;
+            seen = _published;
+        }
+        vTaskDelay(1);
+    }
+    return FrameRef();
+}
+
+// Stop keeping the last frame (the driver may need its buffer)
+void CameraHandler::_dropLatest()
+{
+    FrameRef previous;
+    portENTER_CRITICAL(&_lease_mux);
+    std::swap(previous._lease, _latest._lease);
+    portEXIT_CRITICAL(&_lease_mux);
+    // Returned here if nobody else is using it
+}
+
+// Give a buffer back to the driver (called by the last FrameRef)
+void CameraHandler::_returnLease(FrameLease* lease)
+{
+    esp_camera_fb_return(lease->fb);
+    portENTER_CRITICAL(&_lease_mux);
+    lease->fb = NULL;
+    portEXIT_CRITICAL(&_lease_mux);
+}
+
+// Capture task loop
+void CameraHandler::_captureTask(void* param)
+{
+    CameraHandler* camera = (CameraHandler*)param;
+    unsigned long fps_start = millis();
+    uint16_t frames = 0;
+    for (;;)
+    {
+        portENTER_CRITICAL(&camera->_lease_mux);
+        bool stop = !camera->_capture_enabled;
+        if (stop) camera->_capture_running = false;
+        portEXIT_CRITICAL(&camera->_lease_mux);
+        if (stop) break;
+        // If the frames held take every driver buffer the sensor stalls: the kept
+        // one goes back first, then the unread ones in the mailboxes (dropped)
+        if (camera->_leasesOut() >= camera->_fb_count) camera->_dropLatest();
+        if (camera->_leasesOut() >= camera->_fb_count)
+        {
+            xSemaphoreTake(camera->_subscribers_lock, portMAX_DELAY);
+            for (uint8_t i = 0 ; i < FRAME_SUBSCRIBERS ; i++)
+                if (camera->_subscribers[i]) camera->_subscribers[i]->_reclaim();
+            xSemaphoreGive(camera->_subscribers_lock);
+        }
+        FrameRef frame = camera->_grabFrame();
+        if (!frame)
+        {
+            vTaskDelay(pdMS_TO_TICKS(20));
+            continue;
+        }
+        camera->_keepLatest(frame);
+        // Fan-out: each mailbox is replaced without waiting for its consumer
+        unsigned long now = millis();
+        xSemaphoreTake(camera->_subscribers_lock, portMAX_DELAY);
+        for (uint8_t i = 0 ; i < FRAME_SUBSCRIBERS ; i++)
+        {
+            FrameSubscriber* subscriber = camera->_subscribers[i];
+            if (subscriber && subscriber->_accepts(now)) subscriber->_offer(frame);
+        }
+        xSemaphoreGive(camera->_subscribers_lock);
+        frame.reset();
+        frames++;
+        if (now - fps_start >= 1000)
+        {
+            camera->_capture_fps = frames * 1000.0f / (now - fps_start);
+            frames = 0;
+            fps_start = now;
+        }
+    }
+    vTaskDelete(NULL);
+}
+
 // Apply OV3660 configuration corrections
 void CameraHandler::_applySensorSettings()
 {
@@ -277,7 +654,6 @@ void CameraHandler::_applySensorSettings()
 void CameraHandler::_configureCameraByMode()
 {
     if (!_sensor) return;
-    delay(50);
     switch (_current_mode)
     {
         case MODE_AI: // Configuration to look for stability (better for TinyML)
@@ -300,5 +676,121 @@ void CameraHandler::_configureCameraByMode()
             _sensor->set_quality(_sensor, 12);
             break;
     }
-    delay(100);
+}
+
+// Pixel format and frame size of a mode
+void CameraHandler::_modeFormat(Camera_Mode mode, pixformat_t& format, framesize_t& size)
+{
+    switch (mode)
+    {
+        case MODE_AI:
+            format = PIXFORMAT_RGB565;
+            size = FRAMESIZE_QVGA;
+            break;
+        case MODE_GRAYSCALE:
+            format = PIXFORMAT_GRAYSCALE;
+            size = FRAMESIZE_QVGA;
+            break;
+        case MODE_HIGH_RES:
+            format = PIXFORMAT_JPEG;
+            size = FRAMESIZE_UXGA;
+            break;
+        case MODE_STREAMING:
+        default:
+            format = PIXFORMAT_JPEG;
+            size = FRAMESIZE_QVGA;
+            break;
+    }
+}
+
+// Restart the driver in a new mode keeping the user settings
+bool CameraHandler::_restart(Camera_Mode mode)
+{
+    // The old buffers are freed: no frame may still point to them
+    if (!_waitLeases()) return false;
+    Camera_Mode old_mode = _current_mode;
+    camera_status_t status = _sensor->status;
+    esp_camera_deinit();
+    _is_initialized = false;
+    _sensor = NULL;
+    bool ok = init(mode);
+    // Not enough memory for the new buffers: back to the old mode
+    if (!ok) init(old_mode);
+    if (_sensor) _restoreSensorSettings(status);
+    return ok;
+}
+
+// Put back the user settings after a restart
+void CameraHandler::_restoreSensorSettings(const camera_status_t& status)
+{
+    _sensor->set_brightness(_sensor, status.brightness);
+    _sensor->set_contrast(_sensor, status.contrast);
+    _sensor->set_saturation(_sensor, status.saturation);
+    _sensor->set_special_effect(_sensor, status.special_effect);
+    _sensor->set_whitebal(_sensor, status.awb);
+    _sensor->set_awb_gain(_sensor, status.awb_gain);
+    _sensor->set_wb_mode(_sensor, status.wb_mode);
+    _sensor->set_exposure_ctrl(_sensor, status.aec);
+    _sensor->set_aec2(_sensor, status.aec2);
+    _sensor->set_ae_level(_sensor, status.ae_level);
+    _sensor->set_gain_ctrl(_sensor, status.agc);
+    _sensor->set_gainceiling(_sensor, (gainceiling_t)status.gainceiling);
+    _sensor->set_vflip(_sensor, status.vflip);
+    _sensor->set_hmirror(_sensor, status.hmirror);
+    _sensor->set_colorbar(_sensor, status.colorbar);
+}
+
+// Number of driver buffers held by frames
+uint8_t CameraHandler::_leasesOut()
+{
+    uint8_t out = 0;
+    portENTER_CRITICAL(&_lease_mux);
+    for (uint8_t i = 0 ; i < FRAME_LEASES ; i++)
+        if (_leases[i].fb) out++;
+    portEXIT_CRITICAL(&_lease_mux);
+    return out;
+}
+
+// Wait until every shared frame is back in the driver
+bool CameraHandler::_waitLeases()
+{
+    unsigned long start = millis();
+    for (;;)
+    {
+        if (_leasesOut() == 0) return true;
+        if (millis() - start >= CAPTURE_WAIT_MS) return false;
+        vTaskDelay(pdMS_TO_TICKS(5));
+    }
+}
+
+// Forget the frames taken with the old settings (kept, in mailboxes and in the driver)
+void CameraHandler::_invalidateFrames()
+{
+    _dropLatest();
+    if (_subscribers_lock && xSemaphoreTake(_subscribers_lock, portMAX_DELAY) == pdTRUE)
+    {
+        for (uint8_t i = 0 ; i < FRAME_SUBSCRIBERS ; i++)
+            if (_subscribers[i]) _subscribers[i]->_withdraw();
+        xSemaphoreGive(_subscribers_lock);
+    }
+    // The driver buffers and the frame being exposed were taken before the change
+    portENTER_CRITICAL(&_lease_mux);
+    _stale_frames = _fb_count + 1;
+    portEXIT_CRITICAL(&_lease_mux);
+}
+
+// Discard the frames of the driver marked as stale
+void CameraHandler::_skipStaleFrames()
+{
+    for (;;)
+    {
+        portENTER_CRITICAL(&_lease_mux);
+        bool stale = (_stale_frames > 0);
+        if (stale) _stale_frames--;
+        portEXIT_CRITICAL(&_lease_mux);
+        if (!stale) return;
+        camera_fb_t* fb = esp_camera_fb_get();
+        if (!fb) return;
+        esp_camera_fb_return(fb);
+    }
 }
@@ -3,8 +3,29 @@
 
 #include "esp_camera.h"
 #include "CameraPins.h"
+#include "FrameRef.h"
+#include "FrameSubscriber.h"
 #include <Arduino.h>
 
+// Capture task: priority, stack and longest wait for a published frame
+#define CAPTURE_PRIORITY 2
+#define CAPTURE_STACK    4096
+#define CAPTURE_WAIT_MS  1000
+// Frames read at most after a mode change until one has the new format and size
+#define CAMERA_FLUSH_FRAMES 4
+// Pause of a capture asked during a mode change (it gets no frame)
+#define CAMERA_SWITCH_WAIT_MS 10
+
+// Timing of the last CameraHandler::setMode()
+struct CameraModeSwitch {
+    uint32_t total_us;          // Whole call, from the old mode to the first frame of the new one
+    uint32_t reconfigure_us;    // Sensor registers (or driver restart)
+    uint32_t flush_us;          // Frames discarded until the first good one
+    uint8_t flushed;            // Number of frames discarded
+    bool reallocated;           // The driver was restarted with new frame buffers
+    bool ok;                    // False if the mode could not be applied (the old one is kept)
+};
+
 class CameraHandler {
 
     public:
@@ -38,8 +59,27 @@ class CameraHandler {
         camera_fb_t* getFrame();
         // Free the RAM from the last frame
         void releaseFrame(camera_fb_t* fb);
-        // Change the image mode
-        void setMode(Camera_Mode mode);
+        // Get a new frame shared by every copy of the handle (nothing to release)
+        FrameRef captureFrame();
+        // Get the last frame captured if it is younger than max_age_ms, a new one otherwise
+        FrameRef latestFrame(uint32_t max_age_ms);
+        // Change the image mode, also while running (the buffers are only reallocated if they change)
+        bool setMode(Camera_Mode mode);
+        // Get the timing of the last mode change
+        CameraModeSwitch getModeSwitchStats();
+
+        // Start the task that reads the sensor and feeds every subscriber (captureFrame() waits for it)
+        bool startCapture(uint8_t core = 0);
+        // Stop the capture task (subscribers go back to capturing on demand)
+        void stopCapture();
+        // Get the capture task status
+        bool isCapturing();
+        // Get the frames per second read by the capture task
+        float getCaptureFps();
+        // Register a mailbox for the published frames (0 fps = no limit, every_nth 1 = all)
+        bool subscribe(FrameSubscriber& subscriber, uint8_t max_fps = 0, uint8_t every_nth = 1);
+        // Remove a mailbox (its unread frame is dropped)
+        void unsubscribe(FrameSubscriber& subscriber);
 
         // Configure the image resolution
         void setResolution(framesize_t size);
@@ -77,6 +117,8 @@ class CameraHandler {
         void setColorBar(bool enable);
         // Image converter tool
         bool convertFrameToJpeg(camera_fb_t* original, uint8_t** out_buf, size_t* out_len);
+        // Image converter tool, the JPEG is handed to out in pieces (no buffer for the whole image)
+        bool convertFrameToJpeg(camera_fb_t* original, jpg_out_cb out, void* arg);
 
     private:
 
@@ -84,10 +126,70 @@ class CameraHandler {
         Camera_Mode _current_mode;
         sensor_t* _sensor;
 
+        // Shared frames: buffers out of the driver, last one captured and their lock
+        FrameLease _leases[FRAME_LEASES];
+        FrameRef _latest;
+        portMUX_TYPE _lease_mux;
+        uint32_t _published;                // Frames kept in _latest so far
+
+        // Capture task: subscribers (the task holds the lock while it feeds them) and state
+        FrameSubscriber* _subscribers[FRAME_SUBSCRIBERS];
+        SemaphoreHandle_t _subscribers_lock;
+        volatile bool _capture_enabled;
+        volatile bool _capture_running;
+        float _capture_fps;
+        uint8_t _capture_core;
+        uint8_t _fb_count;
+
+        // Layout of the driver buffers (set on init) and frames to discard after a setting change
+        pixformat_t _buffer_format;
+        framesize_t _buffer_size;
+        uint8_t _stale_frames;
+        CameraModeSwitch _last_switch;
+
+        // Mode change in progress (no grabs but its own) and grabs running on other tasks
+        volatile bool _switching;
+        volatile uint8_t _grabbing;
+
         // Apply OV3660 configuration corrections
         void _applySensorSettings();
         // Apply specific configuration by mode selected
         void _configureCameraByMode();
+        // Pixel format and frame size of a mode
+        static void _modeFormat(Camera_Mode mode, pixformat_t& format, framesize_t& size);
+        // Restart the driver in a new mode keeping the user settings
+        bool _restart(Camera_Mode mode);
+        // Put back the user settings after a restart
+        void _restoreSensorSettings(const camera_status_t& status);
+        // Number of driver buffers held by frames
+        uint8_t _leasesOut();
+        // Wait until every shared frame is back in the driver
+        bool _waitLeases();
+        // Forget the frames taken with the old settings (kept, in mailboxes and in the driver)
+        void _invalidateFrames();
+        // Discard the frames of the driver marked as stale
+        void _skipStaleFrames();
+        // Take a buffer from the driver into a lease (nothing during a mode change)
+        FrameRef _grabFrame();
+        // Same without the mode change check (used by setMode() itself)
+        FrameRef _takeFrame();
+        // Mark a grab in progress, false during a mode change
+        bool _beginGrab();
+        void _endGrab();
+        // Wait until the grabs of other tasks are done
+        bool _waitGrabs();
+        // Keep a frame for latestFrame()
+        void _keepLatest(const FrameRef& frame);
+        // Wait for the next frame kept by the capture task
+        FrameRef _nextPublished();
+        // Stop keeping the last frame (the driver may need its buffer)
+        void _dropLatest();
+        // Capture task loop
+        static void _captureTask(void* param);
+        // Give a buffer back to the driver (called by the last FrameRef)
+        void _returnLease(FrameLease* lease);
+
+        friend class FrameRef;
 
 };
 
@@ -1,5 +1,68 @@
 #include "DisplayHandler.h"
 
+// Copies n pixels swapping the two bytes of each, two pixels per 32-bit word
+static void _swapCopy16(uint16_t* dst, const uint16_t* src, int32_t n)
+{
+    // Word access needs both pointers aligned to 4 bytes
+    if (((uintptr_t)dst & 3) == 0 && ((uintptr_t)src & 3) == 0)
+    {
+        uint32_t* d = (uint32_t*)dst;
+        const uint32_t* s = (const uint32_t*)src;
+        for (int32_t i = 0 ; i < n / 2 ; i++)
+        {
+            uint32_t v = s[i];
+            d[i] = ((v & 0x00FF00FF) << 8) | ((v >> 8) & 0x00FF00FF);
+        }
+        if (n & 1) dst[n - 1] = __builtin_bswap16(src[n - 1]);
+        return;
+    }
+    for (int32_t i = 0 ; i < n ; i++) dst[i] = __builtin_bswap16(src[i]);
+}
+
+// Converts one source row to panel order (big-endian RGB565).
+// x_step is the 16.16 source advance per destination pixel.
+static void _convertRow(uint16_t* dst, const uint8_t* src, int16_t count, uint32_t x_step, ImageFormat format)
+{
+    // Same size: plain copy (no conversion at all for camera frames)
+    if (x_step == 0x10000)
+    {
+        switch (format)
+        {
+            case IMAGE_RGB565_BE:
+                memcpy(dst, src, count * sizeof(uint16_t));
+                break;
+            case IMAGE_RGB565:
+                _swapCopy16(dst, (const uint16_t*)src, count);
+                break;
+            case IMAGE_GRAY8:
+                for (int16_t i = 0 ; i < count ; i++)
+                {
+                    uint8_t g = src[i];
+                    dst[i] = __builtin_bswap16(((g >> 3) << 11) | ((g >> 2) << 5) | (g >> 3));
+                }
+                break;
+        }
+        return;
+    }
+    uint32_t acc = x_step >> 1;    // Sample the center of each source pixel
+    switch (format)
+    {
+        case IMAGE_RGB565_BE:
+            for (int16_t i = 0 ; i < count ; i++, acc += x_step) dst[i] = ((const uint16_t*)src)[acc >> 16];
+            break;
+        case IMAGE_RGB565:
+            for (int16_t i = 0 ; i < count ; i++, acc += x_step) dst[i] = __builtin_bswap16(((const uint16_t*)src)[acc >> 16]);
+            break;
+        case IMAGE_GRAY8:
+            for (int16_t i = 0 ; i < count ; i++, acc += x_step)
+            {
+                uint8_t g = src[acc >> 16];
+                dst[i] = __builtin_bswap16(((g >> 3) << 11) | ((g >> 2) << 5) | (g >> 3));
+            }
+            break;
+    }
+}
+
 /**
  * @brief Constructor
  * @param spi_bus Pointer to the shared SPI bus.
@@ -17,13 +80,17 @@ void DisplayHandler::begin()
 {
     // Initialize mutex
     SPIHandler::begin();
+    if (_canvas_lock == NULL)
+        _canvas_lock = xSemaphoreCreateMutex();
+    if (_screen_lock == NULL)
+        _screen_lock = xSemaphoreCreateRecursiveMutex();
     // Initialize the Display
-    xSemaphoreTake(_safety_block_spi, portMAX_DELAY);
+    _lockBus();
     _tft->init(TFT_WIDTH, TFT_HEIGHT);
     _tft->setRotation(TFT_ROTATION);
     _tft->fillScreen(ST77XX_BLACK);
     _tft->invertDisplay(false);
-    xSemaphoreGive(_safety_block_spi);
+    _unlockBus();
 }
 
 /**
@@ -33,9 +100,967 @@ void DisplayHandler::begin()
  */
 void DisplayHandler::draw(std::function<void(Adafruit_ST7789&)> drawCallback)
 {
-    xSemaphoreTake(_safety_block_spi, portMAX_DELAY);
+    DisplayLock guard(*this);
+    _generation++;
+    _leaveConsole();
+    ORBITO_STAT(_statAdd(_stats.primitives, 1));
+    _lockBus();
     drawCallback(*_tft);
-    xSemaphoreGive(_safety_block_spi);
+    _unlockBus();
+}
+
+/**
+ * @brief Execute drawing commands on the active surface: the off-screen
+ * canvas when it is enabled, the panel otherwise (same as draw()).
+ * @param drawCallback Lambda function with the instructions to draw.
+ */
+void DisplayHandler::render(std::function<void(Adafruit_GFX&)> drawCallback)
+{
+    DisplayLock guard(*this);
+    _generation++;
+    _leaveConsole();
+    ORBITO_STAT(_statAdd(_stats.primitives, 1));
+    xSemaphoreTake(_canvas_lock, portMAX_DELAY);
+    if (_canvas)
+    {
+        // Only RAM is touched, the bus stays free for the flash
+        drawCallback(*_canvas);
+        _canvas->commit();
+    } else {
+        _lockBus();
+        drawCallback(*_tft);
+        _unlockBus();
+    }
+    xSemaphoreGive(_canvas_lock);
+}
+
+/**
+ * @brief Executes a recorded command list on the active surface taking
+ * the bus only once (one lock and one SPI transaction for the whole list).
+ * @param list Commands to execute.
+ */
+void DisplayHandler::submit(const DrawList& list)
+{
+    DisplayLock guard(*this);
+    _generation++;
+    _leaveConsole();
+    if (list.size() == 0) return;
+    ORBITO_STAT(_statAdd(_stats.primitives, list.size()));
+    xSemaphoreTake(_canvas_lock, portMAX_DELAY);
+    if (_canvas)
+    {
+        // Commit each command so the dirty list keeps separate regions
+        for (uint16_t i = 0 ; i < list.size() ; i++)
+        {
+            list.execute(i, *_canvas);
+            _canvas->commit();
+        }
+    } else {
+        _lockBus();
+        list.replay(*_tft);
+        _unlockBus();
+    }
+    xSemaphoreGive(_canvas_lock);
+}
+
+/**
+ * @brief Composes a whole scene without flicker and without a framebuffer:
+ * the list is replayed once per horizontal band in RAM and every band is
+ * sent complete. In canvas mode it is the same as submit().
+ * @param scene Commands of the full frame (start it with fillScreen()).
+ * @param y First row to compose.
+ * @param h Rows to compose (-1 = down to the bottom).
+ */
+void DisplayHandler::renderScene(const DrawList& scene, int16_t y, int16_t h)
+{
+    DisplayLock guard(*this);
+    _generation++;
+    _leaveConsole();
+    // The canvas already holds the whole frame
+    if (_canvas)
+    {
+        submit(scene);
+        return;
+    }
+    int16_t width = _tft->width();
+    int16_t bottom = (h < 0) ? _tft->height() : min((int16_t)(y + h), _tft->height());
+    if (y < 0) y = 0;
+    BandCanvas band(width, _tft->height());
+    for (int16_t band_y = y ; band_y < bottom ; band_y += _band_lines)
+    {
+        int16_t lines = min((int16_t)_band_lines, (int16_t)(bottom - band_y));
+        uint16_t* pixels = acquireBand();
+        // No internal RAM for the bands: draw straight away (may flicker)
+        if (!pixels)
+        {
+            submit(scene);
+            return;
+        }
+        band.setBand(pixels, band_y, lines);
+        memset(pixels, 0, (size_t)width * lines * sizeof(uint16_t));
+        // Only the commands touching this band are executed
+        for (uint16_t i = 0 ; i < scene.size() ; i++)
+        {
+            int16_t row0, row1;
+            scene.getRows(i, row0, row1);
+            if (row1 < band_y || row0 >= band_y + lines) continue;
+            scene.execute(i, band);
+        }
+        // With the flush task running, the next band is drawn while this one is sent
+        pushBand(pixels, 0, band_y, width, lines);
+    }
+    ORBITO_STAT(_statAdd(_stats.primitives, scene.size()));
+    ORBITO_STAT(_statAdd(_stats.flushes, 1));
+}
+
+/**
+ * @brief Streams an image to the screen row by row, scaling it (nearest
+ * neighbour) if asked. The source is only read, never modified, and can be
+ * released as soon as this returns.
+ * @param pixels Source pixels (width * height).
+ * @param format Layout of the source pixels.
+ * @param fit Placement on the screen.
+ * @param bar_color Color of the letterbox bars.
+ */
+void DisplayHandler::drawImage(const uint8_t* pixels, uint16_t width, uint16_t height, ImageFormat format, ImageFit fit, uint16_t bar_color)
+{
+    DisplayLock guard(*this);
+    _generation++;
+    _leaveConsole();
+    if (!pixels || width == 0 || height == 0) return;
+    ORBITO_STAT(_statAdd(_stats.primitives, 1));
+    int16_t screen_w = _tft->width();
+    int16_t screen_h = _tft->height();
+    uint8_t bpp = (format == IMAGE_GRAY8) ? 1 : 2;
+    // Size on the screen
+    int32_t dw = width, dh = height;
+    if (fit == IMAGE_FIT_STRETCH)
+    {
+        dw = screen_w;
+        dh = screen_h;
+    } else if (fit == IMAGE_FIT_LETTERBOX) {
+        // Biggest size that fits, keeping the aspect ratio
+        if ((int32_t)screen_w * height <= (int32_t)screen_h * width)
+        {
+            dw = screen_w;
+            dh = (int32_t)height * screen_w / width;
+        } else {
+            dh = screen_h;
+            dw = (int32_t)width * screen_h / height;
+        }
+    }
+    if (dw <= 0 || dh <= 0) return;
+    uint32_t x_step = ((uint32_t)width << 16) / dw;
+    uint32_t y_step = ((uint32_t)height << 16) / dh;
+    // Centered, the part out of the screen is cropped
+    int32_t dx = (screen_w - dw) / 2;
+    int32_t dy = (screen_h - dh) / 2;
+    int32_t src_x0 = 0, src_y0 = 0;
+    if (dx < 0)
+    {
+        src_x0 = (int32_t)(((uint64_t)(-dx) * x_step) >> 16);
+        dw = screen_w;
+        dx = 0;
+    }
+    if (dy < 0)
+    {
+        src_y0 = (int32_t)(((uint64_t)(-dy) * y_step) >> 16);
+        dh = screen_h;
+        dy = 0;
+    }
+    // Letterbox bars (only where the image does not cover the screen)
+    if (fit == IMAGE_FIT_LETTERBOX) _fillBars(dx, dy, dw, dh, bar_color);
+    const uint8_t* origin = pixels + (src_y0 * width + src_x0) * bpp;
+    uint32_t y_acc = y_step >> 1;
+    // Canvas mode: rows are written straight into the frame in RAM
+    xSemaphoreTake(_canvas_lock, portMAX_DELAY);
+    if (_canvas)
+    {
+        uint16_t* frame = _canvas->getBuffer();
+        for (int32_t row = 0 ; row < dh ; row++, y_acc += y_step)
+            _convertRow(&frame[(dy + row) * screen_w + dx], origin + (y_acc >> 16) * width * bpp, dw, x_step, format);
+        _canvas->markDirty(dx, dy, dw, dh);
+        _canvas->commit();
+        xSemaphoreGive(_canvas_lock);
+        return;
+    }
+    xSemaphoreGive(_canvas_lock);
+    // Direct mode: rows are packed in the band buffers and streamed
+    int16_t band_rows = getBandSize() / dw;
+    if (band_rows > dh) band_rows = dh;
+    for (int32_t row = 0 ; row < dh ; row += band_rows)
+    {
+        int16_t rows = min((int32_t)band_rows, dh - row);
+        uint16_t* band = acquireBand();
+        if (!band) return;
+        for (int16_t i = 0 ; i < rows ; i++, y_acc += y_step)
+            _convertRow(&band[i * dw], origin + (y_acc >> 16) * width * bpp, dw, x_step, format);
+        pushBand(band, dx, dy + row, dw, rows);
+    }
+}
+
+/**
+ * @brief Decodes a JPEG straight to the screen, one MCU row at a time, without
+ * a full size RGB buffer. Big images are reduced by the decoder itself
+ * (1/2, 1/4 or 1/8) so only the pixels that will be shown are decoded.
+ * @param jpg JPEG file in memory.
+ * @param len Size in bytes.
+ * @param fit IMAGE_FIT_NONE decodes at full size (centered and cropped),
+ * any other value picks the biggest reduction that fits in the screen.
+ * @param bar_color Color of the letterbox bars.
+ * @return False if the data is not a valid JPEG.
+ */
+bool DisplayHandler::drawJpeg(const uint8_t* jpg, size_t len, ImageFit fit, uint16_t bar_color)
+{
+    DisplayLock guard(*this);
+    _generation++;
+    _leaveConsole();
+    uint16_t width, height;
+    if (!jpg || !_jpegSize(jpg, len, width, height)) return false;
+    ORBITO_STAT(_statAdd(_stats.primitives, 1));
+    int16_t screen_w = _tft->width();
+    int16_t screen_h = _tft->height();
+    // DCT scaling: 0 = 1:1, 1 = 1/2, 2 = 1/4, 3 = 1/8
+    uint8_t scale = 0;
+    if (fit != IMAGE_FIT_NONE)
+        while (scale < JPG_SCALE_MAX && ((width >> scale) > screen_w || (height >> scale) > screen_h)) scale++;
+    JpegTarget target;
+    target.self = this;
+    target.src = jpg;
+    target.len = len;
+    target.dw = width >> scale;
+    target.dh = height >> scale;
+    // Centered, what falls out of the screen is cropped
+    target.dx = (screen_w - target.dw) / 2;
+    target.dy = (screen_h - target.dh) / 2;
+    target.clip_x0 = max((int16_t)0, target.dx);
+    target.clip_y0 = max((int16_t)0, target.dy);
+    target.clip_x1 = min(screen_w, (int16_t)(target.dx + target.dw));
+    target.clip_y1 = min(screen_h, (int16_t)(target.dy + target.dh));
+    target.band = NULL;
+    target.strip_y = INT16_MIN;
+    // Without canvas a whole MCU row (16 lines at 1:1) is kept in one band.
+    // Checked before the bars so a failed call leaves the screen untouched
+    // (the canvas can't come or go while we hold the display lock).
+    xSemaphoreTake(_canvas_lock, portMAX_DELAY);
+    bool has_canvas = (_canvas != NULL);
+    xSemaphoreGive(_canvas_lock);
+    if (!has_canvas && getBandLines() < (16 >> scale)) return false;
+    if (fit != IMAGE_FIT_NONE) _fillBars(target.dx, target.dy, target.dw, target.dh, bar_color);
+    xSemaphoreTake(_canvas_lock, portMAX_DELAY);
+    target.frame = _canvas ? _canvas->getBuffer() : NULL;
+    if (!target.frame) xSemaphoreGive(_canvas_lock);
+    bool ok = (esp_jpg_decode(len, (jpg_scale_t)scale, _jpegRead, _jpegWrite, &target) == ESP_OK);
+    if (target.frame)
+    {
+        _canvas->markDirty(target.clip_x0, target.clip_y0, target.clip_x1 - target.clip_x0, target.clip_y1 - target.clip_y0);
+        _canvas->commit();
+        xSemaphoreGive(_canvas_lock);
+    } else if (target.band) {
+        // Decoding failed half way: give the band back with what we have
+        _jpegPushStrip(target);
+    }
+    return ok;
+}
+
+/**
+ * @brief Draws a pre-rendered sprite on its own area of the screen. Rows are
+ * expanded from the runs straight into the canvas or into the band buffers.
+ * @param sprite Sprite made with RleSprite::build().
+ * @param shift_x Content displacement inside the area (uncovered = background).
+ * @param shift_y Content displacement inside the area (uncovered = background).
+ */
+void DisplayHandler::drawSprite(const RleSprite& sprite, int16_t shift_x, int16_t shift_y)
+{
+    DisplayLock guard(*this);
+    _generation++;
+    _leaveConsole();
+    int16_t w = sprite.width();
+    int16_t h = sprite.height();
+    if (!sprite.isReady() || sprite.x() + w > _tft->width() || sprite.y() + h > _tft->height()) return;
+    ORBITO_STAT(_statAdd(_stats.primitives, 1));
+    // Canvas mode: rows are expanded in place
+    xSemaphoreTake(_canvas_lock, portMAX_DELAY);
+    if (_canvas)
+    {
+        int16_t stride = _canvas->width();
+        uint16_t* frame = &_canvas->getBuffer()[sprite.y() * stride + sprite.x()];
+        for (int16_t row = 0 ; row < h ; row++)
+            sprite.expandRow(&frame[row * stride], row, shift_x, shift_y);
+        _canvas->markDirty(sprite.x(), sprite.y(), w, h);
+        _canvas->commit();
+        xSemaphoreGive(_canvas_lock);
+        return;
+    }
+    xSemaphoreGive(_canvas_lock);
+    // Direct mode: one band is expanded while the previous one is sent
+    int16_t band_rows = min((int32_t)h, (int32_t)(getBandSize() / w));
+    for (int16_t row = 0 ; row < h ; row += band_rows)
+    {
+        int16_t rows = min(band_rows, (int16_t)(h - row));
+        uint16_t* band = acquireBand();
+        if (!band) return;
+        for (int16_t i = 0 ; i < rows ; i++)
+            sprite.expandRow(&band[i * w], row + i, shift_x, shift_y);
+        pushBand(band, sprite.x(), sprite.y() + row, w, rows);
+    }
+}
+
+/**
+ * @brief Replaces a sprite already on the screen sending only the pixels
+ * that change (a moving pupil is a few short spans per row). Falls back to
+ * drawSprite() if both sprites do not cover the same area and colors.
+ * @param shown Sprite currently on the screen.
+ * @param shown_x Displacement it was drawn with.
+ * @param shown_y Displacement it was drawn with.
+ * @param sprite Sprite to show.
+ * @param shift_x Content displacement inside the area.
+ * @param shift_y Content displacement inside the area.
+ */
+void DisplayHandler::drawSpriteDelta(const RleSprite& shown, int16_t shown_x, int16_t shown_y,
+                                     const RleSprite& sprite, int16_t shift_x, int16_t shift_y)
+{
+    DisplayLock guard(*this);
+    _generation++;
+    _leaveConsole();
+    int16_t w = sprite.width();
+    int16_t h = sprite.height();
+    if (!sprite.sameArea(shown) || w > _tft->width())
+    {
+        drawSprite(sprite, shift_x, shift_y);
+        return;
+    }
+    if (sprite.x() + w > _tft->width() || sprite.y() + h > _tft->height()) return;
+    ORBITO_STAT(_statAdd(_stats.primitives, 1));
+    int16_t spans[2 * DISPLAY_MAX_SPANS];
+    // Canvas mode: changed rows are expanded in place, only the spans are flushed
+    xSemaphoreTake(_canvas_lock, portMAX_DELAY);
+    if (_canvas)
+    {
+        int16_t stride = _canvas->width();
+        uint16_t* frame = &_canvas->getBuffer()[sprite.y() * stride + sprite.x()];
+        for (int16_t row = 0 ; row < h ; row++)
+        {
+            uint8_t count = sprite.changedSpans(row, shift_x, shift_y, shown, shown_x, shown_y, spans, DISPLAY_MAX_SPANS);
+            if (count == 0) continue;
+            sprite.expandRow(&frame[row * stride], row, shift_x, shift_y);
+            // One commit per span: the dirty list merges them into a few small windows
+            for (uint8_t i = 0 ; i < count ; i++)
+            {
+                _canvas->markDirty(sprite.x() + spans[2 * i], sprite.y() + row, spans[2 * i + 1] - spans[2 * i], 1);
+                _canvas->commit();
+            }
+        }
+        xSemaphoreGive(_canvas_lock);
+        return;
+    }
+    xSemaphoreGive(_canvas_lock);
+    // Direct mode: queued bands must land first, then one window per (merged) span
+    waitFlush();
+    uint16_t line[TFT_HEIGHT];     // Longest row in any rotation
+    _lockBus();
+    _tft->startWrite();
+    for (int16_t row = 0 ; row < h ; row++)
+    {
+        uint8_t count = sprite.changedSpans(row, shift_x, shift_y, shown, shown_x, shown_y, spans, DISPLAY_MAX_SPANS);
+        if (count == 0) continue;
+        sprite.expandRow(line, row, shift_x, shift_y);
+        uint8_t i = 0;
+        while (i < count)
+        {
+            int16_t x0 = spans[2 * i];
+            int16_t x1 = spans[2 * i + 1];
+            // A short gap costs less than a new address window
+            while (++i < count && spans[2 * i] - x1 <= DISPLAY_SPAN_MERGE) x1 = spans[2 * i + 1];
+            _tft->setAddrWindow(sprite.x() + x0, sprite.y() + row, x1 - x0, 1);
+            _tft->writePixels(&line[x0], x1 - x0, true, true);
+            ORBITO_STAT(_statBlock(x1 - x0));
+        }
+    }
+    _tft->endWrite();
+    _unlockBus();
+}
+
+/**
+ * @brief Draws an image that is produced a few rows at a time (from the
+ * flash, a decoder...) without holding it whole in RAM. The rows are
+ * written straight into the canvas or into the band buffers.
+ * @param source Fills rows (w pixels each, big-endian RGB565) starting at
+ * row (0 = top of the image) into dst.
+ */
+void DisplayHandler::streamPixels(int16_t x, int16_t y, int16_t w, int16_t h,
+                                  std::function<void(uint16_t* dst, int16_t row, int16_t rows)> source)
+{
+    DisplayLock guard(*this);
+    _generation++;
+    _leaveConsole();
+    if (w <= 0 || h <= 0 || x < 0 || y < 0 || x + w > _tft->width() || y + h > _tft->height()) return;
+    ORBITO_STAT(_statAdd(_stats.primitives, 1));
+    // Canvas mode: one row at a time, canvas rows are not contiguous
+    xSemaphoreTake(_canvas_lock, portMAX_DELAY);
+    if (_canvas)
+    {
+        int16_t stride = _canvas->width();
+        uint16_t* frame = &_canvas->getBuffer()[y * stride + x];
+        for (int16_t row = 0 ; row < h ; row++)
+            source(&frame[row * stride], row, 1);
+        _canvas->markDirty(x, y, w, h);
+        _canvas->commit();
+        xSemaphoreGive(_canvas_lock);
+        return;
+    }
+    xSemaphoreGive(_canvas_lock);
+    // Direct mode: one band is filled while the previous one is sent
+    int16_t band_rows = min((int32_t)h, (int32_t)(getBandSize() / w));
+    for (int16_t row = 0 ; row < h ; row += band_rows)
+    {
+        int16_t rows = min(band_rows, (int16_t)(h - row));
+        uint16_t* band = acquireBand();
+        if (!band) return;
+        source(band, row, rows);
+        pushBand(band, x, y + row, w, rows);
+    }
+}
+
+/**
+ * @brief Draws an icon of the atlas. It is decoded from the flash row by
+ * row into the canvas or the band buffers, never as a whole bitmap.
+ * @param scale Size multiplier (1 = 32x32 for the built-in icons).
+ * @param background Color of the transparent pixels.
+ */
+void DisplayHandler::drawEmoji(const EmojiInfo& emoji, int16_t x, int16_t y, uint8_t scale, uint16_t background)
+{
+    DisplayLock guard(*this);
+    _generation++;
+    _leaveConsole();
+    if (scale == 0 || emoji.width > EMOJI_MAX_SIDE) return;
+    EmojiDecoder decoder(emoji, background);
+    int16_t w = emoji.width * scale;
+    uint16_t line[EMOJI_MAX_SIDE];
+    int16_t decoded = -1;    // Icon row in line
+    // Rows arrive in order, each icon row is decoded once and repeated scale times
+    streamPixels(x, y, w, emoji.height * scale, [&](uint16_t* dst, int16_t row, int16_t rows) {
+        for (int16_t i = 0 ; i < rows ; i++, dst += w)
+        {
+            int16_t wanted = (row + i) / scale;
+            while (decoded < wanted)
+            {
+                decoder.nextRow(line);
+                decoded++;
+            }
+            if (scale == 1)
+            {
+                memcpy(dst, line, emoji.width * sizeof(uint16_t));
+                continue;
+            }
+            for (int16_t col = 0 ; col < w ; col++) dst[col] = line[col / scale];
+        }
+    });
+}
+
+// --- Text ---
+
+/**
+ * @brief Sets the text size (1 = 6x8 pixels per character).
+ */
+void DisplayHandler::setTextSize(uint8_t size)
+{
+    DisplayLock guard(*this);
+    _text_size = (size > 0) ? size : 1;
+    _applyTextStyle();
+}
+
+/**
+ * @brief Sets the text color with transparent background.
+ */
+void DisplayHandler::setTextColor(uint16_t color)
+{
+    DisplayLock guard(*this);
+    setTextColor(color, color);
+}
+
+/**
+ * @brief Sets the text color with solid background (fastest: every
+ * line of text is sent as a single block of pixels).
+ */
+void DisplayHandler::setTextColor(uint16_t color, uint16_t background)
+{
+    DisplayLock guard(*this);
+    _text_fg = color;
+    _text_bg = background;
+    _applyTextStyle();
+}
+
+/**
+ * @brief Prints text at the cursor with the built-in font, like Adafruit
+ * print() (wrap and '\n' included) but from the glyph cache.
+ */
+void DisplayHandler::print(const char* text)
+{
+    DisplayLock guard(*this);
+    _generation++;
+    _leaveConsole();
+    if (!text) return;
+    int16_t cell_w = GLYPH_WIDTH * _text_size;
+    int16_t cell_h = GLYPH_HEIGHT * _text_size;
+    int16_t screen_w = _tft->width();
+    // The cursor lives in the active surface
+    xSemaphoreTake(_canvas_lock, portMAX_DELAY);
+    Adafruit_GFX* surface = _canvas ? (Adafruit_GFX*)_canvas : (Adafruit_GFX*)_tft;
+    int16_t x = surface->getCursorX();
+    int16_t y = surface->getCursorY();
+    xSemaphoreGive(_canvas_lock);
+    // Split the text in runs that fit in one line (same rules as Adafruit write())
+    const char* run = text;
+    uint16_t count = 0;
+    int16_t run_x = x;
+    for (const char* c = text ; ; c++)
+    {
+        bool end = (*c == '\0');
+        bool wraps = !end && *c != '\n' && *c != '\r' && (x + cell_w > screen_w);
+        if (end || *c == '\n' || *c == '\r' || wraps)
+        {
+            if (count) _drawTextRun(run_x, y, run, count, _text_size, _text_fg, _text_bg);
+            if (end) break;
+            count = 0;
+            if (*c == '\n' || wraps)
+            {
+                x = 0;
+                y += cell_h;
+            }
+            if (!wraps)
+            {
+                run = c + 1;
+                run_x = x;
+                continue;
+            }
+            run = c;
+            run_x = x;
+        }
+        count++;
+        x += cell_w;
+    }
+    xSemaphoreTake(_canvas_lock, portMAX_DELAY);
+    surface = _canvas ? (Adafruit_GFX*)_canvas : (Adafruit_GFX*)_tft;
+    surface->setCursor(x, y);
+    xSemaphoreGive(_canvas_lock);
+}
+
+// --- Console ---
+
+/**
+ * @brief Appends text to the console (one line per '\n', long lines wrap).
+ * When the screen is full everything moves up one line. In portrait
+ * rotation (0) this is done by the panel scroll registers: one command
+ * and one new line. Otherwise the visible lines are replayed from history.
+ */
+void DisplayHandler::consoleWrite(const char* text)
+{
+    DisplayLock guard(*this);
+    _generation++;
+    if (!text) return;
+    int16_t cols = _consoleCols();
+    char line[CONSOLE_LINE_CHARS + 1];
+    uint16_t len = 0;
+    for (const char* c = text ; ; c++)
+    {
+        bool end = (*c == '\0');
+        if (end || *c == '\n' || len == cols)
+        {
+            // A trailing '\n' does not open an empty line
+            if (!end || len > 0)
+            {
+                line[len] = '\0';
+                _console.push(line, len);
+                _consoleNewLine(line);
+            }
+            if (end) break;
+            bool wrapped = (len == cols && *c != '\n');
+            len = 0;
+            if (!wrapped) continue;
+        }
+        if (*c != '\r') line[len++] = *c;
+    }
+}
+
+/**
+ * @brief Clears the screen and the console history.
+ */
+void DisplayHandler::consoleClear()
+{
+    DisplayLock guard(*this);
+    _generation++;
+    _console.clear();
+    _console_rows_used = 0;
+    if (_console_scroll) _setScroll(0);
+    uint16_t background = _console_bg;
+    render([=](Adafruit_GFX &gfx) {
+        gfx.fillScreen(background);
+    });
+}
+
+/**
+ * @brief Draws again the last lines of the history (e.g. after a fillScreen()).
+ */
+void DisplayHandler::consoleRedraw()
+{
+    DisplayLock guard(*this);
+    _generation++;
+    if (_console_scroll) _setScroll(0);
+    int16_t rows = _consoleRows();
+    int16_t shown = min((int16_t)_console.count(), rows);
+    int16_t first = _console.count() - shown;
+    for (int16_t row = 0 ; row < rows ; row++)
+        _consoleRow(row, (row < shown) ? _console.line(first + row) : "");
+    _console_rows_used = shown;
+}
+
+/**
+ * @brief Console text size and colors (background must be solid).
+ */
+void DisplayHandler::setConsoleStyle(uint8_t size, uint16_t color, uint16_t background)
+{
+    DisplayLock guard(*this);
+    _console_size = (size > 0) ? size : 1;
+    _console_fg = color;
+    _console_bg = background;
+    // Rows and columns may have changed
+    consoleRedraw();
+}
+
+// --- Retained Canvas Mode ---
+
+/**
+ * @brief Allocates a full screen RGB565 canvas in PSRAM. From now on render()
+ * rasterizes in RAM and only the dirty regions are sent by flush().
+ * @return True if the canvas is ready, false if there is no PSRAM available.
+ */
+bool DisplayHandler::beginCanvas()
+{
+    DisplayLock guard(*this);
+    if (_canvas) return true;
+    // 320x240x2 = 150 KB, does not fit in the internal RAM together with WiFi & BLE
+    if (!psramFound()) return false;
+    FrameCanvas* canvas = new FrameCanvas(_tft->width(), _tft->height());
+    if (!canvas->begin(MALLOC_CAP_SPIRAM))
+    {
+        delete canvas;
+        return false;
+    }
+    // Keep the text state where the user left it
+    canvas->setCursor(_tft->getCursorX(), _tft->getCursorY());
+    // We can't read back the panel, so the first flush rewrites everything
+    canvas->markDirty(0, 0, canvas->width(), canvas->height());
+    canvas->commit();
+    xSemaphoreTake(_canvas_lock, portMAX_DELAY);
+    _canvas = canvas;
+    xSemaphoreGive(_canvas_lock);
+    _applyTextStyle();
+    return true;
+}
+
+/**
+ * @brief Pushes pending changes, frees the canvas and goes back to direct drawing.
+ */
+void DisplayHandler::endCanvas()
+{
+    DisplayLock guard(*this);
+    if (!_canvas) return;
+    flush();
+    xSemaphoreTake(_canvas_lock, portMAX_DELAY);
+    FrameCanvas* canvas = _canvas;
+    _canvas = NULL;
+    xSemaphoreGive(_canvas_lock);
+    _tft->setCursor(canvas->getCursorX(), canvas->getCursorY());
+    delete canvas;
+}
+
+/**
+ * @brief Checks if the off-screen canvas is active.
+ */
+bool DisplayHandler::isCanvasEnabled()
+{
+    return (_canvas != NULL);
+}
+
+/**
+ * @brief Sends the dirty regions of the canvas to the panel in a single
+ * bus transaction. Does nothing in direct mode.
+ */
+void DisplayHandler::flush()
+{
+    DisplayLock guard(*this);
+    // A background update may be in the queue, keep the order
+    if (_flush_task) waitFlush();
+    xSemaphoreTake(_canvas_lock, portMAX_DELAY);
+    if (_canvas) _canvas->commit();
+    if (!_canvas || _canvas->getDirtyCount() == 0)
+    {
+        xSemaphoreGive(_canvas_lock);
+        return;
+    }
+    _lockBus();
+    _tft->startWrite();
+    for (uint8_t i = 0 ; i < _canvas->getDirtyCount() ; i++)
+        _pushCanvasRects(&_canvas->getDirtyRect(i), 1);
+    _tft->endWrite();
+    _unlockBus();
+    ORBITO_STAT(_statAdd(_stats.flushes, 1));
+    _canvas->clearDirty();
+    xSemaphoreGive(_canvas_lock);
+}
+
+// --- Asynchronous Flush ---
+
+/**
+ * @brief Starts a task that pushes pixels to the panel in the background,
+ * so the caller core can keep rendering (or running AI) meanwhile.
+ * @param core Core where the flush task runs.
+ * @return True if the task and its two band buffers are ready.
+ */
+bool DisplayHandler::beginAsync(uint8_t core)
+{
+    if (_flush_task) return true;
+    if (!_allocBands()) return false;
+    if (!_flush_jobs)
+    {
+        _flush_jobs = xQueueCreate(DISPLAY_FLUSH_QUEUE, sizeof(FlushJob));
+        _free_bands = xQueueCreate(2, sizeof(uint16_t*));
+        _job_done = xSemaphoreCreateBinary();
+        if (!_flush_jobs || !_free_bands || !_job_done) return false;
+        for (uint8_t i = 0 ; i < 2 ; i++) xQueueSend(_free_bands, &_bands[i], 0);
+    }
+    return xTaskCreatePinnedToCore(_flushTask, "tft_flush", DISPLAY_FLUSH_STACK, this,
+                                   DISPLAY_FLUSH_PRIORITY, &_flush_task, core) == pdPASS;
+}
+
+/**
+ * @brief Waits for the pending transfers and stops the flush task.
+ * Band buffers are kept, pushBand() becomes synchronous.
+ */
+void DisplayHandler::endAsync()
+{
+    if (!_flush_task) return;
+    // An empty job tells the task to exit once everything before it is done.
+    // Queues and bands are kept for the next beginAsync()
+    FlushJob stop;
+    stop.pixels = NULL;
+    stop.rect_count = 0;
+    _jobs_queued++;
+    xQueueSend(_flush_jobs, &stop, portMAX_DELAY);
+    waitFlush();
+    _flush_task = NULL;
+}
+
+/**
+ * @brief Checks if the background flush task is running.
+ */
+bool DisplayHandler::isAsyncEnabled()
+{
+    return (_flush_task != NULL);
+}
+
+/**
+ * @brief Non-blocking flush. The dirty regions of the canvas are handed to the
+ * flush task and this returns at once. Drawing on the canvas waits until the
+ * transfer ends. Falls back to flush() if the task is not running.
+ */
+void DisplayHandler::flushAsync()
+{
+    DisplayLock guard(*this);
+    if (!_flush_task)
+    {
+        flush();
+        return;
+    }
+    // While an update is waiting, new changes keep accumulating in the canvas
+    if (_canvas_job_pending) return;
+    FlushJob job;
+    job.pixels = NULL;
+    job.rect_count = 0;
+    xSemaphoreTake(_canvas_lock, portMAX_DELAY);
+    if (_canvas)
+    {
+        _canvas->commit();
+        job.rect_count = _canvas->getDirtyCount();
+        for (uint8_t i = 0 ; i < job.rect_count ; i++) job.rects[i] = _canvas->getDirtyRect(i);
+        _canvas->clearDirty();
+    }
+    xSemaphoreGive(_canvas_lock);
+    if (job.rect_count == 0) return;
+    _canvas_job_pending = true;
+    _jobs_queued++;
+    xQueueSend(_flush_jobs, &job, portMAX_DELAY);
+}
+
+/**
+ * @brief Fence: blocks until every queued transfer has reached the panel.
+ */
+void DisplayHandler::waitFlush()
+{
+    if (!_flush_task) return;
+    while (_jobs_done != _jobs_queued)
+        xSemaphoreTake(_job_done, pdMS_TO_TICKS(10));
+}
+
+/**
+ * @brief Sets a function called (from the flush task) after each canvas update.
+ * It must not draw: the task drawing may be waiting for this update.
+ */
+void DisplayHandler::onFlushDone(std::function<void()> callback)
+{
+    _flush_callback = callback;
+}
+
+/**
+ * @brief Gets a free band buffer (getBandLines() rows of the screen width,
+ * big-endian RGB565). Waits if both bands are being transferred.
+ */
+uint16_t* DisplayHandler::acquireBand()
+{
+    uint16_t* band = NULL;
+    if (_flush_task)
+    {
+        xQueueReceive(_free_bands, &band, portMAX_DELAY);
+        return band;
+    }
+    // Without task bands are sent at once, any of them is free
+    if (!_allocBands()) return NULL;
+    band = _bands[_next_band];
+    _next_band ^= 1;
+    return band;
+}
+
+/**
+ * @brief Pixels that fit in one band buffer.
+ */
+uint32_t DisplayHandler::getBandSize()
+{
+    return (uint32_t)_tft->width() * _band_lines;
+}
+
+/**
+ * @brief Changes the height of the band buffers. Taller bands mean fewer
+ * replays of the scene but more internal RAM (2 x width x lines x 2 bytes).
+ * @return False if the new buffers could not be allocated (old size is kept).
+ */
+bool DisplayHandler::setBandLines(uint16_t lines)
+{
+    DisplayLock guard(*this);
+    if (lines == 0 || lines > _tft->height()) return false;
+    if (lines == _band_lines) return true;
+    // Not allocated yet, they will be created with the new size
+    if (!_bands[0] && !_bands[1])
+    {
+        _band_lines = lines;
+        return true;
+    }
+    waitFlush();
+    // Both bands must be back in the pool, nobody can be filling one
+    if (_free_bands)
+    {
+        if (uxQueueMessagesWaiting(_free_bands) < 2) return false;
+        xQueueReset(_free_bands);
+    }
+    uint16_t old_lines = _band_lines;
+    for (uint8_t i = 0 ; i < 2 ; i++)
+    {
+        heap_caps_free(_bands[i]);
+        _bands[i] = NULL;
+    }
+    _band_lines = lines;
+    bool allocated = _allocBands();
+    if (!allocated)
+    {
+        // Go back to the previous size (it fitted before)
+        for (uint8_t i = 0 ; i < 2 ; i++)
+        {
+            if (_bands[i]) heap_caps_free(_bands[i]);
+            _bands[i] = NULL;
+        }
+        _band_lines = old_lines;
+        _allocBands();
+    }
+    if (_free_bands) for (uint8_t i = 0 ; i < 2 ; i++) xQueueSend(_free_bands, &_bands[i], 0);
+    return allocated;
+}
+
+/**
+ * @brief Height in rows of each band buffer.
+ */
+uint16_t DisplayHandler::getBandLines()
+{
+    return _band_lines;
+}
+
+/**
+ * @brief Queues a band buffer obtained with acquireBand() for transfer.
+ * The buffer returns to the free pool once it is on the panel, so the
+ * caller can rasterize the next band while this one is being sent.
+ * @param band Buffer with w * h pixels.
+ */
+void DisplayHandler::pushBand(uint16_t* band, int16_t x, int16_t y, int16_t w, int16_t h)
+{
+    DisplayLock guard(*this);
+    _generation++;
+    if (!band) return;
+    FlushJob job;
+    job.pixels = band;
+    job.rects[0] = { x, y, w, h };
+    job.rect_count = 1;
+    if (!_flush_task)
+    {
+        _runJob(job);
+        return;
+    }
+    _jobs_queued++;
+    xQueueSend(_flush_jobs, &job, portMAX_DELAY);
+}
+
+// --- Ownership ---
+
+/**
+ * @brief Reserves the screen for the calling task. Every drawing function
+ * takes it for its own duration; hold it around a group of drawings so
+ * another task (the face animation) cannot draw in between. Recursive.
+ * @param timeout_ms Maximum wait, DISPLAY_WAIT_FOREVER to wait as needed.
+ * @return False if another task kept it longer than the timeout.
+ */
+bool DisplayHandler::lock(uint32_t timeout_ms)
+{
+    if (_screen_lock == NULL) return true;
+    TickType_t ticks = (timeout_ms == DISPLAY_WAIT_FOREVER) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+    return xSemaphoreTakeRecursive(_screen_lock, ticks) == pdTRUE;
+}
+
+/**
+ * @brief Releases one lock() of the calling task.
+ */
+void DisplayHandler::unlock()
+{
+    if (_screen_lock) xSemaphoreGiveRecursive(_screen_lock);
+}
+
+/**
+ * @brief Takes DisplayHandler::lock() until the end of the scope.
+ */
+DisplayLock::DisplayLock(DisplayHandler& display) : _display(display)
+{
+    _display.lock();
+}
+
+DisplayLock::~DisplayLock()
+{
+    _display.unlock();
+}
+
+/**
+ * @brief Counter that changes with every drawing (any function of this class).
+ * A caller that keeps what it drew can check the screen still shows it.
+ */
+uint32_t DisplayHandler::generation() const
+{
+    return _generation;
 }
 
 /**
@@ -44,5 +1069,400 @@ void DisplayHandler::draw(std::function<void(Adafruit_ST7789&)> drawCallback)
  */
 Adafruit_ST7789* DisplayHandler::getDriver()
 {
+    // The caller may draw anything with it
+    _generation++;
     return _tft;
 }
+
+// --- Instrumentation ---
+
+/**
+ * @brief Copies the display and bus counters. Only counts when the library
+ * is built with ORBITO_DISPLAY_STATS, otherwise it costs nothing.
+ * @param reset Starts counting again from zero (and from now for the fps).
+ * @return False if the counters are compiled out.
+ */
+bool DisplayHandler::getStats(DisplayStats& stats, bool reset)
+{
+#ifdef ORBITO_DISPLAY_STATS
+    uint32_t now = millis();
+    portENTER_CRITICAL(&_bus_stats_mux);
+    stats = _stats;
+    stats.transactions = _bus_transactions;
+    if (reset)
+    {
+        _stats = {};
+        _bus_transactions = 0;
+    }
+    portEXIT_CRITICAL(&_bus_stats_mux);
+    stats.elapsed_ms = now - _stats_since;
+    stats.fps = stats.elapsed_ms ? stats.flushes * 1000.0f / stats.elapsed_ms : 0.0f;
+    if (reset) _stats_since = now;
+    getBusStats(stats.bus, reset);
+    return true;
+#else
+    stats = {};
+    (void)reset;
+    return false;
+#endif
+}
+
+#ifdef ORBITO_DISPLAY_STATS
+// Adds to a counter, callers run in both cores
+void DisplayHandler::_statAdd(uint32_t& counter, uint32_t amount)
+{
+    portENTER_CRITICAL(&_bus_stats_mux);
+    counter += amount;
+    portEXIT_CRITICAL(&_bus_stats_mux);
+}
+
+// Counts a block of pixels sent in one window
+void DisplayHandler::_statBlock(uint32_t pixels)
+{
+    portENTER_CRITICAL(&_bus_stats_mux);
+    _stats.pixels += pixels;
+    _stats.bytes += pixels * 2 + DISPLAY_WINDOW_BYTES;
+    portEXIT_CRITICAL(&_bus_stats_mux);
+}
+#endif
+
+// Allocates the two band buffers in internal RAM
+bool DisplayHandler::_allocBands()
+{
+    if (_bands[0] && _bands[1]) return true;
+    size_t bytes = getBandSize() * sizeof(uint16_t);
+    for (uint8_t i = 0 ; i < 2 ; i++)
+    {
+        if (!_bands[i]) _bands[i] = (uint16_t*)heap_caps_malloc(bytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA);
+        if (!_bands[i]) return false;
+    }
+    return true;
+}
+
+// Sends a list of canvas rects (bus must be locked, write started)
+void DisplayHandler::_pushCanvasRects(const DirtyRect* rects, uint8_t count)
+{
+    uint16_t* pixels = _canvas->getBuffer();
+    int16_t stride = _canvas->width();
+    for (uint8_t i = 0 ; i < count ; i++)
+    {
+        const DirtyRect& r = rects[i];
+        ORBITO_STAT(_statBlock((uint32_t)r.w * r.h));
+        _tft->setAddrWindow(r.x, r.y, r.w, r.h);
+        // Canvas is already big-endian, rows are sent as raw bytes
+        if (r.w == stride) _tft->writePixels(&pixels[r.y * stride], (uint32_t)r.w * r.h, true, true);
+        else for (int16_t row = 0 ; row < r.h ; row++)
+            _tft->writePixels(&pixels[(r.y + row) * stride + r.x], r.w, true, true);
+    }
+}
+
+// Executes one flush job (used by the task and by the sync fallback)
+void DisplayHandler::_runJob(const FlushJob& job)
+{
+    if (job.pixels)
+    {
+        const DirtyRect& r = job.rects[0];
+        _lockBus();
+        _tft->startWrite();
+        _tft->setAddrWindow(r.x, r.y, r.w, r.h);
+        _tft->writePixels(job.pixels, (uint32_t)r.w * r.h, true, true);
+        _tft->endWrite();
+        _unlockBus();
+        ORBITO_STAT(_statBlock((uint32_t)r.w * r.h));
+        return;
+    }
+    // Canvas update: nobody can draw while we read the pixels
+    xSemaphoreTake(_canvas_lock, portMAX_DELAY);
+    if (_canvas)
+    {
+        _lockBus();
+        _tft->startWrite();
+        _pushCanvasRects(job.rects, job.rect_count);
+        _tft->endWrite();
+        _unlockBus();
+        ORBITO_STAT(_statAdd(_stats.flushes, 1));
+    }
+    xSemaphoreGive(_canvas_lock);
+}
+
+// Flush task body
+void DisplayHandler::_flushTask(void* arg)
+{
+    DisplayHandler* self = (DisplayHandler*)arg;
+    FlushJob job;
+    while (true)
+    {
+        if (xQueueReceive(self->_flush_jobs, &job, portMAX_DELAY) != pdTRUE) continue;
+        if (!job.pixels && job.rect_count == 0) break;
+        self->_runJob(job);
+        if (job.pixels)
+        {
+            // Band is on the panel, the producer can reuse it
+            xQueueSend(self->_free_bands, &job.pixels, portMAX_DELAY);
+        } else {
+            self->_canvas_job_pending = false;
+            if (self->_flush_callback) self->_flush_callback();
+        }
+        self->_jobs_done++;
+        xSemaphoreGive(self->_job_done);
+    }
+    // Stop request from endAsync()
+    self->_jobs_done++;
+    xSemaphoreGive(self->_job_done);
+    vTaskDelete(NULL);
+}
+
+// Fills the screen around an image placed at (x, y) with size w x h
+void DisplayHandler::_fillBars(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+    int16_t screen_w = _tft->width();
+    int16_t screen_h = _tft->height();
+    if (x <= 0 && y <= 0) return;
+    render([=](Adafruit_GFX &gfx) {
+        gfx.startWrite();
+        if (y > 0)
+        {
+            gfx.writeFillRect(0, 0, screen_w, y, color);
+            gfx.writeFillRect(0, y + h, screen_w, screen_h - y - h, color);
+        }
+        if (x > 0)
+        {
+            gfx.writeFillRect(0, max((int16_t)0, y), x, min(h, screen_h), color);
+            gfx.writeFillRect(x + w, max((int16_t)0, y), screen_w - x - w, min(h, screen_h), color);
+        }
+        gfx.endWrite();
+    });
+}
+
+// Reads width and height from the frame header (SOFn) of a JPEG
+bool DisplayHandler::_jpegSize(const uint8_t* jpg, size_t len, uint16_t& width, uint16_t& height)
+{
+    if (len < 4 || jpg[0] != 0xFF || jpg[1] != 0xD8) return false;
+    size_t i = 2;
+    while (i + 9 < len)
+    {
+        if (jpg[i] != 0xFF) return false;
+        uint8_t marker = jpg[i + 1];
+        // Fill bytes before a marker
+        if (marker == 0xFF)
+        {
+            i++;
+            continue;
+        }
+        // SOF0..SOF15 except DHT (C4), JPG (C8) and DAC (CC)
+        if (marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC)
+        {
+            height = (jpg[i + 5] << 8) | jpg[i + 6];
+            width = (jpg[i + 7] << 8) | jpg[i + 8];
+            return (width > 0 && height > 0);
+        }
+        i += 2 + ((jpg[i + 2] << 8) | jpg[i + 3]);
+    }
+    return false;
+}
+
+// Decoder input: the JPEG is already in memory
+size_t DisplayHandler::_jpegRead(void* arg, size_t index, uint8_t* buf, size_t len)
+{
+    JpegTarget* t = (JpegTarget*)arg;
+    if (index >= t->len) return 0;
+    if (index + len > t->len) len = t->len - index;
+    // NULL buffer means skip
+    if (buf) memcpy(buf, t->src + index, len);
+    return len;
+}
+
+// Decoder output: one block of RGB888 pixels at (x, y) of the (scaled) image
+bool DisplayHandler::_jpegWrite(void* arg, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t* data)
+{
+    JpegTarget* t = (JpegTarget*)arg;
+    // Start and end of the image come without data, the end closes the last strip
+    if (!data)
+    {
+        if ((x || y) && t->band) t->self->_jpegPushStrip(*t);
+        return true;
+    }
+    int16_t sx = t->dx + x;
+    int16_t sy = t->dy + y;
+    // Visible part of the block
+    int16_t x0 = max(sx, t->clip_x0), x1 = min((int16_t)(sx + w), t->clip_x1);
+    int16_t y0 = max(sy, t->clip_y0), y1 = min((int16_t)(sy + h), t->clip_y1);
+    if (!t->frame && sy != t->strip_y)
+    {
+        // Blocks come left to right, a new row means the previous strip is complete
+        if (t->band) t->self->_jpegPushStrip(*t);
+        t->strip_y = sy;
+        t->strip_y0 = y0;
+        t->strip_y1 = y1;
+        if (y0 < y1)
+        {
+            t->band = t->self->acquireBand();
+            if (!t->band) return false;
+        }
+    }
+    if (x0 >= x1 || y0 >= y1) return true;
+    // Destination: the canvas (full screen stride) or the strip (visible width stride)
+    int16_t stride = t->frame ? t->self->_tft->width() : (t->clip_x1 - t->clip_x0);
+    for (int16_t row = y0 ; row < y1 ; row++)
+    {
+        const uint8_t* rgb = data + ((row - sy) * w + (x0 - sx)) * 3;
+        uint16_t* dst = t->frame ? &t->frame[row * stride + x0] : &t->band[(row - t->strip_y0) * stride + (x0 - t->clip_x0)];
+        for (int16_t col = x0 ; col < x1 ; col++, rgb += 3)
+            *dst++ = __builtin_bswap16(((rgb[0] & 0xF8) << 8) | ((rgb[1] & 0xFC) << 3) | (rgb[2] >> 3));
+    }
+    return true;
+}
+
+// Sends the finished strip of a JPEG decode
+void DisplayHandler::_jpegPushStrip(JpegTarget& t)
+{
+    if (t.band) pushBand(t.band, t.clip_x0, t.strip_y0, t.clip_x1 - t.clip_x0, t.strip_y1 - t.strip_y0);
+    t.band = NULL;
+}
+
+// Copies the text state to the panel and the canvas (for Adafruit print/drawChar)
+void DisplayHandler::_applyTextStyle()
+{
+    xSemaphoreTake(_canvas_lock, portMAX_DELAY);
+    _tft->setTextSize(_text_size);
+    _tft->setTextColor(_text_fg, _text_bg);
+    if (_canvas)
+    {
+        _canvas->setTextSize(_text_size);
+        _canvas->setTextColor(_text_fg, _text_bg);
+    }
+    xSemaphoreGive(_canvas_lock);
+}
+
+// Draws one line of text (no wraps or breaks inside) at (x, y)
+void DisplayHandler::_drawTextRun(int16_t x, int16_t y, const char* text, uint16_t count, uint8_t size, uint16_t fg_color, uint16_t bg_color)
+{
+    int16_t screen_w = _tft->width();
+    int16_t screen_h = _tft->height();
+    int16_t w = count * GLYPH_WIDTH * size;
+    int16_t h = GLYPH_HEIGHT * size;
+    // Visible part of the run
+    int16_t x0 = max(x, (int16_t)0), x1 = min((int16_t)(x + w), screen_w);
+    int16_t y0 = max(y, (int16_t)0), y1 = min((int16_t)(y + h), screen_h);
+    if (x0 >= x1 || y0 >= y1) return;
+    ORBITO_STAT(_statAdd(_stats.primitives, 1));
+    bool opaque = (fg_color != bg_color);
+    uint16_t fg = __builtin_bswap16(fg_color);
+    uint16_t bg = __builtin_bswap16(bg_color);
+    // Canvas: the run is expanded straight into the frame
+    xSemaphoreTake(_canvas_lock, portMAX_DELAY);
+    if (_canvas)
+    {
+        _glyphs.expandRun(&_canvas->getBuffer()[y0 * screen_w + x0], screen_w, text, count, size, fg, bg,
+                          opaque, y0 - y, y1 - y0, x0 - x, x1 - x0);
+        _canvas->markDirty(x0, y0, x1 - x0, y1 - y0);
+        _canvas->commit();
+        xSemaphoreGive(_canvas_lock);
+        return;
+    }
+    xSemaphoreGive(_canvas_lock);
+    // Transparent on the panel: we can't read what is below, only the lit spans are sent
+    if (!opaque)
+    {
+        _lockBus();
+        _tft->startWrite();
+        _glyphs.spanRun(*_tft, x, y, text, count, size, fg_color);
+        _tft->endWrite();
+        _unlockBus();
+        return;
+    }
+    // Solid background: the run goes out as whole blocks of rows
+    int16_t rows_per_band = min((int32_t)(y1 - y0), (int32_t)(getBandSize() / (x1 - x0)));
+    for (int16_t row = y0 ; row < y1 ; row += rows_per_band)
+    {
+        int16_t rows = min(rows_per_band, (int16_t)(y1 - row));
+        uint16_t* band = acquireBand();
+        if (!band) return;
+        _glyphs.expandRun(band, x1 - x0, text, count, size, fg, bg, true, row - y, rows, x0 - x, x1 - x0);
+        pushBand(band, x0, row, x1 - x0, rows);
+    }
+}
+
+// Lines that fit in the screen and characters per line of the console
+int16_t DisplayHandler::_consoleRows()
+{
+    return _tft->height() / (GLYPH_HEIGHT * _console_size);
+}
+
+int16_t DisplayHandler::_consoleCols()
+{
+    return min(_tft->width() / (GLYPH_WIDTH * _console_size), CONSOLE_LINE_CHARS);
+}
+
+// True if the console can use the panel scroll (portrait and no canvas)
+bool DisplayHandler::_consoleHardware()
+{
+    // The scroll registers move along the panel's native 320 lines, which are
+    // horizontal in landscape. The canvas is pushed by rects, so it can't either.
+    return (!_canvas && _tft->getRotation() == 0);
+}
+
+// Adds a line at the bottom of the console, scrolling if needed
+void DisplayHandler::_consoleNewLine(const char* text)
+{
+    int16_t rows = _consoleRows();
+    if (_console_rows_used < rows)
+    {
+        _consoleRow(_console_rows_used++, text);
+        return;
+    }
+    if (_consoleHardware())
+    {
+        // The old top line becomes the bottom one, only that line is drawn
+        int16_t area = rows * GLYPH_HEIGHT * _console_size;
+        _setScroll((_console_scroll + GLYPH_HEIGHT * _console_size) % area);
+        _consoleRow(rows - 1, text);
+        return;
+    }
+    // Software scroll: the visible window of the history is drawn one line up
+    if (_console_scroll) _setScroll(0);
+    int16_t first = _console.count() - rows;
+    for (int16_t row = 0 ; row < rows ; row++)
+        _consoleRow(row, (first + row >= 0) ? _console.line(first + row) : "");
+}
+
+// Draws a console row (padded with background up to the last column)
+void DisplayHandler::_consoleRow(int16_t row, const char* text)
+{
+    int16_t line_h = GLYPH_HEIGHT * _console_size;
+    int16_t y = row * line_h;
+    // With hardware scroll the rows are rotated in the frame memory
+    if (_console_scroll) y = (_console_scroll + y) % (_consoleRows() * line_h);
+    int16_t cols = _consoleCols();
+    char padded[CONSOLE_LINE_CHARS];
+    int16_t len = strlen(text);
+    memcpy(padded, text, min(len, cols));
+    if (len < cols) memset(padded + len, ' ', cols - len);
+    _drawTextRun(0, y, padded, cols, _console_size, _console_fg, _console_bg);
+}
+
+// Sets the hardware scroll offset in pixels
+void DisplayHandler::_setScroll(int16_t offset)
+{
+    // Scroll area: whole console lines from the top, the remainder stays fixed
+    uint16_t lines = _tft->height();
+    uint16_t area = _consoleRows() * GLYPH_HEIGHT * _console_size;
+    uint16_t bottom = lines - area;
+    uint8_t definition[6] = { 0, 0, (uint8_t)(area >> 8), (uint8_t)area, (uint8_t)(bottom >> 8), (uint8_t)bottom };
+    uint8_t start[2] = { (uint8_t)(offset >> 8), (uint8_t)offset };
+    // Everything drawn between bands must be on the panel before moving it
+    waitFlush();
+    _lockBus();
+    _tft->sendCommand(ST7789_VSCRDEF, definition, 6);
+    _tft->sendCommand(ST7789_VSCRSADD, start, 2);
+    _unlockBus();
+    ORBITO_STAT(_statAdd(_stats.bytes, 1 + 6 + 1 + 2));
+    _console_scroll = offset;
+}
+
+// Puts the panel scroll back to 0 before other drawings (they use screen rows)
+void DisplayHandler::_leaveConsole()
+{
+    // The console lines are rotated in the frame memory: they are drawn again in order
+    if (_console_scroll) consoleRedraw();
+}
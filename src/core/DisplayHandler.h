@@ -3,11 +3,20 @@
 
 #include <Arduino.h>
 #include "./SPIHandler.h"
+#include "./FrameCanvas.h"
+#include "./DrawList.h"
+#include "./BandCanvas.h"
+#include "./GlyphCache.h"
+#include "./LineRing.h"
+#include "./RleSprite.h"
+#include "./EmojiAtlas.h"
 
 // Adafruit dependencies for displays
 #include <Adafruit_GFX.h>
 #include <Adafruit_ST7789.h>
 #include <functional>
+#include <freertos/queue.h>
+#include <esp_jpg_decode.h>
 
 // Display configuration (ST7789 2.4" 240x320 pixels)
 #define TFT_WIDTH 240
@@ -15,7 +24,72 @@
 #define TFT_CS_PIN 46
 #define TFT_RST_PIN 45
 #define TFT_DC_PIN 10
+#ifndef TFT_ROTATION
 #define TFT_ROTATION 1
+#endif
+
+// ST7789 vertical scrolling commands (not exposed by the Adafruit driver)
+#define ST7789_VSCRDEF  0x33    // Top fixed, scroll and bottom fixed areas
+#define ST7789_VSCRSADD 0x37    // First frame memory line shown in the scroll area
+
+// Asynchronous flush configuration
+#ifndef DISPLAY_BAND_LINES
+#define DISPLAY_BAND_LINES 16      // Default rows of each band buffer (two of them, internal RAM)
+#endif
+#define DISPLAY_FLUSH_CORE 0       // loop() runs in core 1, pixels are pushed from core 0
+#define DISPLAY_FLUSH_PRIORITY 2
+#define DISPLAY_FLUSH_STACK 3072
+#define DISPLAY_FLUSH_QUEUE 4
+
+// Command and address bytes sent to open a pixel window (CASET + RASET + RAMWR)
+#define DISPLAY_WINDOW_BYTES 11
+// Spans of a row closer than this are sent in one window (cheaper than a new window)
+#define DISPLAY_SPAN_MERGE 6
+// Changed spans tracked per row by drawSpriteDelta()
+#define DISPLAY_MAX_SPANS 8
+// Timeout of lock() that never expires
+#define DISPLAY_WAIT_FOREVER 0xFFFFFFFF
+
+/**
+ * @brief Pixel formats accepted by DisplayHandler::drawImage().
+ */
+enum ImageFormat : uint8_t {
+    IMAGE_RGB565_BE,    // Panel byte order (camera frames)
+    IMAGE_RGB565,       // CPU byte order (uint16_t arrays)
+    IMAGE_GRAY8         // One brightness byte per pixel
+};
+
+/**
+ * @brief How an image is placed on the screen.
+ */
+enum ImageFit : uint8_t {
+    IMAGE_FIT_NONE,         // 1:1 and centered, cropped if it is bigger than the screen
+    IMAGE_FIT_LETTERBOX,    // Scaled keeping the aspect ratio, bars on the free sides
+    IMAGE_FIT_STRETCH       // Scaled to the whole screen
+};
+
+/**
+ * @brief Work item for the flush task: a band buffer or a canvas update.
+ */
+struct FlushJob {
+    uint16_t* pixels;                           // Band buffer, NULL for a canvas update
+    DirtyRect rects[CANVAS_MAX_DIRTY_RECTS];    // Band: rects[0] only. Canvas: dirty list
+    uint8_t rect_count;
+};
+
+/**
+ * @brief Snapshot of the display counters (see DisplayHandler::getStats()).
+ */
+struct DisplayStats {
+    uint32_t primitives;    // Callbacks, list commands, images and text runs issued
+    uint32_t transactions;  // Times the display took the bus
+    uint32_t pixels;        // Pixels sent as blocks (canvas, bands, images and text)
+    uint32_t bytes;         // Bytes of those blocks, window setup included
+    uint32_t flushes;       // Canvas flushes and composed scenes
+    uint32_t elapsed_ms;    // Time covered by the counters
+    float fps;              // Flushes per second over elapsed_ms
+    BusStats bus;           // Shared bus usage (flash included)
+};
 
 class DisplayHandler : public SPIHandler {
 
@@ -39,6 +113,271 @@ class DisplayHandler : public SPIHandler {
          */
         void draw(std::function<void(Adafruit_ST7789&)> drawCallback);
 
+        /**
+         * @brief Execute drawing commands on the active surface: the off-screen
+         * canvas when it is enabled, the panel otherwise (same as draw()).
+         * @param drawCallback Lambda function with the instructions to draw.
+         */
+        void render(std::function<void(Adafruit_GFX&)> drawCallback);
+
+        /**
+         * @brief Executes a recorded command list on the active surface taking
+         * the bus only once (one lock and one SPI transaction for the whole list).
+         * @param list Commands to execute.
+         */
+        void submit(const DrawList& list);
+
+        /**
+         * @brief Composes a whole scene without flicker and without a framebuffer:
+         * the list is replayed once per horizontal band in RAM and every band is
+         * sent complete. In canvas mode it is the same as submit().
+         * @param scene Commands of the full frame (start it with fillScreen()).
+         * @param y First row to compose.
+         * @param h Rows to compose (-1 = down to the bottom).
+         */
+        void renderScene(const DrawList& scene, int16_t y = 0, int16_t h = -1);
+
+        /**
+         * @brief Streams an image to the screen row by row, scaling it (nearest
+         * neighbour) if asked. The source is only read, never modified, and can be
+         * released as soon as this returns.
+         * @param pixels Source pixels (width * height).
+         * @param format Layout of the source pixels.
+         * @param fit Placement on the screen.
+         * @param bar_color Color of the letterbox bars.
+         */
+        void drawImage(const uint8_t* pixels, uint16_t width, uint16_t height, ImageFormat format, ImageFit fit, uint16_t bar_color = 0x0000);
+
+        /**
+         * @brief Decodes a JPEG straight to the screen, one MCU row at a time, without
+         * a full size RGB buffer. Big images are reduced by the decoder itself
+         * (1/2, 1/4 or 1/8) so only the pixels that will be shown are decoded.
+         * @param jpg JPEG file in memory.
+         * @param len Size in bytes.
+         * @param fit IMAGE_FIT_NONE decodes at full size (centered and cropped),
+         * any other value picks the biggest reduction that fits in the screen.
+         * @param bar_color Color of the letterbox bars.
+         * @return False if the data is not a valid JPEG.
+         */
+        bool drawJpeg(const uint8_t* jpg, size_t len, ImageFit fit = IMAGE_FIT_LETTERBOX, uint16_t bar_color = 0x0000);
+
+        /**
+         * @brief Draws a pre-rendered sprite on its own area of the screen. Rows are
+         * expanded from the runs straight into the canvas or into the band buffers.
+         * @param sprite Sprite made with RleSprite::build().
+         * @param shift_x Content displacement inside the area (uncovered = background).
+         * @param shift_y Content displacement inside the area (uncovered = background).
+         */
+        void drawSprite(const RleSprite& sprite, int16_t shift_x = 0, int16_t shift_y = 0);
+
+        /**
+         * @brief Replaces a sprite already on the screen sending only the pixels
+         * that change (a moving pupil is a few short spans per row). Falls back to
+         * drawSprite() if both sprites do not cover the same area and colors.
+         * @param shown Sprite currently on the screen.
+         * @param shown_x Displacement it was drawn with.
+         * @param shown_y Displacement it was drawn with.
+         * @param sprite Sprite to show.
+         * @param shift_x Content displacement inside the area.
+         * @param shift_y Content displacement inside the area.
+         */
+        void drawSpriteDelta(const RleSprite& shown, int16_t shown_x, int16_t shown_y,
+                             const RleSprite& sprite, int16_t shift_x = 0, int16_t shift_y = 0);
+
+        /**
+         * @brief Draws an image that is produced a few rows at a time (from the
+         * flash, a decoder...) without holding it whole in RAM. The rows are
+         * written straight into the canvas or into the band buffers.
+         * @param source Fills rows (w pixels each, big-endian RGB565) starting at
+         * row (0 = top of the image) into dst.
+         */
+        void streamPixels(int16_t x, int16_t y, int16_t w, int16_t h,
+                          std::function<void(uint16_t* dst, int16_t row, int16_t rows)> source);
+
+        /**
+         * @brief Draws an icon of the atlas. It is decoded from the flash row by
+         * row into the canvas or the band buffers, never as a whole bitmap.
+         * @param scale Size multiplier (1 = 32x32 for the built-in icons).
+         * @param background Color of the transparent pixels.
+         */
+        void drawEmoji(const EmojiInfo& emoji, int16_t x, int16_t y, uint8_t scale = 1, uint16_t background = 0x0000);
+
+        // --- Text ---
+
+        /**
+         * @brief Sets the text size (1 = 6x8 pixels per character).
+         */
+        void setTextSize(uint8_t size);
+
+        /**
+         * @brief Sets the text color with transparent background.
+         */
+        void setTextColor(uint16_t color);
+
+        /**
+         * @brief Sets the text color with solid background (fastest: every
+         * line of text is sent as a single block of pixels).
+         */
+        void setTextColor(uint16_t color, uint16_t background);
+
+        /**
+         * @brief Prints text at the cursor with the built-in font, like Adafruit
+         * print() (wrap and '\n' included) but from the glyph cache.
+         */
+        void print(const char* text);
+
+        // --- Console ---
+
+        /**
+         * @brief Appends text to the console (one line per '\n', long lines wrap).
+         * When the screen is full everything moves up one line. In portrait
+         * rotation (0) this is done by the panel scroll registers: one command
+         * and one new line. Otherwise the visible lines are replayed from history.
+         */
+        void consoleWrite(const char* text);
+
+        /**
+         * @brief Clears the screen and the console history.
+         */
+        void consoleClear();
+
+        /**
+         * @brief Draws again the last lines of the history (e.g. after a fillScreen()).
+         */
+        void consoleRedraw();
+
+        /**
+         * @brief Console text size and colors (background must be solid).
+         */
+        void setConsoleStyle(uint8_t size, uint16_t color, uint16_t background);
+
+        // --- Retained Canvas Mode ---
+
+        /**
+         * @brief Allocates a full screen RGB565 canvas in PSRAM. From now on render()
+         * rasterizes in RAM and only the dirty regions are sent by flush().
+         * @return True if the canvas is ready, false if there is no PSRAM available.
+         */
+        bool beginCanvas();
+
+        /**
+         * @brief Pushes pending changes, frees the canvas and goes back to direct drawing.
+         */
+        void endCanvas();
+
+        /**
+         * @brief Checks if the off-screen canvas is active.
+         */
+        bool isCanvasEnabled();
+
+        /**
+         * @brief Sends the dirty regions of the canvas to the panel in a single
+         * bus transaction. Does nothing in direct mode.
+         */
+        void flush();
+
+        // --- Asynchronous Flush ---
+
+        /**
+         * @brief Starts a task that pushes pixels to the panel in the background,
+         * so the caller core can keep rendering (or running AI) meanwhile.
+         * @param core Core where the flush task runs.
+         * @return True if the task and its two band buffers are ready.
+         */
+        bool beginAsync(uint8_t core = DISPLAY_FLUSH_CORE);
+
+        /**
+         * @brief Waits for the pending transfers and stops the flush task.
+         * Band buffers are kept, pushBand() becomes synchronous.
+         */
+        void endAsync();
+
+        /**
+         * @brief Checks if the background flush task is running.
+         */
+        bool isAsyncEnabled();
+
+        /**
+         * @brief Non-blocking flush. The dirty regions of the canvas are handed to the
+         * flush task and this returns at once. Drawing on the canvas waits until the
+         * transfer ends. Falls back to flush() if the task is not running.
+         */
+        void flushAsync();
+
+        /**
+         * @brief Fence: blocks until every queued transfer has reached the panel.
+         */
+        void waitFlush();
+
+        /**
+         * @brief Sets a function called (from the flush task) after each canvas update.
+         * It must not draw: the task drawing may be waiting for this update.
+         */
+        void onFlushDone(std::function<void()> callback);
+
+        /**
+         * @brief Gets a free band buffer (getBandLines() rows of the screen width,
+         * big-endian RGB565). Waits if both bands are being transferred.
+         */
+        uint16_t* acquireBand();
+
+        /**
+         * @brief Pixels that fit in one band buffer.
+         */
+        uint32_t getBandSize();
+
+        /**
+         * @brief Changes the height of the band buffers. Taller bands mean fewer
+         * replays of the scene but more internal RAM (2 x width x lines x 2 bytes).
+         * @return False if the new buffers could not be allocated (old size is kept).
+         */
+        bool setBandLines(uint16_t lines);
+
+        /**
+         * @brief Height in rows of each band buffer.
+         */
+        uint16_t getBandLines();
+
+        /**
+         * @brief Queues a band buffer obtained with acquireBand() for transfer.
+         * The buffer returns to the free pool once it is on the panel, so the
+         * caller can rasterize the next band while this one is being sent.
+         * @param band Buffer with w * h pixels.
+         */
+        void pushBand(uint16_t* band, int16_t x, int16_t y, int16_t w, int16_t h);
+
+        // --- Instrumentation ---
+
+        /**
+         * @brief Copies the display and bus counters. Only counts when the library
+         * is built with ORBITO_DISPLAY_STATS, otherwise it costs nothing.
+         * @param reset Starts counting again from zero (and from now for the fps).
+         * @return False if the counters are compiled out.
+         */
+        bool getStats(DisplayStats& stats, bool reset = false);
+
+        // --- Ownership ---
+
+        /**
+         * @brief Reserves the screen for the calling task. Every drawing function
+         * takes it for its own duration; hold it around a group of drawings so
+         * another task (the face animation) cannot draw in between. Recursive.
+         * @param timeout_ms Maximum wait, DISPLAY_WAIT_FOREVER to wait as needed.
+         * @return False if another task kept it longer than the timeout.
+         */
+        bool lock(uint32_t timeout_ms = DISPLAY_WAIT_FOREVER);
+
+        /**
+         * @brief Releases one lock() of the calling task.
+         */
+        void unlock();
+
+        /**
+         * @brief Counter that changes with every drawing (any function of this class).
+         * A caller that keeps what it drew can check the screen still shows it.
+         */
+        uint32_t generation() const;
+
         /**
          * @brief Direct access to the TFT object (CAUTION)
          * If this method is used directly, it may cause conflicts with the flash memory
@@ -50,6 +389,116 @@ class DisplayHandler : public SPIHandler {
         // Intern instance for Adafruit Driver
         Adafruit_ST7789* _tft = NULL;
 
+        // Off-screen surface (NULL in direct mode) and its lock
+        FrameCanvas* _canvas = NULL;
+        SemaphoreHandle_t _canvas_lock = NULL;
+        SemaphoreHandle_t _screen_lock = NULL;   // Recursive, see lock()
+        volatile uint32_t _generation = 0;       // Drawings so far, see generation()
+
+        // Text state and pre-rendered font
+        GlyphCache _glyphs;
+        uint8_t _text_size = 1;
+        uint16_t _text_fg = 0xFFFF;
+        uint16_t _text_bg = 0xFFFF;    // Same as fg = transparent
+
+        // Console history and layout
+        LineRing _console;
+        uint8_t _console_size = 2;
+        uint16_t _console_fg = 0xFFFF;
+        uint16_t _console_bg = 0x0000;
+        int16_t _console_rows_used = 0;     // Screen rows with text (until it is full)
+        int16_t _console_scroll = 0;        // Hardware scroll offset in pixels
+
+        // Background flush: task, jobs, free bands and fence
+        TaskHandle_t _flush_task = NULL;
+        QueueHandle_t _flush_jobs = NULL;
+        QueueHandle_t _free_bands = NULL;
+        SemaphoreHandle_t _job_done = NULL;
+        uint16_t* _bands[2] = { NULL, NULL };
+        uint16_t _band_lines = DISPLAY_BAND_LINES;
+        uint8_t _next_band = 0;
+        volatile uint32_t _jobs_queued = 0;
+        volatile uint32_t _jobs_done = 0;
+        volatile bool _canvas_job_pending = false;
+        std::function<void()> _flush_callback = nullptr;
+
+#ifdef ORBITO_DISPLAY_STATS
+        // Counters since the last reset (transactions and bus live in SPIHandler)
+        DisplayStats _stats = {};
+        uint32_t _stats_since = 0;
+        // Adds to a counter, callers run in both cores
+        void _statAdd(uint32_t& counter, uint32_t amount);
+        // Counts a block of pixels sent in one window
+        void _statBlock(uint32_t pixels);
+#endif
+
+        // Allocates the two band buffers in internal RAM
+        bool _allocBands();
+        // Sends a list of canvas rects (bus must be locked, write started)
+        void _pushCanvasRects(const DirtyRect* rects, uint8_t count);
+        // Executes one flush job (used by the task and by the sync fallback)
+        void _runJob(const FlushJob& job);
+        // Flush task body
+        static void _flushTask(void* arg);
+
+        // State of a JPEG decode in progress
+        struct JpegTarget {
+            DisplayHandler* self;
+            const uint8_t* src;
+            size_t len;
+            int16_t dx, dy, dw, dh;             // Decoded image on the screen
+            int16_t clip_x0, clip_y0;           // Visible part of it
+            int16_t clip_x1, clip_y1;
+            uint16_t* frame;                    // Canvas buffer, NULL in direct mode
+            uint16_t* band;                     // Strip being filled (direct mode)
+            int16_t strip_y, strip_y0, strip_y1;
+        };
+
+        // Copies the text state to the panel and the canvas (for Adafruit print/drawChar)
+        void _applyTextStyle();
+        // Draws one line of text (no wraps or breaks inside) at (x, y)
+        void _drawTextRun(int16_t x, int16_t y, const char* text, uint16_t count, uint8_t size, uint16_t fg, uint16_t bg);
+        // Lines that fit in the screen and characters per line of the console
+        int16_t _consoleRows();
+        int16_t _consoleCols();
+        // True if the console can use the panel scroll (portrait and no canvas)
+        bool _consoleHardware();
+        // Adds a line at the bottom of the console, scrolling if needed
+        void _consoleNewLine(const char* text);
+        // Draws a console row (padded with background up to the last column)
+        void _consoleRow(int16_t row, const char* text);
+        // Sets the hardware scroll offset in pixels
+        void _setScroll(int16_t offset);
+        // Puts the panel scroll back to 0 before other drawings (they use screen rows)
+        void _leaveConsole();
+
+        // Fills the screen around an image placed at (x, y) with size w x h
+        void _fillBars(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+        // Reads width and height from the frame header (SOFn) of a JPEG
+        static bool _jpegSize(const uint8_t* jpg, size_t len, uint16_t& width, uint16_t& height);
+        // Decoder input: the JPEG is already in memory
+        static size_t _jpegRead(void* arg, size_t index, uint8_t* buf, size_t len);
+        // Decoder output: one block of RGB888 pixels at (x, y) of the (scaled) image
+        static bool _jpegWrite(void* arg, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t* data);
+        // Sends the finished strip of a JPEG decode
+        void _jpegPushStrip(JpegTarget& t);
+
+};
+
+/**
+ * @brief Takes DisplayHandler::lock() until the end of the scope.
+ */
+class DisplayLock {
+
+    public:
+
+        DisplayLock(DisplayHandler& display);
+        ~DisplayLock();
+
+    private:
+
+        DisplayHandler& _display;
+
 };
 
 #endif
@@ -0,0 +1,460 @@
+#include "DrawList.h"
+
+// --- Span based rasterizers (only "write" primitives, no nested transactions) ---
+
+// Filled circle halves as horizontal spans. corners: 1 = lower half, 2 = upper half.
+// delta stretches every span to the right (used by rounded rectangles).
+static void _fillCircleSpans(Adafruit_GFX& gfx, int16_t x0, int16_t y0, int16_t r, uint8_t corners, int16_t delta, uint16_t color)
+{
+    int16_t f = 1 - r;
+    int16_t ddF_x = 1;
+    int16_t ddF_y = -2 * r;
+    int16_t x = 0;
+    int16_t y = r;
+    int16_t px = x;
+    int16_t py = y;
+    delta++; // Avoid some +1's in the loop
+    while (x < y)
+    {
+        if (f >= 0)
+        {
+            y--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+        x++;
+        ddF_x += 2;
+        f += ddF_x;
+        // These checks avoid drawing the same row twice
+        if (x < (y + 1))
+        {
+            if (corners & 1) gfx.writeFastHLine(x0 - y, y0 + x, 2 * y + delta, color);
+            if (corners & 2) gfx.writeFastHLine(x0 - y, y0 - x, 2 * y + delta, color);
+        }
+        if (y != py)
+        {
+            if (corners & 1) gfx.writeFastHLine(x0 - px, y0 + py, 2 * px + delta, color);
+            if (corners & 2) gfx.writeFastHLine(x0 - px, y0 - py, 2 * px + delta, color);
+            py = y;
+        }
+        px = x;
+    }
+}
+
+// Circle outline quarters. corners: 1 = top-left, 2 = top-right, 4 = bottom-right, 8 = bottom-left
+static void _drawCircleQuarters(Adafruit_GFX& gfx, int16_t x0, int16_t y0, int16_t r, uint8_t corners, uint16_t color)
+{
+    int16_t f = 1 - r;
+    int16_t ddF_x = 1;
+    int16_t ddF_y = -2 * r;
+    int16_t x = 0;
+    int16_t y = r;
+    while (x < y)
+    {
+        if (f >= 0)
+        {
+            y--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+        x++;
+        ddF_x += 2;
+        f += ddF_x;
+        if (corners & 0x4)
+        {
+            gfx.writePixel(x0 + x, y0 + y, color);
+            gfx.writePixel(x0 + y, y0 + x, color);
+        }
+        if (corners & 0x2)
+        {
+            gfx.writePixel(x0 + x, y0 - y, color);
+            gfx.writePixel(x0 + y, y0 - x, color);
+        }
+        if (corners & 0x8)
+        {
+            gfx.writePixel(x0 - y, y0 + x, color);
+            gfx.writePixel(x0 - x, y0 + y, color);
+        }
+        if (corners & 0x1)
+        {
+            gfx.writePixel(x0 - y, y0 - x, color);
+            gfx.writePixel(x0 - x, y0 - y, color);
+        }
+    }
+}
+
+// Any line, using spans when it is horizontal or vertical
+static void _writeLine(Adafruit_GFX& gfx, int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+{
+    if (y0 == y1)
+    {
+        if (x0 > x1) std::swap(x0, x1);
+        gfx.writeFastHLine(x0, y0, x1 - x0 + 1, color);
+    } else if (x0 == x1) {
+        if (y0 > y1) std::swap(y0, y1);
+        gfx.writeFastVLine(x0, y0, y1 - y0 + 1, color);
+    } else {
+        gfx.writeLine(x0, y0, x1, y1, color);
+    }
+}
+
+// Filled triangle with horizontal spans (scanline, integer only)
+static void _fillTriangle(Adafruit_GFX& gfx, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color)
+{
+    int16_t a, b, y, last;
+    // Sort coordinates by Y order (y2 >= y1 >= y0)
+    if (y0 > y1) { std::swap(y0, y1); std::swap(x0, x1); }
+    if (y1 > y2) { std::swap(y2, y1); std::swap(x2, x1); }
+    if (y0 > y1) { std::swap(y0, y1); std::swap(x0, x1); }
+    // Handle the degenerate case: all points on the same line
+    if (y0 == y2)
+    {
+        a = b = x0;
+        if (x1 < a) a = x1; else if (x1 > b) b = x1;
+        if (x2 < a) a = x2; else if (x2 > b) b = x2;
+        gfx.writeFastHLine(a, y0, b - a + 1, color);
+        return;
+    }
+    int16_t dx01 = x1 - x0, dy01 = y1 - y0;
+    int16_t dx02 = x2 - x0, dy02 = y2 - y0;
+    int16_t dx12 = x2 - x1, dy12 = y2 - y1;
+    int32_t sa = 0, sb = 0;
+    // Upper part: if y1 == y2 the last row belongs to it, otherwise to the lower part
+    last = (y1 == y2) ? y1 : y1 - 1;
+    for (y = y0 ; y <= last ; y++)
+    {
+        a = x0 + sa / dy01;
+        b = x0 + sb / dy02;
+        sa += dx01;
+        sb += dx02;
+        if (a > b) std::swap(a, b);
+        gfx.writeFastHLine(a, y, b - a + 1, color);
+    }
+    // Lower part
+    sa = (int32_t)dx12 * (y - y1);
+    sb = (int32_t)dx02 * (y - y0);
+    for (; y <= y2 ; y++)
+    {
+        a = x1 + sa / dy12;
+        b = x0 + sb / dy02;
+        sa += dx12;
+        sb += dx02;
+        if (a > b) std::swap(a, b);
+        gfx.writeFastHLine(a, y, b - a + 1, color);
+    }
+}
+
+/**
+ * @brief Constructor.
+ * @param storage Array where commands will be recorded.
+ * @param capacity Number of commands that fit in the array.
+ */
+DrawList::DrawList(DrawCommand* storage, uint16_t capacity)
+    : _commands(storage), _capacity(capacity)
+{
+    _count = 0;
+    _overflow = false;
+}
+
+// --- Recording (return false if the list is full) ---
+
+bool DrawList::fillScreen(uint16_t color)
+{
+    // Everything recorded before is going to be covered
+    clear();
+    return _push(DRAW_OP_FILL_SCREEN, color);
+}
+
+bool DrawList::drawPixel(int16_t x, int16_t y, uint16_t color)
+{
+    return _push(DRAW_OP_PIXEL, color, x, y);
+}
+
+bool DrawList::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+{
+    return _push(DRAW_OP_LINE, color, x0, y0, x1, y1);
+}
+
+bool DrawList::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+    return _push(DRAW_OP_HLINE, color, x, y, w);
+}
+
+bool DrawList::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+    return _push(DRAW_OP_VLINE, color, x, y, h);
+}
+
+bool DrawList::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+    return _push(DRAW_OP_RECT, color, x, y, w, h);
+}
+
+bool DrawList::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+    return _push(DRAW_OP_FILL_RECT, color, x, y, w, h);
+}
+
+bool DrawList::drawCircle(int16_t x, int16_t y, int16_t r, uint16_t color)
+{
+    return _push(DRAW_OP_CIRCLE, color, x, y, r);
+}
+
+bool DrawList::fillCircle(int16_t x, int16_t y, int16_t r, uint16_t color)
+{
+    return _push(DRAW_OP_FILL_CIRCLE, color, x, y, r);
+}
+
+bool DrawList::drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color)
+{
+    return _push(DRAW_OP_ROUND_RECT, color, x, y, w, h, r);
+}
+
+bool DrawList::fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color)
+{
+    return _push(DRAW_OP_FILL_ROUND_RECT, color, x, y, w, h, r);
+}
+
+bool DrawList::drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color)
+{
+    return _push(DRAW_OP_TRIANGLE, color, x0, y0, x1, y1, x2, y2);
+}
+
+bool DrawList::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color)
+{
+    return _push(DRAW_OP_FILL_TRIANGLE, color, x0, y0, x1, y1, x2, y2);
+}
+
+bool DrawList::drawText(int16_t x, int16_t y, const char* text, uint16_t color, uint8_t size)
+{
+    if (!_push(DRAW_OP_TEXT, color, x, y)) return false;
+    DrawCommand& c = _commands[_count - 1];
+    c.param = (size > 0) ? size : 1;
+    // The pointer lives in the free arguments (up to 8 bytes)
+    memcpy(&c.arg[2], &text, sizeof(text));
+    return true;
+}
+
+// --- Management ---
+
+/**
+ * @brief Removes all the recorded commands.
+ */
+void DrawList::clear()
+{
+    _count = 0;
+    _overflow = false;
+}
+
+/**
+ * @brief Number of recorded commands.
+ */
+uint16_t DrawList::size() const
+{
+    return _count;
+}
+
+/**
+ * @brief Maximum number of commands.
+ */
+uint16_t DrawList::capacity() const
+{
+    return _capacity;
+}
+
+/**
+ * @brief True if some command was dropped because the list was full.
+ */
+bool DrawList::overflowed() const
+{
+    return _overflow;
+}
+
+// --- Execution ---
+
+/**
+ * @brief Executes every command on a surface inside one write transaction.
+ * The caller must own the bus (see DisplayHandler::submit()).
+ */
+void DrawList::replay(Adafruit_GFX& gfx) const
+{
+    gfx.startWrite();
+    for (uint16_t i = 0 ; i < _count ; i++) execute(i, gfx);
+    gfx.endWrite();
+}
+
+/**
+ * @brief Executes a single command. The caller must have called
+ * gfx.startWrite() before (and gfx.endWrite() after).
+ */
+void DrawList::execute(uint16_t index, Adafruit_GFX& gfx) const
+{
+    const DrawCommand& c = _commands[index];
+    const int16_t* a = c.arg;
+    switch (c.op)
+    {
+        case DRAW_OP_FILL_SCREEN:
+            gfx.writeFillRect(0, 0, gfx.width(), gfx.height(), c.color);
+            break;
+        case DRAW_OP_PIXEL:
+            gfx.writePixel(a[0], a[1], c.color);
+            break;
+        case DRAW_OP_LINE:
+            _writeLine(gfx, a[0], a[1], a[2], a[3], c.color);
+            break;
+        case DRAW_OP_HLINE:
+            gfx.writeFastHLine(a[0], a[1], a[2], c.color);
+            break;
+        case DRAW_OP_VLINE:
+            gfx.writeFastVLine(a[0], a[1], a[2], c.color);
+            break;
+        case DRAW_OP_RECT:
+            gfx.writeFastHLine(a[0], a[1], a[2], c.color);
+            gfx.writeFastHLine(a[0], a[1] + a[3] - 1, a[2], c.color);
+            gfx.writeFastVLine(a[0], a[1], a[3], c.color);
+            gfx.writeFastVLine(a[0] + a[2] - 1, a[1], a[3], c.color);
+            break;
+        case DRAW_OP_FILL_RECT:
+            gfx.writeFillRect(a[0], a[1], a[2], a[3], c.color);
+            break;
+        case DRAW_OP_CIRCLE:
+            gfx.writePixel(a[0], a[1] + a[2], c.color);
+            gfx.writePixel(a[0], a[1] - a[2], c.color);
+            gfx.writePixel(a[0] + a[2], a[1], c.color);
+            gfx.writePixel(a[0] - a[2], a[1], c.color);
+            _drawCircleQuarters(gfx, a[0], a[1], a[2], 0xF, c.color);
+            break;
+        case DRAW_OP_FILL_CIRCLE:
+            gfx.writeFastHLine(a[0] - a[2], a[1], 2 * a[2] + 1, c.color);
+            _fillCircleSpans(gfx, a[0], a[1], a[2], 3, 0, c.color);
+            break;
+        case DRAW_OP_ROUND_RECT:
+        {
+            int16_t x = a[0], y = a[1], w = a[2], h = a[3], r = a[4];
+            int16_t max_radius = ((w < h) ? w : h) / 2;
+            if (r > max_radius) r = max_radius;
+            gfx.writeFastHLine(x + r, y, w - 2 * r, c.color);
+            gfx.writeFastHLine(x + r, y + h - 1, w - 2 * r, c.color);
+            gfx.writeFastVLine(x, y + r, h - 2 * r, c.color);
+            gfx.writeFastVLine(x + w - 1, y + r, h - 2 * r, c.color);
+            _drawCircleQuarters(gfx, x + r, y + r, r, 1, c.color);
+            _drawCircleQuarters(gfx, x + w - r - 1, y + r, r, 2, c.color);
+            _drawCircleQuarters(gfx, x + w - r - 1, y + h - r - 1, r, 4, c.color);
+            _drawCircleQuarters(gfx, x + r, y + h - r - 1, r, 8, c.color);
+            break;
+        }
+        case DRAW_OP_FILL_ROUND_RECT:
+        {
+            int16_t x = a[0], y = a[1], w = a[2], h = a[3], r = a[4];
+            int16_t max_radius = ((w < h) ? w : h) / 2;
+            if (r > max_radius) r = max_radius;
+            gfx.writeFillRect(x, y + r, w, h - 2 * r, c.color);
+            _fillCircleSpans(gfx, x + r, y + r, r, 2, w - 2 * r - 1, c.color);
+            _fillCircleSpans(gfx, x + r, y + h - r - 1, r, 1, w - 2 * r - 1, c.color);
+            break;
+        }
+        case DRAW_OP_TRIANGLE:
+            _writeLine(gfx, a[0], a[1], a[2], a[3], c.color);
+            _writeLine(gfx, a[2], a[3], a[4], a[5], c.color);
+            _writeLine(gfx, a[4], a[5], a[0], a[1], c.color);
+            break;
+        case DRAW_OP_FILL_TRIANGLE:
+            _fillTriangle(gfx, a[0], a[1], a[2], a[3], a[4], a[5], c.color);
+            break;
+        case DRAW_OP_TEXT:
+        {
+            const char* text;
+            memcpy(&text, &a[2], sizeof(text));
+            // drawChar() opens its own transaction, it can't be nested in ours
+            gfx.endWrite();
+            int16_t x = a[0], y = a[1];
+            for (; *text ; text++)
+            {
+                if (*text == '\n')
+                {
+                    x = a[0];
+                    y += 8 * c.param;
+                    continue;
+                }
+                // Same fg and bg means transparent background
+                gfx.drawChar(x, y, *text, c.color, c.color, c.param);
+                x += 6 * c.param;
+            }
+            gfx.startWrite();
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Rows covered by a command, used to skip the ones outside a band.
+ * @param y0 First row (output).
+ * @param y1 Last row (output).
+ */
+void DrawList::getRows(uint16_t index, int16_t& y0, int16_t& y1) const
+{
+    const DrawCommand& c = _commands[index];
+    const int16_t* a = c.arg;
+    switch (c.op)
+    {
+        case DRAW_OP_PIXEL:
+        case DRAW_OP_HLINE:
+            y0 = y1 = a[1];
+            break;
+        case DRAW_OP_LINE:
+            y0 = min(a[1], a[3]);
+            y1 = max(a[1], a[3]);
+            break;
+        case DRAW_OP_VLINE:
+            y0 = a[1];
+            y1 = a[1] + a[2] - 1;
+            break;
+        case DRAW_OP_RECT:
+        case DRAW_OP_FILL_RECT:
+        case DRAW_OP_ROUND_RECT:
+        case DRAW_OP_FILL_ROUND_RECT:
+            y0 = a[1];
+            y1 = a[1] + a[3] - 1;
+            break;
+        case DRAW_OP_CIRCLE:
+        case DRAW_OP_FILL_CIRCLE:
+            y0 = a[1] - a[2];
+            y1 = a[1] + a[2];
+            break;
+        case DRAW_OP_TRIANGLE:
+        case DRAW_OP_FILL_TRIANGLE:
+            y0 = min(a[1], min(a[3], a[5]));
+            y1 = max(a[1], max(a[3], a[5]));
+            break;
+        case DRAW_OP_TEXT:
+            // Multi-line text goes down to the bottom, not worth counting lines
+            y0 = a[1];
+            y1 = INT16_MAX;
+            break;
+        default:
+            y0 = INT16_MIN;
+            y1 = INT16_MAX;
+            break;
+    }
+}
+
+// Appends a command to the list
+bool DrawList::_push(uint8_t op, uint16_t color, int16_t a0, int16_t a1, int16_t a2, int16_t a3, int16_t a4, int16_t a5)
+{
+    if (_count >= _capacity)
+    {
+        _overflow = true;
+        return false;
+    }
+    DrawCommand& c = _commands[_count++];
+    c.op = op;
+    c.param = 0;
+    c.color = color;
+    c.arg[0] = a0;
+    c.arg[1] = a1;
+    c.arg[2] = a2;
+    c.arg[3] = a3;
+    c.arg[4] = a4;
+    c.arg[5] = a5;
+    return true;
+}
@@ -0,0 +1,146 @@
+#ifndef DRAW_LIST_H
+#define DRAW_LIST_H
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+
+/**
+ * @brief Operation codes stored in a DrawList.
+ */
+enum DrawOp : uint8_t {
+    DRAW_OP_FILL_SCREEN,
+    DRAW_OP_PIXEL,
+    DRAW_OP_LINE,
+    DRAW_OP_HLINE,
+    DRAW_OP_VLINE,
+    DRAW_OP_RECT,
+    DRAW_OP_FILL_RECT,
+    DRAW_OP_CIRCLE,
+    DRAW_OP_FILL_CIRCLE,
+    DRAW_OP_ROUND_RECT,
+    DRAW_OP_FILL_ROUND_RECT,
+    DRAW_OP_TRIANGLE,
+    DRAW_OP_FILL_TRIANGLE,
+    DRAW_OP_TEXT
+};
+
+/**
+ * @brief One recorded primitive (16 bytes, no heap).
+ */
+struct DrawCommand {
+    uint8_t op;
+    uint8_t param;      // Extra small argument (text size)
+    uint16_t color;
+    int16_t arg[6];
+};
+
+/**
+ * @brief Records a sequence of drawing primitives in a fixed-capacity buffer
+ * so they can be executed later in a single bus transaction.
+ * Storage is given by the caller, use StaticDrawList<N> for an owned buffer.
+ * Every shape is rasterized with the Adafruit "write" primitives only (pixels,
+ * spans and rects), so the whole list runs inside ONE startWrite()/endWrite().
+ */
+class DrawList {
+
+    public:
+
+        /**
+         * @brief Constructor.
+         * @param storage Array where commands will be recorded.
+         * @param capacity Number of commands that fit in the array.
+         */
+        DrawList(DrawCommand* storage, uint16_t capacity);
+
+        // --- Recording (return false if the list is full) ---
+
+        // fillScreen() drops everything recorded before, it would be covered anyway
+        bool fillScreen(uint16_t color);
+        bool drawPixel(int16_t x, int16_t y, uint16_t color);
+        bool drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+        bool drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+        bool drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+        bool drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+        bool fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+        bool drawCircle(int16_t x, int16_t y, int16_t r, uint16_t color);
+        bool fillCircle(int16_t x, int16_t y, int16_t r, uint16_t color);
+        bool drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color);
+        bool fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color);
+        bool drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color);
+        bool fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color);
+        // Only the pointer is stored: the text must still exist when the list is executed
+        bool drawText(int16_t x, int16_t y, const char* text, uint16_t color, uint8_t size = 1);
+
+        // --- Management ---
+
+        /**
+         * @brief Removes all the recorded commands.
+         */
+        void clear();
+
+        /**
+         * @brief Number of recorded commands.
+         */
+        uint16_t size() const;
+
+        /**
+         * @brief Maximum number of commands.
+         */
+        uint16_t capacity() const;
+
+        /**
+         * @brief True if some command was dropped because the list was full.
+         */
+        bool overflowed() const;
+
+        // --- Execution ---
+
+        /**
+         * @brief Executes every command on a surface inside one write transaction.
+         * The caller must own the bus (see DisplayHandler::submit()).
+         */
+        void replay(Adafruit_GFX& gfx) const;
+
+        /**
+         * @brief Executes a single command. The caller must have called
+         * gfx.startWrite() before (and gfx.endWrite() after).
+         */
+        void execute(uint16_t index, Adafruit_GFX& gfx) const;
+
+        /**
+         * @brief Rows covered by a command, used to skip the ones outside a band.
+         * @param y0 First row (output).
+         * @param y1 Last row (output).
+         */
+        void getRows(uint16_t index, int16_t& y0, int16_t& y1) const;
+
+    private:
+
+        DrawCommand* _commands;
+        uint16_t _capacity;
+        uint16_t _count;
+        bool _overflow;
+
+        // Appends a command to the list
+        bool _push(uint8_t op, uint16_t color, int16_t a0 = 0, int16_t a1 = 0, int16_t a2 = 0, int16_t a3 = 0, int16_t a4 = 0, int16_t a5 = 0);
+
+};
+
+/**
+ * @brief DrawList with its own storage for N commands (16 bytes each).
+ * Declare it static or global for big N, the loop() stack is small.
+ */
+template <uint16_t N>
+class StaticDrawList : public DrawList {
+
+    public:
+
+        StaticDrawList() : DrawList(_storage, N) {}
+
+    private:
+
+        DrawCommand _storage[N];
+
+};
+
+#endif
@@ -0,0 +1,26 @@
+#include "Easing.h"
+
+/**
+ * @brief Applies an easing curve to the progress of an animation.
+ * @param t Progress in Q14 (0 = start, TRIG_ONE = end), clamped.
+ * @return Eased progress in Q14.
+ */
+int32_t ease(Easing curve, int32_t t)
+{
+    if (t <= 0) return 0;
+    if (t >= TRIG_ONE) return TRIG_ONE;
+    int32_t t2 = (t * t) >> TRIG_SHIFT;
+    switch (curve)
+    {
+        case EASE_IN:
+            return t2;
+        case EASE_OUT:
+            // 1 - (1 - t)^2
+            return 2 * t - t2;
+        case EASE_IN_OUT:
+            // 3t^2 - 2t^3 (in 64 bits, rounding t^2 first breaks monotonicity)
+            return (int32_t)(((int64_t)t * t * (3 * TRIG_ONE - 2 * t)) >> (2 * TRIG_SHIFT));
+        default:
+            return t;
+    }
+}
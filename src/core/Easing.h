@@ -0,0 +1,33 @@
+#ifndef EASING_H
+#define EASING_H
+
+#include <Arduino.h>
+#include "./FixedTrig.h"
+
+/**
+ * @brief Speed profile of an animation.
+ */
+enum Easing : uint8_t {
+    EASE_LINEAR,    // Constant speed
+    EASE_IN,        // Starts slow (quadratic)
+    EASE_OUT,       // Ends slow (quadratic)
+    EASE_IN_OUT     // Starts and ends slow (smoothstep)
+};
+
+/**
+ * @brief Applies an easing curve to the progress of an animation.
+ * @param t Progress in Q14 (0 = start, TRIG_ONE = end), clamped.
+ * @return Eased progress in Q14.
+ */
+int32_t ease(Easing curve, int32_t t);
+
+/**
+ * @brief Linear interpolation between two integers.
+ * @param t Progress in Q14 (see ease()).
+ */
+inline int16_t lerp16(int16_t from, int16_t to, int32_t t)
+{
+    return from + (int16_t)(((int32_t)(to - from) * t) >> TRIG_SHIFT);
+}
+
+#endif
@@ -0,0 +1,87 @@
+#include "EmojiAtlas.h"
+#include "EmojiData.h"
+
+static_assert(EMOJI_MAX_WIDTH <= EMOJI_MAX_SIDE, "Emoji atlas has icons wider than EMOJI_MAX_SIDE");
+
+/**
+ * @brief Finds an icon by name.
+ * @return NULL if there is no icon with that name.
+ */
+const EmojiInfo* EmojiAtlas::find(const char* name)
+{
+    int8_t index = emoji_slots[hash(name, EMOJI_HASH_SEED) & (EMOJI_HASH_SIZE - 1)];
+    // Every name has its own slot, unknown names land on an empty one or on another name
+    if (index < 0 || strcmp(emoji_table[index].name, name) != 0) return NULL;
+    return &emoji_table[index];
+}
+
+/**
+ * @brief Number of icons in the atlas.
+ */
+uint8_t EmojiAtlas::count()
+{
+    return EMOJI_COUNT;
+}
+
+/**
+ * @brief Gets an icon by position (0 to count() - 1), to list them.
+ */
+const EmojiInfo* EmojiAtlas::get(uint8_t index)
+{
+    return (index < EMOJI_COUNT) ? &emoji_table[index] : NULL;
+}
+
+/**
+ * @brief Hash used to place the names (FNV-1a with seed and a final mix).
+ */
+uint32_t EmojiAtlas::hash(const char* name, uint32_t seed)
+{
+    uint32_t h = 2166136261u ^ seed;
+    while (*name) h = (h ^ (uint8_t)*name++) * 16777619u;
+    // Final mix, so the low bits used for the slot depend on every character
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+    return h;
+}
+
+/**
+ * @brief Gets ready to decode an icon from its first row.
+ * @param background Color of the transparent pixels (CPU byte order).
+ */
+EmojiDecoder::EmojiDecoder(const EmojiInfo& emoji, uint16_t background)
+{
+    _src = &emoji_rle[emoji.data];
+    memset(_palette, 0, sizeof(_palette));
+    _palette[0] = __builtin_bswap16(background);
+    for (uint8_t i = 0 ; i < emoji.colors && i < 15 ; i++)
+        _palette[i + 1] = __builtin_bswap16(emoji_palette[emoji.palette + i]);
+    _run = 0;
+    _index = 0;
+    _width = emoji.width;
+}
+
+/**
+ * @brief Decodes the next row.
+ * @param dst Buffer for width pixels (big-endian RGB565).
+ */
+void EmojiDecoder::nextRow(uint16_t* dst)
+{
+    uint8_t col = 0;
+    while (col < _width)
+    {
+        // Runs go on from one row to the next
+        if (_run == 0)
+        {
+            uint8_t code = *_src++;
+            _index = code >> 4;
+            _run = (code & 0x0F) + 1;
+            if (_run == 16) _run += *_src++;
+        }
+        uint16_t color = _palette[_index];
+        uint16_t n = min((uint16_t)(_width - col), _run);
+        for (uint16_t i = 0 ; i < n ; i++) dst[col + i] = color;
+        col += n;
+        _run -= n;
+    }
+}
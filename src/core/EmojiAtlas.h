@@ -0,0 +1,84 @@
+#ifndef EMOJI_ATLAS_H
+#define EMOJI_ATLAS_H
+
+#include <Arduino.h>
+
+// Widest icon accepted (one row is decoded on the stack)
+#define EMOJI_MAX_SIDE 64
+
+/**
+ * @brief One icon of the atlas (see EmojiData.h, made by
+ * extras/tools/make_emoji_atlas.py).
+ */
+struct EmojiInfo {
+    const char* name;
+    uint8_t width;
+    uint8_t height;
+    uint8_t colors;     // Palette entries (index 0 of the RLE is transparent)
+    uint16_t palette;   // First entry in the shared palette
+    uint32_t data;      // Offset of the RLE in the shared data
+};
+
+/**
+ * @brief Built-in icons stored in the program flash as indexed-palette RLE.
+ * Names are found with a perfect hash made by the generator: one hash and one
+ * string compare, whatever the number of icons.
+ */
+class EmojiAtlas {
+
+    public:
+
+        /**
+         * @brief Finds an icon by name.
+         * @return NULL if there is no icon with that name.
+         */
+        static const EmojiInfo* find(const char* name);
+
+        /**
+         * @brief Number of icons in the atlas.
+         */
+        static uint8_t count();
+
+        /**
+         * @brief Gets an icon by position (0 to count() - 1), to list them.
+         */
+        static const EmojiInfo* get(uint8_t index);
+
+        /**
+         * @brief Hash used to place the names (FNV-1a with seed and a final mix).
+         */
+        static uint32_t hash(const char* name, uint32_t seed);
+
+};
+
+/**
+ * @brief Expands an icon row by row straight from the flash: only the palette
+ * (32 bytes) and the position in the RLE are kept.
+ */
+class EmojiDecoder {
+
+    public:
+
+        /**
+         * @brief Gets ready to decode an icon from its first row.
+         * @param background Color of the transparent pixels (CPU byte order).
+         */
+        EmojiDecoder(const EmojiInfo& emoji, uint16_t background);
+
+        /**
+         * @brief Decodes the next row.
+         * @param dst Buffer for width pixels (big-endian RGB565).
+         */
+        void nextRow(uint16_t* dst);
+
+    private:
+
+        const uint8_t* _src;
+        uint16_t _palette[16];  // Already swapped, [0] = background
+        uint16_t _run;          // Pixels left of the current run
+        uint8_t _index;         // Its palette index
+        uint8_t _width;
+
+};
+
+#endif
@@ -0,0 +1,161 @@
+// Generated by extras/tools/make_emoji_atlas.py, do not edit
+// 15 icons, 1998 bytes of RLE (30720 as raw RGB565)
+
+#define EMOJI_COUNT 15
+#define EMOJI_HASH_SIZE 16
+#define EMOJI_HASH_SEED 7100u
+#define EMOJI_MAX_WIDTH 32
+
+static const int8_t emoji_slots[EMOJI_HASH_SIZE] = { 13, 12, 8, 7, 5, 1, 2, 14, 11, 4, 9, 3, 10, 6, 0, -1 };
+
+static const uint16_t emoji_palette[] = {
+    0x5981, 0xFE60, 0x5981, 0xFE60, 0x7E5F, 0x5981, 0xFE60, 0xFFFF, 0xE0E5, 0xE0E5, 0xFFFF, 0xFC60,
+    0xFE60, 0xFC60, 0xFE60, 0xADB7, 0xFFFF, 0xADB7, 0xFFFF, 0x2BDC, 0x2DE7, 0xFFFF, 0xE0E5, 0xFFFF,
+    0x0000, 0xFE60, 0x0000, 0xFFFF, 0x2DE7, 0x2BDC, 0x0000, 0x2BDC, 0xFFFF,
+};
+
+static const uint8_t emoji_rle[] = {
+    0x0F, 0x1C, 0x17, 0x0F, 0x05, 0x12, 0x27, 0x12, 0x0F, 0x01, 0x11, 0x2B, 0x11, 0x0D, 0x11, 0x2F,
+    0x00, 0x11, 0x0A, 0x11, 0x2F, 0x02, 0x11, 0x08, 0x11, 0x2F, 0x04, 0x11, 0x07, 0x10, 0x2F, 0x06,
+    0x10, 0x06, 0x10, 0x2F, 0x08, 0x10, 0x04, 0x11, 0x25, 0x11, 0x27, 0x11, 0x25, 0x11, 0x03, 0x10,
+    0x25, 0x13, 0x25, 0x13, 0x25, 0x10, 0x03, 0x10, 0x25, 0x13, 0x25, 0x13, 0x25, 0x10, 0x02, 0x10,
+    0x26, 0x13, 0x25, 0x13, 0x26, 0x10, 0x01, 0x10, 0x26, 0x13, 0x25, 0x13, 0x26, 0x10, 0x01, 0x10,
+    0x27, 0x11, 0x27, 0x11, 0x27, 0x10, 0x01, 0x10, 0x2F, 0x0C, 0x10, 0x01, 0x10, 0x2F, 0x0C, 0x10,
+    0x01, 0x10, 0x2F, 0x0C, 0x10, 0x01, 0x10, 0x2F, 0x0C, 0x10, 0x01, 0x10, 0x25, 0x11, 0x2B, 0x11,
+    0x25, 0x10, 0x02, 0x10, 0x23, 0x12, 0x2B, 0x12, 0x23, 0x10, 0x03, 0x10, 0x24, 0x12, 0x29, 0x12,
+    0x24, 0x10, 0x03, 0x11, 0x24, 0x12, 0x27, 0x12, 0x24, 0x11, 0x04, 0x10, 0x25, 0x1B, 0x25, 0x10,
+    0x06, 0x10, 0x25, 0x19, 0x25, 0x10, 0x07, 0x11, 0x26, 0x15, 0x26, 0x11, 0x08, 0x11, 0x2F, 0x02,
+    0x11, 0x0A, 0x11, 0x2F, 0x00, 0x11, 0x0D, 0x11, 0x2B, 0x11, 0x0F, 0x01, 0x12, 0x27, 0x12, 0x0F,
+    0x05, 0x17, 0x0F, 0x1C, 0x0F, 0x1C, 0x17, 0x0F, 0x05, 0x12, 0x27, 0x12, 0x0F, 0x01, 0x11, 0x2B,
+    0x11, 0x0D, 0x11, 0x2F, 0x00, 0x11, 0x0A, 0x11, 0x2F, 0x02, 0x11, 0x08, 0x11, 0x2F, 0x04, 0x11,
+    0x07, 0x10, 0x2F, 0x06, 0x10, 0x06, 0x10, 0x2F, 0x08, 0x10, 0x04, 0x11, 0x25, 0x11, 0x27, 0x11,
+    0x25, 0x11, 0x03, 0x10, 0x25, 0x13, 0x25, 0x13, 0x25, 0x10, 0x03, 0x10, 0x25, 0x13, 0x25, 0x13,
+    0x25, 0x10, 0x02, 0x10, 0x26, 0x13, 0x25, 0x13, 0x26, 0x10, 0x01, 0x10, 0x26, 0x13, 0x25, 0x13,
+    0x26, 0x10, 0x01, 0x10, 0x27, 0x11, 0x27, 0x11, 0x27, 0x10, 0x01, 0x10, 0x25, 0x31, 0x2F, 0x04,
+    0x10, 0x01, 0x10, 0x25, 0x31, 0x2F, 0x04, 0x10, 0x01, 0x10, 0x24, 0x33, 0x2F, 0x03, 0x10, 0x01,
+    0x10, 0x24, 0x33, 0x2F, 0x03, 0x10, 0x01, 0x10, 0x23, 0x35, 0x20, 0x15, 0x2A, 0x10, 0x02, 0x10,
+    0x23, 0x33, 0x19, 0x27, 0x10, 0x03, 0x10, 0x23, 0x33, 0x1A, 0x26, 0x10, 0x03, 0x11, 0x24, 0x12,
+    0x27, 0x12, 0x24, 0x11, 0x04, 0x10, 0x23, 0x12, 0x29, 0x12, 0x23, 0x10, 0x06, 0x10, 0x23, 0x10,
+    0x2B, 0x10, 0x23, 0x10, 0x07, 0x11, 0x2F, 0x04, 0x11, 0x08, 0x11, 0x2F, 0x02, 0x11, 0x0A, 0x11,
+    0x2F, 0x00, 0x11, 0x0D, 0x11, 0x2B, 0x11, 0x0F, 0x01, 0x12, 0x27, 0x12, 0x0F, 0x05, 0x17, 0x0F,
+    0x1C, 0x0F, 0x1C, 0x17, 0x0F, 0x05, 0x12, 0x27, 0x12, 0x0F, 0x01, 0x11, 0x2B, 0x11, 0x0D, 0x11,
+    0x2F, 0x00, 0x11, 0x0A, 0x11, 0x2F, 0x02, 0x11, 0x08, 0x11, 0x2F, 0x04, 0x11, 0x07, 0x10, 0x2F,
+    0x06, 0x10, 0x06, 0x10, 0x2F, 0x08, 0x10, 0x04, 0x11, 0x2F, 0x08, 0x11, 0x03, 0x10, 0x25, 0x13,
+    0x25, 0x13, 0x25, 0x10, 0x03, 0x10, 0x24, 0x15, 0x23, 0x15, 0x24, 0x10, 0x02, 0x10, 0x25, 0x10,
+    0x23, 0x10, 0x23, 0x10, 0x23, 0x10, 0x25, 0x10, 0x01, 0x10, 0x2F, 0x0C, 0x10, 0x01, 0x10, 0x2F,
+    0x0C, 0x10, 0x01, 0x10, 0x2F, 0x0C, 0x10, 0x01, 0x10, 0x23, 0x10, 0x3F, 0x02, 0x10, 0x23, 0x10,
+    0x01, 0x10, 0x24, 0x3F, 0x02, 0x24, 0x10, 0x01, 0x10, 0x24, 0x3F, 0x02, 0x24, 0x10, 0x01, 0x10,
+    0x24, 0x11, 0x4D, 0x11, 0x24, 0x10, 0x02, 0x10, 0x23, 0x11, 0x4D, 0x11, 0x23, 0x10, 0x03, 0x10,
+    0x24, 0x11, 0x4B, 0x11, 0x24, 0x10, 0x03, 0x11, 0x24, 0x11, 0x49, 0x11, 0x24, 0x11, 0x04, 0x10,
+    0x25, 0x11, 0x47, 0x11, 0x25, 0x10, 0x06, 0x10, 0x25, 0x19, 0x25, 0x10, 0x07, 0x11, 0x26, 0x15,
+    0x26, 0x11, 0x08, 0x11, 0x2F, 0x02, 0x11, 0x0A, 0x11, 0x2F, 0x00, 0x11, 0x0D, 0x11, 0x2B, 0x11,
+    0x0F, 0x01, 0x12, 0x27, 0x12, 0x0F, 0x05, 0x17, 0x0F, 0x1C, 0x0F, 0x78, 0x14, 0x05, 0x14, 0x0D,
+    0x18, 0x01, 0x18, 0x0A, 0x1F, 0x06, 0x08, 0x1F, 0x08, 0x07, 0x12, 0x23, 0x1F, 0x01, 0x06, 0x13,
+    0x23, 0x1F, 0x02, 0x05, 0x1F, 0x0A, 0x05, 0x1F, 0x0A, 0x05, 0x1F, 0x0A, 0x05, 0x1F, 0x0A, 0x06,
+    0x1F, 0x08, 0x07, 0x1F, 0x08, 0x08, 0x1F, 0x06, 0x0A, 0x1F, 0x04, 0x0C, 0x1F, 0x02, 0x0E, 0x1F,
+    0x00, 0x0F, 0x01, 0x1D, 0x0F, 0x03, 0x1B, 0x0F, 0x05, 0x19, 0x0F, 0x07, 0x17, 0x0F, 0x09, 0x15,
+    0x0F, 0x0A, 0x15, 0x0F, 0x0B, 0x13, 0x0F, 0x0D, 0x11, 0x0F, 0x7F, 0x0F, 0x5F, 0x11, 0x0F, 0x0E,
+    0x11, 0x0F, 0x0E, 0x11, 0x0F, 0x0D, 0x10, 0x21, 0x10, 0x0F, 0x0C, 0x10, 0x21, 0x10, 0x0F, 0x0C,
+    0x10, 0x21, 0x10, 0x0F, 0x0B, 0x10, 0x23, 0x10, 0x0F, 0x0A, 0x10, 0x23, 0x10, 0x0F, 0x09, 0x11,
+    0x23, 0x11, 0x0F, 0x02, 0x16, 0x25, 0x16, 0x07, 0x11, 0x2F, 0x08, 0x11, 0x05, 0x10, 0x2F, 0x06,
+    0x10, 0x08, 0x10, 0x2F, 0x04, 0x10, 0x0A, 0x11, 0x2F, 0x00, 0x11, 0x0C, 0x11, 0x2D, 0x11, 0x0F,
+    0x00, 0x10, 0x2B, 0x10, 0x0F, 0x03, 0x10, 0x29, 0x10, 0x0F, 0x04, 0x10, 0x29, 0x10, 0x0F, 0x03,
+    0x10, 0x2B, 0x10, 0x0F, 0x02, 0x10, 0x2B, 0x10, 0x0F, 0x02, 0x10, 0x24, 0x11, 0x24, 0x10, 0x0F,
+    0x01, 0x10, 0x23, 0x11, 0x01, 0x11, 0x23, 0x10, 0x0F, 0x00, 0x10, 0x22, 0x11, 0x03, 0x11, 0x22,
+    0x10, 0x0F, 0x00, 0x10, 0x21, 0x10, 0x07, 0x10, 0x21, 0x10, 0x0F, 0x00, 0x12, 0x09, 0x12, 0x0E,
+    0x11, 0x0D, 0x11, 0x0D, 0x10, 0x0F, 0x00, 0x10, 0x0F, 0x37, 0x0E, 0x11, 0x0F, 0x0D, 0x12, 0x0F,
+    0x0D, 0x12, 0x0F, 0x0D, 0x12, 0x0F, 0x03, 0x12, 0x06, 0x12, 0x07, 0x12, 0x07, 0x13, 0x05, 0x12,
+    0x06, 0x13, 0x07, 0x14, 0x05, 0x11, 0x05, 0x14, 0x08, 0x14, 0x0B, 0x14, 0x0A, 0x13, 0x01, 0x17,
+    0x01, 0x13, 0x0C, 0x12, 0x00, 0x11, 0x25, 0x11, 0x00, 0x12, 0x0F, 0x01, 0x11, 0x27, 0x11, 0x0F,
+    0x03, 0x11, 0x29, 0x11, 0x0F, 0x01, 0x11, 0x2B, 0x11, 0x0F, 0x00, 0x10, 0x2D, 0x10, 0x0F, 0x00,
+    0x10, 0x2D, 0x10, 0x01, 0x14, 0x00, 0x16, 0x00, 0x10, 0x2D, 0x10, 0x00, 0x1D, 0x00, 0x10, 0x2D,
+    0x10, 0x00, 0x16, 0x00, 0x14, 0x01, 0x10, 0x2D, 0x10, 0x01, 0x14, 0x08, 0x10, 0x2D, 0x10, 0x0F,
+    0x00, 0x11, 0x2B, 0x11, 0x0F, 0x01, 0x11, 0x29, 0x11, 0x0F, 0x03, 0x11, 0x27, 0x11, 0x0F, 0x01,
+    0x12, 0x00, 0x11, 0x25, 0x11, 0x00, 0x12, 0x0C, 0x13, 0x01, 0x17, 0x01, 0x13, 0x0A, 0x14, 0x0B,
+    0x14, 0x08, 0x14, 0x05, 0x11, 0x05, 0x14, 0x07, 0x13, 0x06, 0x12, 0x05, 0x13, 0x07, 0x12, 0x07,
+    0x12, 0x06, 0x12, 0x0F, 0x03, 0x12, 0x0F, 0x0D, 0x12, 0x0F, 0x0D, 0x12, 0x0F, 0x0D, 0x11, 0x0E,
+    0x0F, 0xBF, 0x14, 0x0F, 0x09, 0x11, 0x24, 0x11, 0x0F, 0x05, 0x11, 0x28, 0x11, 0x0F, 0x03, 0x10,
+    0x2A, 0x10, 0x0F, 0x02, 0x10, 0x2C, 0x10, 0x0F, 0x01, 0x10, 0x2C, 0x10, 0x0F, 0x00, 0x10, 0x2E,
+    0x10, 0x0D, 0x11, 0x2E, 0x10, 0x0B, 0x11, 0x2F, 0x01, 0x12, 0x08, 0x11, 0x2F, 0x05, 0x10, 0x07,
+    0x10, 0x2F, 0x07, 0x10, 0x05, 0x10, 0x2F, 0x08, 0x10, 0x05, 0x10, 0x2F, 0x08, 0x10, 0x05, 0x10,
+    0x2F, 0x09, 0x10, 0x04, 0x10, 0x2F, 0x08, 0x10, 0x05, 0x10, 0x2F, 0x08, 0x10, 0x06, 0x10, 0x2F,
+    0x07, 0x10, 0x06, 0x11, 0x2F, 0x05, 0x10, 0x08, 0x11, 0x2F, 0x01, 0x12, 0x0B, 0x1F, 0x01, 0x0F,
+    0xB7, 0x0F, 0x1F, 0x14, 0x0F, 0x09, 0x11, 0x24, 0x11, 0x0F, 0x06, 0x10, 0x28, 0x10, 0x0F, 0x04,
+    0x10, 0x2A, 0x10, 0x0F, 0x03, 0x10, 0x2A, 0x10, 0x0F, 0x00, 0x12, 0x2C, 0x10, 0x0C, 0x11, 0x2F,
+    0x01, 0x12, 0x08, 0x11, 0x2F, 0x05, 0x10, 0x07, 0x10, 0x2F, 0x07, 0x10, 0x05, 0x10, 0x2F, 0x08,
+    0x10, 0x05, 0x10, 0x2F, 0x08, 0x10, 0x05, 0x10, 0x2F, 0x09, 0x10, 0x04, 0x10, 0x2F, 0x08, 0x10,
+    0x05, 0x10, 0x2F, 0x08, 0x10, 0x06, 0x10, 0x2F, 0x07, 0x10, 0x06, 0x11, 0x2F, 0x05, 0x10, 0x08,
+    0x11, 0x2F, 0x01, 0x12, 0x0B, 0x1F, 0x01, 0x0F, 0x40, 0x30, 0x05, 0x30, 0x05, 0x30, 0x0F, 0x00,
+    0x32, 0x03, 0x32, 0x03, 0x32, 0x0E, 0x31, 0x04, 0x31, 0x04, 0x31, 0x0F, 0x00, 0x31, 0x04, 0x31,
+    0x04, 0x31, 0x0E, 0x32, 0x03, 0x32, 0x03, 0x32, 0x0E, 0x31, 0x04, 0x31, 0x04, 0x31, 0x0F, 0x00,
+    0x31, 0x04, 0x31, 0x04, 0x31, 0x0E, 0x32, 0x03, 0x32, 0x03, 0x32, 0x0F, 0x00, 0x30, 0x05, 0x30,
+    0x05, 0x30, 0x0F, 0x3A, 0x0F, 0x1C, 0x17, 0x0F, 0x05, 0x1D, 0x0F, 0x01, 0x1F, 0x00, 0x0D, 0x1F,
+    0x04, 0x0A, 0x1F, 0x06, 0x08, 0x1F, 0x08, 0x07, 0x1F, 0x08, 0x06, 0x1F, 0x05, 0x20, 0x13, 0x04,
+    0x1F, 0x05, 0x22, 0x13, 0x03, 0x1F, 0x04, 0x24, 0x12, 0x03, 0x1F, 0x03, 0x24, 0x13, 0x02, 0x1F,
+    0x03, 0x24, 0x15, 0x01, 0x1F, 0x02, 0x24, 0x16, 0x01, 0x16, 0x20, 0x18, 0x25, 0x16, 0x01, 0x15,
+    0x22, 0x16, 0x25, 0x17, 0x01, 0x14, 0x24, 0x14, 0x25, 0x18, 0x01, 0x15, 0x24, 0x12, 0x25, 0x19,
+    0x01, 0x16, 0x24, 0x10, 0x25, 0x1A, 0x01, 0x17, 0x29, 0x1B, 0x02, 0x17, 0x27, 0x1B, 0x03, 0x18,
+    0x25, 0x1C, 0x03, 0x19, 0x23, 0x1D, 0x04, 0x19, 0x21, 0x1D, 0x06, 0x1F, 0x08, 0x07, 0x1F, 0x08,
+    0x08, 0x1F, 0x06, 0x0A, 0x1F, 0x04, 0x0D, 0x1F, 0x00, 0x0F, 0x01, 0x1D, 0x0F, 0x05, 0x17, 0x0F,
+    0x1C, 0x0F, 0x1C, 0x17, 0x0F, 0x05, 0x1D, 0x0F, 0x01, 0x1F, 0x00, 0x0D, 0x1F, 0x04, 0x0A, 0x1F,
+    0x06, 0x08, 0x1F, 0x08, 0x07, 0x1F, 0x08, 0x06, 0x16, 0x20, 0x19, 0x20, 0x16, 0x04, 0x16, 0x22,
+    0x17, 0x22, 0x16, 0x03, 0x15, 0x24, 0x15, 0x24, 0x15, 0x03, 0x16, 0x24, 0x13, 0x24, 0x16, 0x02,
+    0x18, 0x24, 0x11, 0x24, 0x18, 0x01, 0x19, 0x29, 0x19, 0x01, 0x1A, 0x27, 0x1A, 0x01, 0x1B, 0x25,
+    0x1B, 0x01, 0x1B, 0x25, 0x1B, 0x01, 0x1A, 0x27, 0x1A, 0x01, 0x19, 0x29, 0x19, 0x01, 0x18, 0x24,
+    0x11, 0x24, 0x18, 0x02, 0x16, 0x24, 0x13, 0x24, 0x16, 0x03, 0x15, 0x24, 0x15, 0x24, 0x15, 0x03,
+    0x16, 0x22, 0x17, 0x22, 0x16, 0x04, 0x16, 0x20, 0x19, 0x20, 0x16, 0x06, 0x1F, 0x08, 0x07, 0x1F,
+    0x08, 0x08, 0x1F, 0x06, 0x0A, 0x1F, 0x04, 0x0D, 0x1F, 0x00, 0x0F, 0x01, 0x1D, 0x0F, 0x05, 0x17,
+    0x0F, 0x1C, 0x0F, 0x3F, 0x11, 0x0F, 0x0E, 0x11, 0x0F, 0x0D, 0x13, 0x0F, 0x0C, 0x13, 0x0F, 0x0B,
+    0x11, 0x21, 0x11, 0x0F, 0x0A, 0x11, 0x21, 0x11, 0x0F, 0x09, 0x11, 0x23, 0x11, 0x0F, 0x08, 0x10,
+    0x24, 0x11, 0x0F, 0x07, 0x11, 0x21, 0x11, 0x21, 0x11, 0x0F, 0x05, 0x11, 0x21, 0x13, 0x21, 0x11,
+    0x0F, 0x04, 0x11, 0x21, 0x13, 0x21, 0x11, 0x0F, 0x03, 0x11, 0x22, 0x13, 0x22, 0x11, 0x0F, 0x02,
+    0x11, 0x22, 0x13, 0x22, 0x11, 0x0F, 0x01, 0x11, 0x23, 0x13, 0x23, 0x11, 0x0F, 0x00, 0x11, 0x23,
+    0x13, 0x23, 0x11, 0x0E, 0x11, 0x24, 0x13, 0x24, 0x11, 0x0D, 0x10, 0x25, 0x13, 0x24, 0x11, 0x0C,
+    0x11, 0x25, 0x13, 0x25, 0x11, 0x0A, 0x11, 0x27, 0x11, 0x27, 0x11, 0x09, 0x11, 0x2F, 0x02, 0x11,
+    0x08, 0x11, 0x28, 0x11, 0x28, 0x11, 0x07, 0x11, 0x27, 0x13, 0x27, 0x11, 0x06, 0x11, 0x28, 0x13,
+    0x28, 0x11, 0x05, 0x11, 0x29, 0x11, 0x29, 0x11, 0x04, 0x11, 0x2F, 0x08, 0x11, 0x03, 0x1F, 0x0C,
+    0x02, 0x1F, 0x0E, 0x0F, 0x51, 0x0F, 0xF1, 0x1F, 0x0C, 0x03, 0x1F, 0x0C, 0x03, 0x11, 0x2F, 0x08,
+    0x11, 0x03, 0x11, 0x2F, 0x08, 0x11, 0x03, 0x11, 0x21, 0x35, 0x20, 0x35, 0x20, 0x35, 0x21, 0x14,
+    0x00, 0x11, 0x21, 0x35, 0x20, 0x35, 0x20, 0x35, 0x21, 0x14, 0x00, 0x11, 0x21, 0x35, 0x20, 0x35,
+    0x20, 0x35, 0x21, 0x14, 0x00, 0x11, 0x21, 0x35, 0x20, 0x35, 0x20, 0x35, 0x21, 0x14, 0x00, 0x11,
+    0x21, 0x35, 0x20, 0x35, 0x20, 0x35, 0x21, 0x14, 0x00, 0x11, 0x21, 0x35, 0x20, 0x35, 0x20, 0x35,
+    0x21, 0x14, 0x00, 0x11, 0x21, 0x35, 0x20, 0x35, 0x20, 0x35, 0x21, 0x14, 0x00, 0x11, 0x21, 0x35,
+    0x20, 0x35, 0x20, 0x35, 0x21, 0x14, 0x00, 0x11, 0x2F, 0x08, 0x11, 0x03, 0x11, 0x2F, 0x08, 0x11,
+    0x03, 0x1F, 0x0C, 0x03, 0x1F, 0x0C, 0x0F, 0xF3, 0x0F, 0x99, 0x1D, 0x0F, 0x00, 0x1F, 0x02, 0x0B,
+    0x1F, 0x06, 0x07, 0x1F, 0x0A, 0x04, 0x17, 0x0B, 0x17, 0x02, 0x16, 0x0F, 0x00, 0x16, 0x00, 0x15,
+    0x0F, 0x04, 0x15, 0x00, 0x12, 0x0F, 0x08, 0x12, 0x02, 0x10, 0x07, 0x19, 0x07, 0x10, 0x0A, 0x1D,
+    0x0F, 0x00, 0x1F, 0x02, 0x0C, 0x1F, 0x04, 0x0B, 0x14, 0x09, 0x14, 0x0C, 0x12, 0x0B, 0x12, 0x0F,
+    0x85, 0x13, 0x0F, 0x0B, 0x15, 0x0F, 0x0A, 0x15, 0x0F, 0x09, 0x17, 0x0F, 0x09, 0x15, 0x0F, 0x0A,
+    0x15, 0x0F, 0x0B, 0x13, 0x0F, 0x3E, 0x0F, 0x49, 0x14, 0x0F, 0x07, 0x18, 0x0F, 0x03, 0x1C, 0x0D,
+    0x1F, 0x02, 0x0D, 0x1F, 0x02, 0x0D, 0x1C, 0x01, 0x12, 0x0D, 0x18, 0x05, 0x12, 0x0D, 0x14, 0x09,
+    0x12, 0x0D, 0x12, 0x0B, 0x12, 0x0D, 0x12, 0x0B, 0x12, 0x0D, 0x12, 0x0B, 0x12, 0x0D, 0x12, 0x0B,
+    0x12, 0x0D, 0x12, 0x0B, 0x12, 0x0D, 0x12, 0x0B, 0x12, 0x0D, 0x12, 0x0B, 0x12, 0x0D, 0x12, 0x0B,
+    0x12, 0x0D, 0x12, 0x05, 0x18, 0x0D, 0x12, 0x04, 0x19, 0x0D, 0x12, 0x04, 0x19, 0x0D, 0x12, 0x03,
+    0x1A, 0x07, 0x18, 0x04, 0x18, 0x07, 0x19, 0x04, 0x18, 0x07, 0x19, 0x05, 0x16, 0x07, 0x1A, 0x0F,
+    0x06, 0x18, 0x0F, 0x07, 0x18, 0x0F, 0x08, 0x16, 0x0F, 0x63, 0x0F, 0x1C, 0x17, 0x0F, 0x05, 0x1D,
+    0x0F, 0x01, 0x1F, 0x00, 0x0D, 0x1F, 0x04, 0x0A, 0x1F, 0x06, 0x08, 0x17, 0x27, 0x17, 0x07, 0x16,
+    0x29, 0x16, 0x06, 0x16, 0x2B, 0x16, 0x04, 0x17, 0x23, 0x13, 0x23, 0x17, 0x03, 0x16, 0x23, 0x15,
+    0x23, 0x16, 0x03, 0x16, 0x23, 0x15, 0x23, 0x16, 0x02, 0x17, 0x23, 0x15, 0x23, 0x17, 0x01, 0x1F,
+    0x0E, 0x01, 0x1F, 0x0E, 0x01, 0x1F, 0x0E, 0x01, 0x1F, 0x0E, 0x01, 0x1C, 0x23, 0x1C, 0x01, 0x1C,
+    0x23, 0x1C, 0x01, 0x1C, 0x23, 0x1C, 0x02, 0x1B, 0x23, 0x1B, 0x03, 0x1B, 0x23, 0x1B, 0x03, 0x1F,
+    0x0C, 0x04, 0x1F, 0x0A, 0x06, 0x19, 0x23, 0x19, 0x07, 0x19, 0x23, 0x19, 0x08, 0x18, 0x23, 0x18,
+    0x0A, 0x1F, 0x04, 0x0D, 0x1F, 0x00, 0x0F, 0x01, 0x1D, 0x0F, 0x05, 0x17, 0x0F, 0x1C,
+};
+
+static const EmojiInfo emoji_table[EMOJI_COUNT] = {
+    { "smile", 32, 32, 2, 0, 0 },
+    { "sad", 32, 32, 3, 2, 180 },
+    { "laugh", 32, 32, 4, 5, 369 },
+    { "heart", 32, 32, 2, 9, 554 },
+    { "star", 32, 32, 2, 11, 635 },
+    { "sun", 32, 32, 2, 13, 778 },
+    { "cloud", 32, 32, 2, 15, 944 },
+    { "rain", 32, 32, 3, 17, 1041 },
+    { "check", 32, 32, 2, 20, 1188 },
+    { "cross", 32, 32, 2, 22, 1313 },
+    { "warning", 32, 32, 2, 24, 1442 },
+    { "battery", 32, 32, 3, 26, 1589 },
+    { "wifi", 32, 32, 1, 29, 1704 },
+    { "music", 32, 32, 1, 30, 1782 },
+    { "question", 32, 32, 2, 31, 1882 },
+};
@@ -0,0 +1,188 @@
+#include "FaceRaster.h"
+
+// Integer division rounding down (towards minus infinity)
+static int32_t _divFloor(int32_t a, int32_t b)
+{
+    int32_t q = a / b;
+    if ((a % b != 0) && ((a < 0) != (b < 0))) q--;
+    return q;
+}
+
+// Integer division rounding up (towards plus infinity)
+static int32_t _divCeil(int32_t a, int32_t b)
+{
+    int32_t q = a / b;
+    if ((a % b != 0) && ((a < 0) == (b < 0))) q++;
+    return q;
+}
+
+// Clips the span [lo, hi] of row dy to the sector between angles a and b (b - a <= 180).
+// A point p is inside if it is at the left of ray a and at the right of ray b:
+// cross(A, p) >= 0 and cross(p, B) >= 0. Both are linear in dx for a fixed row.
+static bool _clipToSector(int32_t& lo, int32_t& hi, int32_t dy, int16_t ca, int16_t sa, int16_t cb, int16_t sb)
+{
+    // cA * dy - sA * dx >= 0
+    if (sa > 0) hi = min(hi, _divFloor((int32_t)ca * dy, sa));
+    else if (sa < 0) lo = max(lo, _divCeil((int32_t)ca * dy, sa));
+    else if ((int32_t)ca * dy < 0) return false;
+    // sB * dx - cB * dy >= 0
+    if (sb > 0) lo = max(lo, _divCeil((int32_t)cb * dy, sb));
+    else if (sb < 0) hi = min(hi, _divFloor((int32_t)cb * dy, sb));
+    else if ((int32_t)cb * dy > 0) return false;
+    return (lo <= hi);
+}
+
+// Annulus sector of at most 180 degrees (or the full ring)
+static void _annulusSector(DrawList& list, int16_t cx, int16_t cy, int16_t r, int16_t r_in, int16_t a, int16_t b, bool full, uint16_t color)
+{
+    int16_t ca = icos(a), sa = isin(a);
+    int16_t cb = icos(b), sb = isin(b);
+    // Rows covered by the sector: its corners, plus the top/bottom if it crosses them
+    int16_t y_lo = -r, y_hi = r;
+    if (!full)
+    {
+        int16_t ys[4] = {
+            (int16_t)(((int32_t)r * sa) >> TRIG_SHIFT), (int16_t)(((int32_t)r * sb) >> TRIG_SHIFT),
+            (int16_t)(((int32_t)r_in * sa) >> TRIG_SHIFT), (int16_t)(((int32_t)r_in * sb) >> TRIG_SHIFT)
+        };
+        y_lo = y_hi = ys[0];
+        for (uint8_t i = 1 ; i < 4 ; i++)
+        {
+            if (ys[i] < y_lo) y_lo = ys[i];
+            if (ys[i] > y_hi) y_hi = ys[i];
+        }
+        // 90 (bottom) and 270 (top) inside [a, b]
+        if ((((90 - a) % 360) + 360) % 360 <= b - a) y_hi = r;
+        if ((((270 - a) % 360) + 360) % 360 <= b - a) y_lo = -r;
+        // One row of margin for the rounding of the LUT
+        y_lo = max((int16_t)(y_lo - 1), (int16_t)-r);
+        y_hi = min((int16_t)(y_hi + 1), r);
+    }
+    int32_t r2 = (int32_t)r * r;
+    // Pixels closer than r_in - 1 are the hole
+    int32_t hole2 = (r_in > 0) ? (int32_t)(r_in - 1) * (r_in - 1) : -1;
+    for (int16_t dy = y_lo ; dy <= y_hi ; dy++)
+    {
+        int32_t dy2 = (int32_t)dy * dy;
+        int32_t xo = isqrt(r2 - dy2);
+        // Up to two spans per row: left and right of the hole
+        int32_t seg_lo[2], seg_hi[2];
+        uint8_t segs = 0;
+        if (hole2 - dy2 < 0)
+        {
+            seg_lo[0] = -xo;
+            seg_hi[0] = xo;
+            segs = 1;
+        } else {
+            int32_t xi = isqrt(hole2 - dy2);
+            if (xi >= xo) continue;
+            seg_lo[0] = -xo;
+            seg_hi[0] = -xi - 1;
+            seg_lo[1] = xi + 1;
+            seg_hi[1] = xo;
+            segs = 2;
+        }
+        for (uint8_t i = 0 ; i < segs ; i++)
+        {
+            int32_t lo = seg_lo[i], hi = seg_hi[i];
+            if (!full && !_clipToSector(lo, hi, dy, ca, sa, cb, sb)) continue;
+            list.drawFastHLine(cx + lo, cy + dy, hi - lo + 1, color);
+        }
+    }
+}
+
+/**
+ * @brief Filled ellipse, one span per row (incremental midpoint boundary).
+ * @param rx Horizontal radius.
+ * @param ry Vertical radius.
+ */
+void rasterFillEllipse(DrawList& list, int16_t x0, int16_t y0, int16_t rx, int16_t ry, uint16_t color)
+{
+    if (rx < 0 || ry < 0) return;
+    if (ry == 0)
+    {
+        list.drawFastHLine(x0 - rx, y0, 2 * rx + 1, color);
+        return;
+    }
+    // Half width of row y: biggest x with x^2 * ry^2 + y^2 * rx^2 <= rx^2 * ry^2.
+    // It only shrinks while y grows, so the whole ellipse costs rx + ry steps.
+    int64_t a2 = (int32_t)rx * rx;
+    int64_t b2 = (int32_t)ry * ry;
+    int64_t limit = a2 * b2;
+    int16_t x = rx;
+    for (int16_t y = 0 ; y <= ry ; y++)
+    {
+        int64_t y_term = (int64_t)y * y * a2;
+        while (x > 0 && (int64_t)x * x * b2 + y_term > limit) x--;
+        list.drawFastHLine(x0 - x, y0 + y, 2 * x + 1, color);
+        if (y) list.drawFastHLine(x0 - x, y0 - y, 2 * x + 1, color);
+    }
+}
+
+/**
+ * @brief Ellipse outline, made of the spans between the boundary of consecutive rows.
+ * @param rx Horizontal radius.
+ * @param ry Vertical radius.
+ */
+void rasterEllipse(DrawList& list, int16_t x0, int16_t y0, int16_t rx, int16_t ry, uint16_t color)
+{
+    if (rx < 0 || ry < 0) return;
+    int64_t a2 = (int32_t)rx * rx;
+    int64_t b2 = (int32_t)ry * ry;
+    int64_t limit = a2 * b2;
+    // From the top (x = 0) to the middle row (x = rx), x only grows
+    int16_t x = 0;
+    int16_t x_above = -1;
+    for (int16_t y = ry ; y >= 0 ; y--)
+    {
+        int64_t y_term = (int64_t)y * y * a2;
+        while (x < rx && (int64_t)(x + 1) * (x + 1) * b2 + y_term <= limit) x++;
+        // The border of this row goes from where the upper row ended to x
+        int16_t lo = min((int16_t)(x_above + 1), x);
+        for (int8_t side = (y ? -1 : 1) ; side <= 1 ; side += 2)
+        {
+            int16_t row = y0 + side * y;
+            if (lo == 0)
+            {
+                list.drawFastHLine(x0 - x, row, 2 * x + 1, color);
+            } else {
+                list.drawFastHLine(x0 - x, row, x - lo + 1, color);
+                list.drawFastHLine(x0 + lo, row, x - lo + 1, color);
+            }
+        }
+        x_above = x;
+    }
+}
+
+/**
+ * @brief Thick circular arc drawn as a filled annulus sector.
+ * Angles in degrees, 0 = right, growing clockwise on screen (y down).
+ * @param r Outer radius.
+ * @param thickness Width of the stroke towards the center (1 = thin arc).
+ * @param start First angle.
+ * @param end Last angle.
+ */
+void rasterArc(DrawList& list, int16_t x, int16_t y, int16_t r, uint8_t thickness, int16_t start, int16_t end, uint16_t color)
+{
+    // Draw a dot if radius is too small
+    if (r < 2)
+    {
+        list.drawPixel(x, y, color);
+        return;
+    }
+    if (thickness < 1) thickness = 1;
+    int16_t r_in = max(0, r - thickness + 1);
+    while (end < start) end += 360;
+    if (end - start >= 360)
+    {
+        _annulusSector(list, x, y, r, r_in, 0, 360, true, color);
+        return;
+    }
+    // The sector clip only works up to half a turn
+    if (end - start > 180)
+    {
+        _annulusSector(list, x, y, r, r_in, start, start + 180, false, color);
+        start += 180;
+    }
+    _annulusSector(list, x, y, r, r_in, start, end, false, color);
+}
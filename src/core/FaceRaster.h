@@ -0,0 +1,38 @@
+#ifndef FACE_RASTER_H
+#define FACE_RASTER_H
+
+#include <Arduino.h>
+#include "./DrawList.h"
+#include "./FixedTrig.h"
+
+/**
+ * @brief Face primitives rasterized with integer math only. Every shape is
+ * turned into horizontal spans recorded in a DrawList (one span per row and
+ * side), so there is no float, no sqrtf() and no sinf()/cosf() per frame.
+ */
+
+/**
+ * @brief Filled ellipse, one span per row (incremental midpoint boundary).
+ * @param rx Horizontal radius.
+ * @param ry Vertical radius.
+ */
+void rasterFillEllipse(DrawList& list, int16_t x0, int16_t y0, int16_t rx, int16_t ry, uint16_t color);
+
+/**
+ * @brief Ellipse outline, made of the spans between the boundary of consecutive rows.
+ * @param rx Horizontal radius.
+ * @param ry Vertical radius.
+ */
+void rasterEllipse(DrawList& list, int16_t x0, int16_t y0, int16_t rx, int16_t ry, uint16_t color);
+
+/**
+ * @brief Thick circular arc drawn as a filled annulus sector.
+ * Angles in degrees, 0 = right, growing clockwise on screen (y down).
+ * @param r Outer radius.
+ * @param thickness Width of the stroke towards the center (1 = thin arc).
+ * @param start First angle.
+ * @param end Last angle.
+ */
+void rasterArc(DrawList& list, int16_t x, int16_t y, int16_t r, uint8_t thickness, int16_t start, int16_t end, uint16_t color);
+
+#endif
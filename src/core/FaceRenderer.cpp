@@ -0,0 +1,177 @@
+#include "FaceRenderer.h"
+
+/**
+ * @brief Records one eye, its eyebrow and the background around it.
+ */
+void faceRenderEye(DrawList& list, const FaceEyeParams& p)
+{
+    uint16_t COLOR_BG = 0x0000;
+    uint16_t COLOR_FG = 0xFFFF;
+    int16_t current_h = p.height * p.open_factor;
+    if (current_h < 2) current_h = 2;
+    int16_t draw_x = p.x + p.pupil_x;
+    int16_t draw_y = p.y + p.pupil_y;
+    list.fillRect( p.x - (p.width / 2) - FACE_EYE_CLEAR, p.y - (p.height / 2) - FACE_EYE_CLEAR, p.width + 2 * FACE_EYE_CLEAR, p.height + 2 * FACE_EYE_CLEAR, COLOR_BG);
+    rasterFillEllipse(list, draw_x, draw_y, p.width / 2, current_h / 2, COLOR_FG);
+    int16_t brow_radius = (p.width / 2) + (p.width / 4);
+    int16_t brow_y = draw_y - brow_radius * 2 + 10;
+    if (p.has_eyebrown)
+    {
+        if (p.is_left_eye)
+        {
+            switch (p.eyebr_type)
+            {
+                case 1: list.fillCircle(draw_x - (p.width / 2), brow_y + 20, brow_radius, COLOR_BG); break;
+                case 2: list.fillTriangle(draw_x + (p.width / 2), draw_y, draw_x - p.width, draw_y - (p.height / 2), draw_x + (p.width / 2), draw_y - (p.height / 2), COLOR_BG); break;
+                case 3: list.fillCircle(draw_x, draw_y - (current_h / 5), p.width - (p.width / 3), COLOR_BG); break;
+            }
+        } else {
+            switch (p.eyebr_type)
+            {
+                case 1: list.fillCircle(draw_x + (p.width / 2), brow_y + 20, brow_radius, COLOR_BG); break;
+                case 2: list.fillTriangle(draw_x - (p.width / 2), draw_y, draw_x + p.width, draw_y - (p.height / 2), draw_x - (p.width / 2), draw_y - (p.height / 2), COLOR_BG); break;
+                case 3: list.fillCircle(draw_x, draw_y - (current_h / 5), p.width - (p.width / 3), COLOR_BG); break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Eye design of an emotion.
+ * @param is_left Left or right eye (eyebrows are mirrored).
+ */
+FaceEyeParams faceEyeParams(FaceEmotion emotion, bool is_left, int16_t pupil_x, int16_t pupil_y)
+{
+    // Basic configuration
+    FaceEyeParams eye = { (int16_t)(is_left ? FACE_CENTER_X - FACE_EYE_GAP : FACE_CENTER_X + FACE_EYE_GAP), FACE_EYE_Y, FACE_EYE_W, FACE_EYE_H, pupil_x, pupil_y, 20, 0.8, false, is_left, 0 };
+    // Apply actual emotion
+    switch (emotion)
+    {
+        case FACE_WORRY:
+            eye.open_factor = 0.8;
+            eye.eyebr_type = 1;
+            eye.has_eyebrown = true;
+            break;
+        case FACE_ANGRY:
+            eye.open_factor = 0.8;
+            eye.eyebr_type = 2;
+            eye.has_eyebrown = true;
+            break;
+        case FACE_HAPPY:
+            break;
+        case FACE_NEUTRAL:
+            break;
+        case FACE_SURPRISE:
+            eye.open_factor = 1.0;
+            break;
+        case FACE_SLEEPY:
+            eye.open_factor = is_left ? 0.4 : 0.3;
+            break;
+        case FACE_SAD:
+            eye.open_factor = 0.8;
+            eye.eyebr_type = 3;
+            eye.has_eyebrown = true;
+            break;
+        default:
+            break;
+    }
+    return eye;
+}
+
+/**
+ * @brief Records both eyes of an emotion.
+ * @param override_open Eye opening to use instead of the emotion one (negative = keep it).
+ */
+void faceRedrawEyes(DrawList& list, FaceEmotion emotion, int16_t pupil_x, int16_t pupil_y, float override_open)
+{
+    FaceEyeParams left  = faceEyeParams(emotion, true,  pupil_x, pupil_y);
+    FaceEyeParams right = faceEyeParams(emotion, false, pupil_x, pupil_y);
+    if (override_open >= 0) {
+        left.open_factor = override_open;
+        right.open_factor = override_open;
+    }
+    faceRenderEye(list, left);
+    faceRenderEye(list, right);
+}
+
+/**
+ * @brief Mouth design of an emotion.
+ */
+FaceMouthParams faceMouthParams(FaceEmotion e)
+{
+    FaceMouthParams mouth = { FACE_CENTER_X, FACE_MOUTH_Y, FACE_MOUTH_W, FACE_MOUTH_H, 3 };
+    // Apply actual emotion
+    switch (e) {
+        case FACE_WORRY:    mouth.shape = 0; break;
+        case FACE_ANGRY:    mouth.shape = 1; break;
+        case FACE_HAPPY:    mouth.shape = 2; break;
+        case FACE_NEUTRAL:  mouth.shape = 3; break;
+        case FACE_SURPRISE: mouth.shape = 4; break;
+        case FACE_SLEEPY:   mouth.shape = 5; break;
+        case FACE_SAD:      mouth.shape = 6; break;
+        default:            break;
+    }
+    return mouth;
+}
+
+// Mouth arcs shrink towards their middle when the mouth is narrower (transitions)
+static void _mouthArc(DrawList& list, const FaceMouthParams& p, int16_t center_y, int16_t start, int16_t end, uint16_t color)
+{
+    int16_t middle = (start + end) / 2;
+    int16_t half = (int32_t)((end - start) / 2) * p.width / FACE_MOUTH_W;
+    if (half > 0) rasterArc(list, p.x, center_y, 100, 10, middle - half, middle + half, color);
+}
+
+/**
+ * @brief Records the mouth (only its shape, the area is not cleared).
+ */
+void faceRenderMouth(DrawList& list, const FaceMouthParams& p)
+{
+    uint16_t COLOR_BG = 0x0000;
+    uint16_t COLOR_FG = 0xFFFF;
+    int16_t x0 = p.x - (p.width / 2);
+    int16_t y0 = p.y - (p.height / 2);
+    if (p.width <= 0) return;
+    switch (p.shape)
+    {
+        case 0: // Worry
+            _mouthArc(list, p, p.y + 80, 225, 315, COLOR_FG);
+            break;
+        case 1: // ANGRY
+            _mouthArc(list, p, p.y + 80, 240, 300, COLOR_FG);
+            break;
+        case 2: // HAPPY
+            _mouthArc(list, p, p.y - 80, 60, 120, COLOR_FG);
+            break;
+        case 3: // NEUTRAL
+            list.fillRoundRect(x0, y0, p.width, p.height, p.height / 2, COLOR_FG);
+            break;
+        case 4: // SURPRISE
+            list.fillRoundRect(x0, y0 - 30, p.width, 70, 20, COLOR_FG);
+            list.fillRect(x0, y0 + 25, p.width, 30, COLOR_BG);
+            break;
+        case 5: // SLEEPY
+            list.fillRoundRect(x0 + (p.width / 4), y0, p.width / 2, p.height, p.height / 2, COLOR_FG);
+            break;
+        case 6: // SAD
+            _mouthArc(list, p, p.y + 80, 225, 315, COLOR_FG);
+            break;
+    }
+}
+
+/**
+ * @brief Records one part of a face with the pupils centered
+ * (FACE_WHOLE clears the screen first).
+ */
+void faceRecordPart(DrawList& list, FaceEmotion e, FacePart part)
+{
+    if (part != FACE_WHOLE)
+    {
+        faceRedrawEyes(list, e, 0, 0, (part == FACE_EYES_CLOSED) ? FACE_BLINK : -1.0);
+        return;
+    }
+    // Clean the display
+    list.fillScreen(0x0000);
+    faceRenderMouth(list, faceMouthParams(e));
+    faceRedrawEyes(list, e, 0, 0);
+}
@@ -0,0 +1,110 @@
+#ifndef FACE_RENDERER_H
+#define FACE_RENDERER_H
+
+#include <Arduino.h>
+#include "./DrawList.h"
+#include "./FaceRaster.h"
+
+/**
+ * @brief Geometry of the robot face. Each part is recorded as primitives in a
+ * DrawList, so the same code draws on the panel, on the canvas, into the
+ * sprites and (see extras/host) into a plain RGB565 buffer on a computer.
+ */
+
+// Face layout (landscape screen)
+#define FACE_SCREEN_W  320
+#define FACE_SCREEN_H  240
+#define FACE_CENTER_X  160
+#define FACE_MOUTH_Y   190
+#define FACE_MOUTH_W   80
+#define FACE_MOUTH_H   10
+#define FACE_EYE_Y     85
+#define FACE_EYE_W     60
+#define FACE_EYE_H     110
+#define FACE_EYE_GAP   85
+#define FACE_EYE_CLEAR 20       // Background margin around each eye (max pupil shift)
+#define FACE_BLINK     0.1f     // Eye opening while blinking
+
+// Area cleared around both eyes
+#define FACE_EYES_X (FACE_CENTER_X - FACE_EYE_GAP - FACE_EYE_W / 2 - FACE_EYE_CLEAR)
+#define FACE_EYES_Y (FACE_EYE_Y - FACE_EYE_H / 2 - FACE_EYE_CLEAR)
+#define FACE_EYES_W (2 * FACE_EYE_GAP + FACE_EYE_W + 2 * FACE_EYE_CLEAR)
+#define FACE_EYES_H (FACE_EYE_H + 2 * FACE_EYE_CLEAR)
+// Area that holds every mouth shape (down to the bottom of the screen)
+#define FACE_MOUTH_AREA_X 80
+#define FACE_MOUTH_AREA_Y 150
+#define FACE_MOUTH_AREA_W 160
+#define FACE_MOUTH_AREA_H (FACE_SCREEN_H - FACE_MOUTH_AREA_Y)
+
+/**
+ * @brief Emotions of the face, same order as OrbitoRobot::ActionModule::Emotion.
+ */
+enum FaceEmotion : uint8_t { FACE_WORRY, FACE_ANGRY, FACE_HAPPY, FACE_NEUTRAL, FACE_SURPRISE, FACE_SLEEPY, FACE_SAD, FACE_EMOTIONS };
+
+/**
+ * @brief Parts of a face recorded by faceRecordPart() (pupils centered).
+ */
+enum FacePart : uint8_t { FACE_WHOLE, FACE_EYES_OPEN, FACE_EYES_CLOSED, FACE_PARTS };
+
+/**
+ * @brief Design of one eye (OrbitoRobot::ActionModule::EyeParams).
+ */
+struct FaceEyeParams {
+    int16_t x;            // Position X (Center)
+    int16_t y;            // Position Y (Center)
+    int16_t width;        // Eye total width
+    int16_t height;       // Eye total height
+    int16_t pupil_x;      // Position X pupil (-15 to 15)
+    int16_t pupil_y;      // Position Y pupil (-15 to 15)
+    int16_t margin;       // Size difference between Eye and Pupil
+    float open_factor;    // 0.0 (Close) a 1.0 (Open)
+    bool has_eyebrown;    // Flag to draw an eyebrown
+    bool is_left_eye;     // Flag to draw left or right eyebrown
+    uint8_t eyebr_type;   // ID of eyebrown type to draw
+};
+
+/**
+ * @brief Design of the mouth (OrbitoRobot::ActionModule::MouthParams).
+ */
+struct FaceMouthParams {
+    int16_t x;           // Position X (Center)
+    int16_t y;           // Position Y (Center)
+    int16_t width;       // Mouth total width
+    int16_t height;      // Mouth line thickness
+    int8_t shape;        // 0=Neutral, 1=Smile, 2=Sad, 3=Surprise
+};
+
+/**
+ * @brief Eye design of an emotion.
+ * @param is_left Left or right eye (eyebrows are mirrored).
+ */
+FaceEyeParams faceEyeParams(FaceEmotion emotion, bool is_left, int16_t pupil_x, int16_t pupil_y);
+
+/**
+ * @brief Mouth design of an emotion.
+ */
+FaceMouthParams faceMouthParams(FaceEmotion emotion);
+
+/**
+ * @brief Records one eye, its eyebrow and the background around it.
+ */
+void faceRenderEye(DrawList& list, const FaceEyeParams& p);
+
+/**
+ * @brief Records the mouth (only its shape, the area is not cleared).
+ */
+void faceRenderMouth(DrawList& list, const FaceMouthParams& p);
+
+/**
+ * @brief Records both eyes of an emotion.
+ * @param override_open Eye opening to use instead of the emotion one (negative = keep it).
+ */
+void faceRedrawEyes(DrawList& list, FaceEmotion emotion, int16_t pupil_x, int16_t pupil_y, float override_open = -1.0);
+
+/**
+ * @brief Records one part of a face with the pupils centered
+ * (FACE_WHOLE clears the screen first).
+ */
+void faceRecordPart(DrawList& list, FaceEmotion emotion, FacePart part);
+
+#endif
@@ -0,0 +1,61 @@
+#include "FixedTrig.h"
+
+// Quarter wave: sin(0..90 deg) in Q14. The other quadrants are mirrors.
+static const int16_t _sin_lut[91] = {
+    0, 286, 572, 857, 1143, 1428, 1713, 1997, 2280, 2563,
+    2845, 3126, 3406, 3686, 3964, 4240, 4516, 4790, 5063, 5334,
+    5604, 5872, 6138, 6402, 6664, 6924, 7182, 7438, 7692, 7943,
+    8192, 8438, 8682, 8923, 9162, 9397, 9630, 9860, 10087, 10311,
+    10531, 10749, 10963, 11174, 11381, 11585, 11786, 11982, 12176, 12365,
+    12551, 12733, 12911, 13085, 13255, 13421, 13583, 13741, 13894, 14044,
+    14189, 14330, 14466, 14598, 14726, 14849, 14968, 15082, 15191, 15296,
+    15396, 15491, 15582, 15668, 15749, 15826, 15897, 15964, 16026, 16083,
+    16135, 16182, 16225, 16262, 16294, 16322, 16344, 16362, 16374, 16382,
+    16384
+};
+
+/**
+ * @brief Sine of an angle in whole degrees (any value, negatives too).
+ * @return sin(deg) * TRIG_ONE.
+ */
+int16_t isin(int16_t deg)
+{
+    deg %= 360;
+    if (deg < 0) deg += 360;
+    if (deg <= 90) return _sin_lut[deg];
+    if (deg <= 180) return _sin_lut[180 - deg];
+    if (deg <= 270) return -_sin_lut[deg - 180];
+    return -_sin_lut[360 - deg];
+}
+
+/**
+ * @brief Cosine of an angle in whole degrees (any value, negatives too).
+ * @return cos(deg) * TRIG_ONE.
+ */
+int16_t icos(int16_t deg)
+{
+    return isin(deg + 90);
+}
+
+/**
+ * @brief Integer square root (floor).
+ */
+uint16_t isqrt(uint32_t value)
+{
+    // Digit by digit method, one result bit per iteration
+    uint32_t result = 0;
+    uint32_t bit = 1UL << 30;
+    while (bit > value) bit >>= 2;
+    while (bit)
+    {
+        if (value >= result + bit)
+        {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint16_t)result;
+}
@@ -0,0 +1,27 @@
+#ifndef FIXED_TRIG_H
+#define FIXED_TRIG_H
+
+#include <Arduino.h>
+
+// Fixed point format of the results: 1.0 = 16384 (Q14)
+#define TRIG_ONE   16384
+#define TRIG_SHIFT 14
+
+/**
+ * @brief Sine of an angle in whole degrees (any value, negatives too).
+ * @return sin(deg) * TRIG_ONE.
+ */
+int16_t isin(int16_t deg);
+
+/**
+ * @brief Cosine of an angle in whole degrees (any value, negatives too).
+ * @return cos(deg) * TRIG_ONE.
+ */
+int16_t icos(int16_t deg);
+
+/**
+ * @brief Integer square root (floor).
+ */
+uint16_t isqrt(uint32_t value);
+
+#endif
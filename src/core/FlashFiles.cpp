@@ -0,0 +1,574 @@
+#include "FlashFiles.h"
+
+// Signature at the start of a directory sector
+static const char FLASH_FILES_MAGIC[8] = { 'O', 'R', 'B', 'F', 'I', 'L', 'E', '1' };
+
+// First slot of a directory sector: signature and age. The newest copy has the
+// lowest sequence (the first one is blank, 0xFFFFFFFF, as in the single-sector layout)
+struct FlashFilesHeader {
+    char magic[sizeof(FLASH_FILES_MAGIC)];
+    uint32_t sequence;
+    uint8_t reserved[20];
+};
+static_assert(sizeof(FlashFilesHeader) == sizeof(FlashFileEntry), "The header takes one slot");
+
+// Sectors taken by a file of len bytes
+static inline uint32_t _sectorsFor(uint32_t len)
+{
+    return (len + W25Q_SECTOR_SIZE - 1) / W25Q_SECTOR_SIZE * W25Q_SECTOR_SIZE;
+}
+
+/**
+ * @brief Constructor.
+ * @param flash Flash chip (it must be started before begin()).
+ */
+FlashFiles::FlashFiles(FlashHandler* flash)
+{
+    _flash = flash;
+    _dir = NULL;
+    _dir_addr = FLASH_FILES_DIR;
+    _sequence = 0xFFFFFFFF;
+    _end = FLASH_FILES_END;
+    _mounted = false;
+    _writing = false;
+}
+
+/**
+ * @brief Reads the newest copy of the directory into RAM. A blank flash gets an
+ * empty one and the text of the old Storage (sector 0) is moved into
+ * FLASH_FILES_LEGACY. Anything else in sector 0 is left alone: nothing works
+ * until format(). Files cut by a reset are dropped, except the recoverable
+ * ones (they stay open for their owner, see FrameLog::recover()).
+ * @return False if the flash does not answer or no directory is recognized.
+ */
+bool FlashFiles::begin()
+{
+    FlashLock guard(*_flash);
+    // The capacity code of the JEDEC ID is the power of two of the size
+    uint32_t id = _flash->getJEDECID();
+    uint8_t capacity = id & 0xFF;
+    if (id == 0 || id == 0xFFFFFF) return false;
+    if (capacity >= 20 && capacity <= 24) _end = 1UL << capacity;
+    if (_end <= FLASH_FILES_START || !_reserveDirectory()) return false;
+    // A rewrite cut by a reset left its sector unsigned, the other copy is still good
+    bool found = false;
+    for (uint32_t addr = FLASH_FILES_DIR ; addr < FLASH_FILES_DIR_END ; addr += W25Q_SECTOR_SIZE)
+    {
+        FlashFilesHeader header;
+        _flash->read(addr, (uint8_t*)&header, sizeof(header));
+        if (memcmp(header.magic, FLASH_FILES_MAGIC, sizeof(header.magic)) != 0) continue;
+        if (found && header.sequence >= _sequence) continue;
+        found = true;
+        _dir_addr = addr;
+        _sequence = header.sequence;
+    }
+    if (!found) return _adopt();
+    // The signature slot is skipped
+    _flash->read(_dir_addr + sizeof(FlashFileEntry), (uint8_t*)_dir, FLASH_FILES_MAX * sizeof(FlashFileEntry));
+    _mounted = true;
+    // A write cut by a reset left its entry open: it never became a file
+    for (int16_t i = 0 ; i < (int16_t)FLASH_FILES_MAX ; i++)
+        if (_dir[i].state == FLASH_ENTRY_WRITING && _dir[i].flags != FLASH_FILE_RECOVERABLE) _setState(i, FLASH_ENTRY_DELETED);
+    return true;
+}
+
+/**
+ * @brief Empties the directory (whatever the directory sectors had). The data
+ * sectors are erased when reused.
+ */
+bool FlashFiles::format()
+{
+    FlashLock guard(*_flash);
+    if (!_reserveDirectory()) return false;
+    // The other copy is erased only if it is a directory (it may hold raw data of an old layout)
+    char magic[sizeof(FLASH_FILES_MAGIC)];
+    _flash->read(FLASH_FILES_DIR + W25Q_SECTOR_SIZE, (uint8_t*)magic, sizeof(magic));
+    if (memcmp(magic, FLASH_FILES_MAGIC, sizeof(magic)) == 0) _flash->eraseSector(FLASH_FILES_DIR + W25Q_SECTOR_SIZE);
+    _flash->eraseSector(FLASH_FILES_DIR);
+    _writeHeader(FLASH_FILES_DIR, 0xFFFFFFFF);
+    _dir_addr = FLASH_FILES_DIR;
+    _sequence = 0xFFFFFFFF;
+    memset(_dir, 0xFF, FLASH_FILES_MAX * sizeof(FlashFileEntry));
+    _mounted = true;
+    _writing = false;
+    return true;
+}
+
+/**
+ * @brief True once begin() or format() has a directory to work with.
+ */
+bool FlashFiles::isMounted() const
+{
+    return _mounted;
+}
+
+/**
+ * @brief Stores a whole file (replaces it if it exists).
+ * @return False if there is no room or no free slot.
+ */
+bool FlashFiles::write(const char* name, const uint8_t* data, size_t len)
+{
+    FlashLock guard(*_flash);
+    FlashFileWriter file;
+    if (!file.open(*this, name, len)) return false;
+    if (file.write(data, len) != len) return false;
+    return file.close();
+}
+
+/**
+ * @brief Reads part of a file.
+ * @param offset First byte to read.
+ * @return Bytes read (0 if the file does not exist or offset is past the end).
+ */
+size_t FlashFiles::read(const char* name, uint32_t offset, uint8_t* buffer, size_t len)
+{
+    FlashLock guard(*_flash);
+    uint32_t addr, size;
+    if (!_lookup(name, addr, size) || offset >= size) return 0;
+    if (len > size - offset) len = size - offset;
+    _flash->read(addr + offset, buffer, len);
+    return len;
+}
+
+/**
+ * @brief True if the file exists.
+ */
+bool FlashFiles::exists(const char* name)
+{
+    FlashLock guard(*_flash);
+    return _find(name) >= 0;
+}
+
+/**
+ * @brief Size of a file in bytes (0 if it does not exist).
+ */
+uint32_t FlashFiles::size(const char* name)
+{
+    FlashLock guard(*_flash);
+    uint32_t addr, size;
+    return _lookup(name, addr, size) ? size : 0;
+}
+
+/**
+ * @brief Removes a file and erases its sectors.
+ * @return False if it does not exist.
+ */
+bool FlashFiles::remove(const char* name)
+{
+    FlashLock guard(*_flash);
+    int16_t slot = _find(name);
+    if (slot < 0) return false;
+    _delete(slot, _dir[slot]);
+    return true;
+}
+
+/**
+ * @brief Bytes used by the files and bytes of the file area.
+ */
+uint32_t FlashFiles::usedSpace()
+{
+    FlashLock guard(*_flash);
+    if (!_mounted) return 0;
+    uint32_t used = 0;
+    for (int16_t i = 0 ; i < (int16_t)FLASH_FILES_MAX ; i++)
+        if (_dir[i].state == FLASH_ENTRY_VALID) used += _dir[i].size;
+    return used;
+}
+
+uint32_t FlashFiles::totalSpace()
+{
+    return _end - FLASH_FILES_START;
+}
+
+// Gets the RAM for the directory copy
+bool FlashFiles::_reserveDirectory()
+{
+    if (!_dir) _dir = (FlashFileEntry*)malloc(FLASH_FILES_MAX * sizeof(FlashFileEntry));
+    return _dir != NULL;
+}
+
+// Blank sector 0 gets a directory, the old single text becomes a file
+bool FlashFiles::_adopt()
+{
+    if (_flash->isBlank(FLASH_FILES_DIR, W25Q_SECTOR_SIZE)) return format();
+    // Old layout: length (u32) and the text, up to the end of the sector
+    uint32_t len;
+    _flash->read(FLASH_FILES_DIR, (uint8_t*)&len, sizeof(len));
+    if (len == 0) return format();
+    if (len > W25Q_SECTOR_SIZE - sizeof(len)) return false;
+    uint8_t* text = (uint8_t*)malloc(len);
+    if (!text) return false;
+    _flash->read(FLASH_FILES_DIR + sizeof(len), text, len);
+    bool ok = format() && write(FLASH_FILES_LEGACY, text, len);
+    free(text);
+    return ok;
+}
+
+// Signs a directory sector (the signature goes last)
+void FlashFiles::_writeHeader(uint32_t addr, uint32_t sequence)
+{
+    // The sequence first: a sector counts as a directory only once it is signed
+    _flash->write(addr + offsetof(FlashFilesHeader, sequence), (const uint8_t*)&sequence, sizeof(sequence));
+    _flash->write(addr, (const uint8_t*)FLASH_FILES_MAGIC, sizeof(FLASH_FILES_MAGIC));
+    _flash->waitForReady();
+}
+
+// Flash address of a directory slot
+uint32_t FlashFiles::_entryAddr(int16_t slot)
+{
+    // The signature takes the first slot
+    return _dir_addr + (slot + 1) * sizeof(FlashFileEntry);
+}
+
+// Slot of a complete file with that name (-1 if none)
+int16_t FlashFiles::_find(const char* name, int16_t skip)
+{
+    if (!_mounted) return -1;
+    for (int16_t i = 0 ; i < (int16_t)FLASH_FILES_MAX ; i++)
+    {
+        if (i == skip || _dir[i].state != FLASH_ENTRY_VALID) continue;
+        if (strncmp(_dir[i].name, name, FLASH_FILE_NAME) == 0) return i;
+    }
+    return -1;
+}
+
+// Place and size of a complete file
+bool FlashFiles::_lookup(const char* name, uint32_t& addr, uint32_t& size)
+{
+    int16_t slot = _find(name);
+    if (slot < 0) return false;
+    addr = _dir[slot].addr;
+    size = _dir[slot].size;
+    return true;
+}
+
+// First free slot, the directory is compacted when there is none (-1 if it is full)
+int16_t FlashFiles::_freeSlot()
+{
+    for (uint8_t attempt = 0 ; attempt < 2 ; attempt++)
+    {
+        for (int16_t i = 0 ; i < (int16_t)FLASH_FILES_MAX ; i++)
+            if (_dir[i].state == FLASH_ENTRY_FREE) return i;
+        if (!_compact()) return -1;
+    }
+    return -1;
+}
+
+// Gap for a new file: the first one with room for len bytes (len 0 = the largest one)
+bool FlashFiles::_allocate(uint32_t len, uint32_t& addr, uint32_t& limit)
+{
+    // Files in address order (insertion sort, the directory is small)
+    uint32_t starts[FLASH_FILES_MAX], ends[FLASH_FILES_MAX];
+    uint16_t count = 0;
+    for (int16_t i = 0 ; i < (int16_t)FLASH_FILES_MAX ; i++)
+    {
+        if (_dir[i].state != FLASH_ENTRY_VALID) continue;
+        uint32_t start = _dir[i].addr;
+        uint32_t end = start + _sectorsFor(_dir[i].size);
+        uint16_t j = count++;
+        while (j > 0 && starts[j - 1] > start)
+        {
+            starts[j] = starts[j - 1];
+            ends[j] = ends[j - 1];
+            j--;
+        }
+        starts[j] = start;
+        ends[j] = end;
+    }
+    uint32_t needed = _sectorsFor(len);
+    uint32_t best_size = 0;
+    uint32_t cursor = FLASH_FILES_START;
+    for (uint16_t i = 0 ; i <= count ; i++)
+    {
+        uint32_t gap_end = (i < count) ? starts[i] : _end;
+        if (gap_end > cursor)
+        {
+            uint32_t gap = gap_end - cursor;
+            if (len > 0 && gap >= needed)
+            {
+                addr = cursor;
+                limit = gap_end;
+                return true;
+            }
+            if (len == 0 && gap > best_size)
+            {
+                best_size = gap;
+                addr = cursor;
+                limit = gap_end;
+            }
+        }
+        if (i < count && ends[i] > cursor) cursor = ends[i];
+    }
+    return best_size > 0;
+}
+
+// End of the free area that starts at addr (next file or end of the flash)
+uint32_t FlashFiles::_gapEnd(uint32_t addr)
+{
+    uint32_t end = _end;
+    for (int16_t i = 0 ; i < (int16_t)FLASH_FILES_MAX ; i++)
+        if (_dir[i].state == FLASH_ENTRY_VALID && _dir[i].addr > addr && _dir[i].addr < end) end = _dir[i].addr;
+    return end;
+}
+
+// Writes a whole entry into a free slot
+void FlashFiles::_writeEntry(int16_t slot, const FlashFileEntry& entry)
+{
+    _flash->write(_entryAddr(slot), (const uint8_t*)&entry, sizeof(entry));
+    _flash->waitForReady();
+    _dir[slot] = entry;
+}
+
+// Moves an entry to a later state
+void FlashFiles::_setState(int16_t slot, uint8_t state)
+{
+    _flash->write(_entryAddr(slot), &state, 1);
+    _flash->waitForReady();
+    _dir[slot].state = state;
+}
+
+// Gives an open entry its size and makes it the file with its name (the old one goes)
+void FlashFiles::_publish(int16_t slot, uint32_t size)
+{
+    // Size first, then the state: a reset in between leaves an unfinished file
+    _flash->write(_entryAddr(slot) + offsetof(FlashFileEntry, size), (const uint8_t*)&size, sizeof(size));
+    _dir[slot].size = size;
+    _setState(slot, FLASH_ENTRY_VALID);
+    int16_t old = _find(_dir[slot].name, slot);
+    if (old >= 0) _delete(old, _dir[old]);
+}
+
+// Marks an entry as deleted and erases its sectors
+void FlashFiles::_delete(int16_t slot, const FlashFileEntry& entry)
+{
+    _setState(slot, FLASH_ENTRY_DELETED);
+    _eraseArea(entry.addr, entry.size);
+}
+
+// Erases the sectors of an area that are not blank (whole blocks when possible)
+void FlashFiles::_eraseArea(uint32_t addr, uint32_t len)
+{
+    uint32_t end = addr + _sectorsFor(len);
+    while (addr < end)
+    {
+        if (addr % W25Q_BLOCK_SIZE == 0 && end - addr >= W25Q_BLOCK_SIZE)
+        {
+            if (!_flash->isBlank(addr, W25Q_BLOCK_SIZE)) _flash->eraseBlock(addr);
+            addr += W25Q_BLOCK_SIZE;
+            continue;
+        }
+        if (!_flash->isBlank(addr, W25Q_SECTOR_SIZE)) _flash->eraseSector(addr);
+        addr += W25Q_SECTOR_SIZE;
+    }
+    // The last erase goes on by itself, the next command waits for it
+}
+
+// Rewrites the directory with only the complete files into the other sector
+bool FlashFiles::_compact()
+{
+    // The copy in RAM is packed in place (nothing moves if every slot is in use)
+    uint16_t live = 0;
+    for (int16_t i = 0 ; i < (int16_t)FLASH_FILES_MAX ; i++)
+        if (_dir[i].state == FLASH_ENTRY_VALID) _dir[live++] = _dir[i];
+    if (live == FLASH_FILES_MAX) return false;
+    memset(&_dir[live], 0xFF, (FLASH_FILES_MAX - live) * sizeof(FlashFileEntry));
+    // The current sector stays untouched until the new one is signed: a reset in
+    // between leaves the old directory in use (it is the newest complete one)
+    uint32_t target = (_dir_addr == FLASH_FILES_DIR) ? FLASH_FILES_DIR + W25Q_SECTOR_SIZE : FLASH_FILES_DIR;
+    _flash->eraseSector(target);
+    if (live > 0) _flash->write(target + sizeof(FlashFileEntry), (const uint8_t*)_dir, live * sizeof(FlashFileEntry));
+    _writeHeader(target, _sequence - 1);
+    _dir_addr = target;
+    _sequence--;
+    return true;
+}
+
+/**
+ * @brief Constructor. Nothing is open.
+ */
+FlashFileWriter::FlashFileWriter()
+{
+    _files = NULL;
+    _slot = -1;
+    _start = _addr = _limit = _prepared = 0;
+    _fill = 0;
+    _ok = false;
+}
+
+/**
+ * @brief Destructor. A file that was not closed is discarded.
+ */
+FlashFileWriter::~FlashFileWriter()
+{
+    abort();
+}
+
+/**
+ * @brief Starts a new file (only one can be written at a time).
+ * @param size_hint Expected size, 0 if unknown (it gets the largest free gap).
+ * @param recoverable Keep the entry if a reset cuts the writing (the owner of
+ * the format finishes it after begin(), see FrameLog::recover()).
+ */
+bool FlashFileWriter::open(FlashFiles& files, const char* name, uint32_t size_hint, bool recoverable)
+{
+    abort();
+    FlashLock guard(*files._flash);
+    if (!files._mounted || files._writing) return false;
+    if (!name || name[0] == '\0' || strlen(name) >= FLASH_FILE_NAME) return false;
+    int16_t slot = files._freeSlot();
+    uint32_t start, limit;
+    if (slot < 0 || !files._allocate(size_hint, start, limit)) return false;
+    // The entry exists from now on, but only as an unfinished file
+    FlashFileEntry entry;
+    memset(&entry, 0xFF, sizeof(entry));
+    entry.state = FLASH_ENTRY_WRITING;
+    if (recoverable) entry.flags = FLASH_FILE_RECOVERABLE;
+    entry.addr = start;
+    memset(entry.name, 0, sizeof(entry.name));
+    strncpy(entry.name, name, FLASH_FILE_NAME - 1);
+    files._writeEntry(slot, entry);
+    files._writing = true;
+    _files = &files;
+    _slot = slot;
+    _start = _addr = _prepared = start;
+    _limit = limit;
+    _fill = 0;
+    _ok = true;
+    return true;
+}
+
+/**
+ * @brief Appends bytes to the file.
+ * @return Bytes written, less than len if the flash is full.
+ */
+size_t FlashFileWriter::write(const uint8_t* data, size_t len)
+{
+    if (!_files) return 0;
+    // Held for the pages of this call, other tasks get the chip between calls
+    FlashLock guard(*_files->_flash);
+    size_t done = 0;
+    while (_ok && done < len)
+    {
+        // Whole pages are programmed from the caller's buffer, the rest is gathered
+        if (_fill == 0 && len - done >= W25Q_PAGE_SIZE)
+        {
+            if (!_program(&data[done], W25Q_PAGE_SIZE)) break;
+            done += W25Q_PAGE_SIZE;
+            continue;
+        }
+        uint16_t n = min((size_t)(W25Q_PAGE_SIZE - _fill), len - done);
+        memcpy(&_page[_fill], &data[done], n);
+        _fill += n;
+        done += n;
+        if (_fill == W25Q_PAGE_SIZE)
+        {
+            _fill = 0;
+            if (_program(_page, W25Q_PAGE_SIZE)) continue;
+            // This piece did not reach the flash either
+            done -= n;
+            break;
+        }
+    }
+    // A short write spoils the file (see failed())
+    if (done < len) _ok = false;
+    return done;
+}
+
+/**
+ * @brief Writes over bytes of the file that were written as 0xFF (flash bits
+ * only go from 1 to 0), e.g. a length that was not known yet.
+ * @param offset First byte inside the file (below size()).
+ */
+bool FlashFileWriter::patch(uint32_t offset, const uint8_t* data, size_t len)
+{
+    if (!_files || offset + len > size()) return false;
+    FlashLock guard(*_files->_flash);
+    // The programmed part is written again, the rest is still in the page buffer
+    uint32_t programmed = _addr - _start;
+    size_t flashed = (offset < programmed) ? min(len, (size_t)(programmed - offset)) : 0;
+    if (flashed > 0) _files->_flash->write(_start + offset, data, flashed);
+    if (len > flashed) memcpy(&_page[offset + flashed - programmed], &data[flashed], len - flashed);
+    return true;
+}
+
+/**
+ * @brief Finishes the file and publishes it (replacing the old one with its name).
+ */
+bool FlashFileWriter::close()
+{
+    if (!_files) return false;
+    FlashLock guard(*_files->_flash);
+    if (_ok && _fill > 0) _program(_page, _fill);
+    _fill = 0;
+    if (!_ok)
+    {
+        abort();
+        return false;
+    }
+    // The old file with this name goes away only now
+    _files->_publish(_slot, _addr - _start);
+    _files->_writing = false;
+    _files = NULL;
+    return true;
+}
+
+/**
+ * @brief Discards the file.
+ */
+void FlashFileWriter::abort()
+{
+    if (!_files) return;
+    FlashLock guard(*_files->_flash);
+    _files->_flash->waitForReady();
+    _files->_setState(_slot, FLASH_ENTRY_DELETED);
+    // What was written is erased, so the gap stays fast to write
+    if (_addr > _start) _files->_eraseArea(_start, _addr - _start);
+    _files->_writing = false;
+    _files = NULL;
+}
+
+/**
+ * @brief Bytes written so far.
+ */
+uint32_t FlashFileWriter::size() const
+{
+    return _files ? _addr - _start + _fill : 0;
+}
+
+/**
+ * @brief Bytes that can still be written (the rest of the gap it was given).
+ */
+uint32_t FlashFileWriter::available() const
+{
+    return _files ? _limit - _addr - _fill : 0;
+}
+
+/**
+ * @brief True once a write did not fit: the file can only be discarded
+ * (close() refuses to publish it).
+ */
+bool FlashFileWriter::failed() const
+{
+    return _files && !_ok;
+}
+
+// Programs one page (starting the sectors it reaches)
+bool FlashFileWriter::_program(const uint8_t* data, uint16_t len)
+{
+    if (_addr + len > _limit)
+    {
+        _ok = false;
+        return false;
+    }
+    FlashHandler* flash = _files->_flash;
+    // Each sector is checked just before its first page and erased only if it is not blank
+    while (_addr + len > _prepared)
+    {
+        if (!flash->isBlank(_prepared, W25Q_SECTOR_SIZE)) flash->eraseSector(_prepared);
+        _prepared += W25Q_SECTOR_SIZE;
+    }
+    // Returns while the chip programs: the caller prepares the next page meanwhile
+    flash->programPage(_addr, data, len);
+    _addr += len;
+    return true;
+}
@@ -0,0 +1,250 @@
+#ifndef FLASH_FILES_H
+#define FLASH_FILES_H
+
+#include <Arduino.h>
+#include "./FlashHandler.h"
+
+// --- LAYOUT ---
+// Sectors 0 and 1 keep the directory (each rewrite goes to the other one), the
+// files live in the second megabyte (the rest of the first one stays free for
+// animations and other raw data)
+#define FLASH_FILES_DIR     0x000000
+#define FLASH_FILES_DIR_END 0x002000
+#define FLASH_FILES_START   0x100000
+#define FLASH_FILES_END     0x200000    // W25Q16, the real size is read on begin()
+// Bytes of a name, the final 0 included
+#define FLASH_FILE_NAME     20
+// File that gets the text saved by the old Storage (one text in sector 0)
+#define FLASH_FILES_LEGACY "/storage.txt"
+
+// --- ENTRY STATES (flash bits only go from 1 to 0, each step clears more) ---
+#define FLASH_ENTRY_FREE    0xFF
+#define FLASH_ENTRY_WRITING 0x7F
+#define FLASH_ENTRY_VALID   0x3F
+#define FLASH_ENTRY_DELETED 0x00
+
+// Flag of a file whose data stays usable if a reset cuts its writing (see FrameLog::recover())
+#define FLASH_FILE_RECOVERABLE 0x7F
+
+/**
+ * @brief One slot of the directory sector (32 bytes, the first slot holds the
+ * signature). The file takes whole sectors from addr on.
+ */
+struct FlashFileEntry {
+    uint8_t state;
+    uint8_t flags;                  // 0xFF or FLASH_FILE_RECOVERABLE
+    uint8_t reserved[2];
+    uint32_t addr;
+    uint32_t size;                  // 0xFFFFFFFF while it is being written
+    char name[FLASH_FILE_NAME];
+};
+
+// Slots of the directory (the signature takes one)
+#define FLASH_FILES_MAX (W25Q_SECTOR_SIZE / sizeof(FlashFileEntry) - 1)
+
+/**
+ * @brief Minimal file system on the external flash: a directory sector and
+ * files stored in consecutive sectors. Writing a file that already exists
+ * replaces it once the new one is complete. Removed files are erased at that
+ * moment, so new files usually find blank sectors and are written at full speed.
+ * Each call holds FlashHandler::lock() from start to end, so several tasks can
+ * use the files (one FlashFileWriter at a time).
+ */
+class FlashFiles {
+
+    public:
+
+        /**
+         * @brief Constructor.
+         * @param flash Flash chip (it must be started before begin()).
+         */
+        FlashFiles(FlashHandler* flash);
+
+        /**
+         * @brief Reads the newest copy of the directory into RAM. A blank flash gets an
+         * empty one and the text of the old Storage (sector 0) is moved into
+         * FLASH_FILES_LEGACY. Anything else in sector 0 is left alone: nothing works
+         * until format(). Files cut by a reset are dropped, except the recoverable
+         * ones (they stay open for their owner, see FrameLog::recover()).
+         * @return False if the flash does not answer or no directory is recognized.
+         */
+        bool begin();
+
+        /**
+         * @brief Empties the directory (whatever the directory sectors had). The data
+         * sectors are erased when reused.
+         */
+        bool format();
+
+        /**
+         * @brief True once begin() or format() has a directory to work with.
+         */
+        bool isMounted() const;
+
+        /**
+         * @brief Stores a whole file (replaces it if it exists).
+         * @return False if there is no room or no free slot.
+         */
+        bool write(const char* name, const uint8_t* data, size_t len);
+
+        /**
+         * @brief Reads part of a file.
+         * @param offset First byte to read.
+         * @return Bytes read (0 if the file does not exist or offset is past the end).
+         */
+        size_t read(const char* name, uint32_t offset, uint8_t* buffer, size_t len);
+
+        /**
+         * @brief True if the file exists.
+         */
+        bool exists(const char* name);
+
+        /**
+         * @brief Size of a file in bytes (0 if it does not exist).
+         */
+        uint32_t size(const char* name);
+
+        /**
+         * @brief Removes a file and erases its sectors.
+         * @return False if it does not exist.
+         */
+        bool remove(const char* name);
+
+        /**
+         * @brief Bytes used by the files and bytes of the file area.
+         */
+        uint32_t usedSpace();
+        uint32_t totalSpace();
+
+    private:
+
+        FlashHandler* _flash;
+        FlashFileEntry* _dir;   // Copy of the directory slots, kept in step with the flash
+        uint32_t _dir_addr;     // Sector of the directory in use
+        uint32_t _sequence;     // Its age (it counts down on every rewrite)
+        uint32_t _end;          // End of the file area
+        bool _mounted;
+        bool _writing;          // A FlashFileWriter is open
+
+        // Gets the RAM for the directory copy
+        bool _reserveDirectory();
+        // Blank sector 0 gets a directory, the old single text becomes a file
+        bool _adopt();
+        // Signs a directory sector (the signature goes last)
+        void _writeHeader(uint32_t addr, uint32_t sequence);
+        // Flash address of a directory slot
+        uint32_t _entryAddr(int16_t slot);
+        // Slot of a complete file with that name (-1 if none)
+        int16_t _find(const char* name, int16_t skip = -1);
+        // Place and size of a complete file
+        bool _lookup(const char* name, uint32_t& addr, uint32_t& size);
+        // First free slot, the directory is compacted when there is none (-1 if it is full)
+        int16_t _freeSlot();
+        // Gap for a new file: the first one with room for len bytes (len 0 = the largest one)
+        bool _allocate(uint32_t len, uint32_t& addr, uint32_t& limit);
+        // End of the free area that starts at addr (next file or end of the flash)
+        uint32_t _gapEnd(uint32_t addr);
+        // Writes a whole entry into a free slot
+        void _writeEntry(int16_t slot, const FlashFileEntry& entry);
+        // Moves an entry to a later state
+        void _setState(int16_t slot, uint8_t state);
+        // Gives an open entry its size and makes it the file with its name (the old one goes)
+        void _publish(int16_t slot, uint32_t size);
+        // Marks an entry as deleted and erases its sectors
+        void _delete(int16_t slot, const FlashFileEntry& entry);
+        // Erases the sectors of an area that are not blank (whole blocks when possible)
+        void _eraseArea(uint32_t addr, uint32_t len);
+        // Rewrites the directory with only the complete files into the other sector
+        bool _compact();
+
+        friend class FlashFileWriter;
+        friend class FrameLog;
+        friend class FrameLogReader;
+
+};
+
+/**
+ * @brief Writes a file of unknown size in pieces (for example a JPEG as it is
+ * encoded). Whole pages go straight from the caller's buffer to the flash and
+ * each page is programmed while the caller prepares the next one, so a frame
+ * is never copied in RAM. The file appears in the directory on close().
+ */
+class FlashFileWriter {
+
+    public:
+
+        /**
+         * @brief Constructor. Nothing is open.
+         */
+        FlashFileWriter();
+
+        /**
+         * @brief Destructor. A file that was not closed is discarded.
+         */
+        ~FlashFileWriter();
+
+        /**
+         * @brief Starts a new file (only one can be written at a time).
+         * @param size_hint Expected size, 0 if unknown (it gets the largest free gap).
+         * @param recoverable Keep the entry if a reset cuts the writing (the owner of
+         * the format finishes it after begin(), see FrameLog::recover()).
+         */
+        bool open(FlashFiles& files, const char* name, uint32_t size_hint = 0, bool recoverable = false);
+
+        /**
+         * @brief Appends bytes to the file.
+         * @return Bytes written, less than len if the flash is full.
+         */
+        size_t write(const uint8_t* data, size_t len);
+
+        /**
+         * @brief Writes over bytes of the file that were written as 0xFF (flash bits
+         * only go from 1 to 0), e.g. a length that was not known yet.
+         * @param offset First byte inside the file (below size()).
+         */
+        bool patch(uint32_t offset, const uint8_t* data, size_t len);
+
+        /**
+         * @brief Finishes the file and publishes it (replacing the old one with its name).
+         */
+        bool close();
+
+        /**
+         * @brief Discards the file.
+         */
+        void abort();
+
+        /**
+         * @brief Bytes written so far.
+         */
+        uint32_t size() const;
+
+        /**
+         * @brief Bytes that can still be written (the rest of the gap it was given).
+         */
+        uint32_t available() const;
+
+        /**
+         * @brief True once a write did not fit: the file can only be discarded
+         * (close() refuses to publish it).
+         */
+        bool failed() const;
+
+    private:
+
+        FlashFiles* _files;
+        int16_t _slot;
+        uint32_t _start;            // First byte of the file
+        uint32_t _addr;             // Next byte to program
+        uint32_t _limit;            // End of the gap it was given
+        uint32_t _prepared;         // Sectors below this are blank or erased
+        alignas(4) uint8_t _page[W25Q_PAGE_SIZE];  // Last partial page
+        uint16_t _fill;
+        bool _ok;
+
+        // Programs one page (starting the sectors it reaches)
+        bool _program(const uint8_t* data, uint16_t len);
+
+};
+
+#endif
@@ -14,10 +14,34 @@ FlashHandler::FlashHandler(SPIClass* spi_bus, int cs_pin)
 void FlashHandler::begin()
 {
     SPIHandler::begin(); // Init CS pin and Mutex
+    if (_chip_lock == NULL) _chip_lock = xSemaphoreCreateRecursiveMutex();
     wakeUp();            // Ensure flash is not in power down mode
     delay(5);            // Startup time
 }
 
+/**
+ * @brief Reserves the chip for the calling task. Every command below takes it
+ * for its own duration (waiting for the previous operation included); hold it
+ * around a sequence that must not be split by another task (read-modify-write
+ * of a directory, erase + program). Recursive.
+ * @param timeout_ms Maximum wait, FLASH_WAIT_FOREVER to wait as needed.
+ * @return False if another task kept it longer than the timeout.
+ */
+bool FlashHandler::lock(uint32_t timeout_ms)
+{
+    if (_chip_lock == NULL) return true;
+    TickType_t ticks = (timeout_ms == FLASH_WAIT_FOREVER) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+    return xSemaphoreTakeRecursive(_chip_lock, ticks) == pdTRUE;
+}
+
+/**
+ * @brief Releases one lock() of the calling task.
+ */
+void FlashHandler::unlock()
+{
+    if (_chip_lock) xSemaphoreGiveRecursive(_chip_lock);
+}
+
 /**
  * @brief Reads the JEDEC Manufacturer and Device ID.
  * @return 24-bit ID (Manufacturer + Memory Type + Capacity).
@@ -43,12 +67,12 @@ uint32_t FlashHandler::getJEDECID()
  */
 void FlashHandler::read(uint32_t addr, uint8_t* buffer, size_t len)
 {
+    FlashLock guard(*this);
     waitForReady(); // Ensure no previous write is pending
     startTransaction();
     spiWrite(W25Q_CMD_READ_DATA);
     _sendAddress(addr);
-    for (size_t i = 0 ; i < len ; i++) // Read bytes into buffer
-        buffer[i] = spiRead();
+    spiReadBytes(buffer, len);
     endTransaction();
 }
 
@@ -61,25 +85,18 @@ void FlashHandler::read(uint32_t addr, uint8_t* buffer, size_t len)
  */
 void FlashHandler::write(uint32_t addr, const uint8_t* buffer, size_t len)
 {
+    FlashLock guard(*this);
     uint32_t current_addr = addr;
     size_t remaining_bytes = len;
     size_t data_offset = 0;
     while (remaining_bytes > 0)
     {
-        waitForReady(); // Wait for previous page to finish
-        _writeEnable(); // Enable write latch
-        startTransaction();
-        spiWrite(W25Q_CMD_PAGE_PROGRAM);
-        _sendAddress(current_addr);
         // Calculate how many bytes we can write in the current page
         // A page is 256 bytes. We cannot cross the boundary 255 -> 0 in one command.
         uint16_t page_offset = current_addr % W25Q_PAGE_SIZE;
         uint16_t bytes_available_in_page = W25Q_PAGE_SIZE - page_offset;
         uint16_t bytes_to_write = (remaining_bytes < bytes_available_in_page) ? remaining_bytes : bytes_available_in_page;
-        // Send data
-        for (size_t i = 0 ; i < bytes_to_write ; i++)
-            spiWrite(buffer[data_offset + i]);
-        endTransaction();
+        programPage(current_addr, &buffer[data_offset], bytes_to_write);
         // Update counters
         current_addr += bytes_to_write;
         data_offset += bytes_to_write;
@@ -87,6 +104,57 @@ void FlashHandler::write(uint32_t addr, const uint8_t* buffer, size_t len)
     }
 }
 
+/**
+ * @brief Starts programming one page and returns without waiting for it, so
+ * the caller can prepare the next page meanwhile (the next command waits).
+ * @param addr Starting byte address.
+ * @param buffer Data to write (it is sent before returning).
+ * @param len Bytes, they must not cross the end of the page.
+ */
+void FlashHandler::programPage(uint32_t addr, const uint8_t* buffer, uint16_t len)
+{
+    FlashLock guard(*this);
+    waitForReady(); // Wait for previous page to finish
+    _writeEnable(); // Enable write latch
+    startTransaction();
+    spiWrite(W25Q_CMD_PAGE_PROGRAM);
+    _sendAddress(addr);
+    spiWriteBytes(buffer, len);
+    endTransaction();
+    // The chip programs the page by itself, the bus is free again
+}
+
+/**
+ * @brief Checks if an area is erased (all bytes 0xFF), so it can be written
+ * without erasing it first.
+ * @param addr Starting byte address.
+ * @param len Number of bytes to check.
+ * @return True if every byte is 0xFF.
+ */
+bool FlashHandler::isBlank(uint32_t addr, size_t len)
+{
+    alignas(4) uint8_t chunk[W25Q_PAGE_SIZE];
+    bool blank = true;
+    FlashLock guard(*this);
+    waitForReady();
+    startTransaction();
+    spiWrite(W25Q_CMD_READ_DATA);
+    _sendAddress(addr);
+    while (len > 0 && blank)
+    {
+        size_t n = (len < sizeof(chunk)) ? len : sizeof(chunk);
+        spiReadBytes(chunk, n);
+        // Four bytes at a time (the chunk is word aligned)
+        const uint32_t* words = (const uint32_t*)chunk;
+        size_t i = 0;
+        for ( ; i + 4 <= n && blank ; i += 4) blank = (words[i / 4] == 0xFFFFFFFF);
+        for ( ; i < n && blank ; i++) blank = (chunk[i] == 0xFF);
+        len -= n;
+    }
+    endTransaction();
+    return blank;
+}
+
 /**
  * @brief Erases a 4KB Sector. The smallest erasable unit.
  * Takes roughly 45ms.
@@ -94,6 +162,7 @@ void FlashHandler::write(uint32_t addr, const uint8_t* buffer, size_t len)
  */
 void FlashHandler::eraseSector(uint32_t addr)
 {
+    FlashLock guard(*this);
     waitForReady(); // Wait for previous page to finish
     _writeEnable(); // Enable write latch
     startTransaction();
@@ -104,11 +173,28 @@ void FlashHandler::eraseSector(uint32_t addr)
     // This allows other SPI devices to use the bus while Flash erases internally.
 }
 
+/**
+ * @brief Erases a 64KB Block. Takes roughly 150ms, much less than 16 sectors.
+ * @param addr Any address inside the block to be erased.
+ */
+void FlashHandler::eraseBlock(uint32_t addr)
+{
+    FlashLock guard(*this);
+    waitForReady(); // Wait for previous page to finish
+    _writeEnable(); // Enable write latch
+    startTransaction();
+    spiWrite(W25Q_CMD_BLOCK_ERASE_64K);
+    _sendAddress(addr);
+    endTransaction();
+    // We do NOT wait here inside the mutex lock.
+}
+
 /**
  * @brief Erases the entire chip (This can take several seconds).
  */
 void FlashHandler::eraseChip()
 {
+    FlashLock guard(*this);
     waitForReady(); // Wait for previous page to finish
     _writeEnable(); // Enable write latch
     startTransaction();
@@ -135,13 +221,18 @@ bool FlashHandler::isBusy()
 
 /**
  * @brief Blocks execution until the flash operation is complete.
- * It efficiently yields to other tasks while waiting.
+ * Short operations (page programs) are polled, longer ones (erases)
+ * yield to other tasks while waiting.
  */
 void FlashHandler::waitForReady()
 {
-    // Polling loop. We release the mutex lock in each iteration
+    // Nobody can start a new operation until we see this one finished
+    FlashLock guard(*this);
+    // Polling loop. We release the mutex lock in each iteration.
+    // Sleeping a whole tick per page would make writes 2-3 times slower.
+    uint32_t start = micros();
     while (isBusy())
-        vTaskDelay(1 / portTICK_PERIOD_MS);
+        if (micros() - start > W25Q_SPIN_US) vTaskDelay(1);
 }
 
 /**
@@ -180,3 +271,16 @@ void FlashHandler::_sendAddress(uint32_t addr)
     spiWrite((addr >> 8) & 0xFF);
     spiWrite(addr & 0xFF);
 }
+
+/**
+ * @brief Takes FlashHandler::lock() until the end of the scope.
+ */
+FlashLock::FlashLock(FlashHandler& flash) : _flash(flash)
+{
+    _flash.lock();
+}
+
+FlashLock::~FlashLock()
+{
+    _flash.unlock();
+}
@@ -20,6 +20,13 @@
 
 // --- W25Q16 LAYOUT
 #define W25Q_PAGE_SIZE 256
+#define W25Q_SECTOR_SIZE 4096
+#define W25Q_BLOCK_SIZE 65536
+
+// Time spent polling the status without sleeping (a page program takes 0.7 ms, 3 ms at most)
+#define W25Q_SPIN_US 3000
+// Timeout of lock() that never expires
+#define FLASH_WAIT_FOREVER 0xFFFFFFFF
 
 class FlashHandler : public SPIHandler {
 
@@ -37,6 +44,21 @@ class FlashHandler : public SPIHandler {
          */
         void begin() override;
 
+        /**
+         * @brief Reserves the chip for the calling task. Every command below takes it
+         * for its own duration (waiting for the previous operation included); hold it
+         * around a sequence that must not be split by another task (read-modify-write
+         * of a directory, erase + program). Recursive.
+         * @param timeout_ms Maximum wait, FLASH_WAIT_FOREVER to wait as needed.
+         * @return False if another task kept it longer than the timeout.
+         */
+        bool lock(uint32_t timeout_ms = FLASH_WAIT_FOREVER);
+
+        /**
+         * @brief Releases one lock() of the calling task.
+         */
+        void unlock();
+
         /**
          * @brief Reads the JEDEC Manufacturer and Device ID.
          * @return 24-bit ID (Manufacturer + Memory Type + Capacity).
@@ -61,6 +83,24 @@ class FlashHandler : public SPIHandler {
          */
         void write(uint32_t addr, const uint8_t* buffer, size_t len);
 
+        /**
+         * @brief Starts programming one page and returns without waiting for it, so
+         * the caller can prepare the next page meanwhile (the next command waits).
+         * @param addr Starting byte address.
+         * @param buffer Data to write (it is sent before returning).
+         * @param len Bytes, they must not cross the end of the page.
+         */
+        void programPage(uint32_t addr, const uint8_t* buffer, uint16_t len);
+
+        /**
+         * @brief Checks if an area is erased (all bytes 0xFF), so it can be written
+         * without erasing it first.
+         * @param addr Starting byte address.
+         * @param len Number of bytes to check.
+         * @return True if every byte is 0xFF.
+         */
+        bool isBlank(uint32_t addr, size_t len);
+
         /**
          * @brief Erases a 4KB Sector. The smallest erasable unit.
          * Takes roughly 45ms.
@@ -68,6 +108,12 @@ class FlashHandler : public SPIHandler {
          */
         void eraseSector(uint32_t addr);
 
+        /**
+         * @brief Erases a 64KB Block. Takes roughly 150ms, much less than 16 sectors.
+         * @param addr Any address inside the block to be erased.
+         */
+        void eraseBlock(uint32_t addr);
+
         /**
          * @brief Erases the entire chip (This can take several seconds).
          */
@@ -81,7 +127,8 @@ class FlashHandler : public SPIHandler {
 
         /**
          * @brief Blocks execution until the flash operation is complete.
-         * It efficiently yields to other tasks while waiting.
+         * Short operations (page programs) are polled, longer ones (erases)
+         * yield to other tasks while waiting.
          */
         void waitForReady();
 
@@ -97,6 +144,8 @@ class FlashHandler : public SPIHandler {
 
     private:
 
+        SemaphoreHandle_t _chip_lock = NULL;    // Recursive, see lock()
+
         // Internal helper to enable writing latch (WEL bit)
         void _writeEnable();
         // Helper to send a 24-bit address
@@ -104,4 +153,20 @@ class FlashHandler : public SPIHandler {
 
 };
 
+/**
+ * @brief Takes FlashHandler::lock() until the end of the scope.
+ */
+class FlashLock {
+
+    public:
+
+        FlashLock(FlashHandler& flash);
+        ~FlashLock();
+
+    private:
+
+        FlashHandler& _flash;
+
+};
+
 #endif
@@ -0,0 +1,223 @@
+#include "FrameCanvas.h"
+
+// Area of a rectangle in pixels
+static int32_t _rectArea(const DirtyRect& r)
+{
+    return (int32_t)r.w * r.h;
+}
+
+// Smallest rectangle containing both
+static DirtyRect _rectUnion(const DirtyRect& a, const DirtyRect& b)
+{
+    int16_t x0 = min(a.x, b.x);
+    int16_t y0 = min(a.y, b.y);
+    int16_t x1 = max(a.x + a.w, b.x + b.w);
+    int16_t y1 = max(a.y + a.h, b.y + b.h);
+    return { x0, y0, (int16_t)(x1 - x0), (int16_t)(y1 - y0) };
+}
+
+/**
+ * @brief Constructor. Does NOT allocate memory, call begin().
+ * @param w Width in pixels.
+ * @param h Height in pixels.
+ */
+FrameCanvas::FrameCanvas(int16_t w, int16_t h)
+    : Adafruit_GFX(w, h)
+{
+    _buffer = NULL;
+    _dirty_count = 0;
+    _resetTouch();
+}
+
+/**
+ * @brief Destructor. Frees the pixel buffer.
+ */
+FrameCanvas::~FrameCanvas()
+{
+    if (_buffer) heap_caps_free(_buffer);
+}
+
+/**
+ * @brief Allocates the pixel buffer.
+ * @param caps heap_caps flags (e.g. MALLOC_CAP_SPIRAM).
+ * @return True if the buffer could be allocated.
+ */
+bool FrameCanvas::begin(uint32_t caps)
+{
+    if (_buffer) return true;
+    size_t bytes = (size_t)WIDTH * HEIGHT * sizeof(uint16_t);
+    _buffer = (uint16_t*)heap_caps_malloc(bytes, caps);
+    if (!_buffer) return false;
+    memset(_buffer, 0, bytes);
+    return true;
+}
+
+// --- Adafruit GFX rasterization hooks ---
+
+void FrameCanvas::drawPixel(int16_t x, int16_t y, uint16_t color)
+{
+    if (x < 0 || y < 0 || x >= WIDTH || y >= HEIGHT) return;
+    _buffer[y * WIDTH + x] = __builtin_bswap16(color);
+    _touch(x, y, x, y);
+}
+
+void FrameCanvas::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+    if (y < 0 || y >= HEIGHT || w <= 0) return;
+    if (x < 0) { w += x; x = 0; }
+    if (x + w > WIDTH) w = WIDTH - x;
+    if (w <= 0) return;
+    uint16_t swapped = __builtin_bswap16(color);
+    uint16_t* dst = &_buffer[y * WIDTH + x];
+    for (int16_t i = 0 ; i < w ; i++) dst[i] = swapped;
+    _touch(x, y, x + w - 1, y);
+}
+
+void FrameCanvas::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+    if (x < 0 || x >= WIDTH || h <= 0) return;
+    if (y < 0) { h += y; y = 0; }
+    if (y + h > HEIGHT) h = HEIGHT - y;
+    if (h <= 0) return;
+    uint16_t swapped = __builtin_bswap16(color);
+    uint16_t* dst = &_buffer[y * WIDTH + x];
+    for (int16_t i = 0 ; i < h ; i++, dst += WIDTH) *dst = swapped;
+    _touch(x, y, x, y + h - 1);
+}
+
+void FrameCanvas::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+    if (w <= 0 || h <= 0) return;
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (x + w > WIDTH) w = WIDTH - x;
+    if (y + h > HEIGHT) h = HEIGHT - y;
+    if (w <= 0 || h <= 0) return;
+    uint16_t swapped = __builtin_bswap16(color);
+    for (int16_t row = 0 ; row < h ; row++)
+    {
+        uint16_t* dst = &_buffer[(y + row) * WIDTH + x];
+        for (int16_t i = 0 ; i < w ; i++) dst[i] = swapped;
+    }
+    _touch(x, y, x + w - 1, y + h - 1);
+}
+
+void FrameCanvas::fillScreen(uint16_t color)
+{
+    uint16_t swapped = __builtin_bswap16(color);
+    uint32_t total = (uint32_t)WIDTH * HEIGHT;
+    // Same high and low byte (black, white...) can be done with memset
+    if ((swapped >> 8) == (swapped & 0xFF)) memset(_buffer, swapped & 0xFF, total * 2);
+    else for (uint32_t i = 0 ; i < total ; i++) _buffer[i] = swapped;
+    // Everything is going to be pushed, older rects are useless
+    _dirty_count = 0;
+    _touch(0, 0, WIDTH - 1, HEIGHT - 1);
+}
+
+/**
+ * @brief Direct access to the pixel buffer (big-endian RGB565).
+ */
+uint16_t* FrameCanvas::getBuffer()
+{
+    return _buffer;
+}
+
+// --- Dirty tracking ---
+
+/**
+ * @brief Marks an area as modified (clipped to the canvas).
+ */
+void FrameCanvas::markDirty(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (x + w > WIDTH) w = WIDTH - x;
+    if (y + h > HEIGHT) h = HEIGHT - y;
+    if (w <= 0 || h <= 0) return;
+    _touch(x, y, x + w - 1, y + h - 1);
+}
+
+/**
+ * @brief Closes the current primitive: the area touched since the last
+ * commit is merged into the dirty list.
+ */
+void FrameCanvas::commit()
+{
+    if (_touch_x0 > _touch_x1) return;
+    _addDirty({ _touch_x0, _touch_y0, (int16_t)(_touch_x1 - _touch_x0 + 1), (int16_t)(_touch_y1 - _touch_y0 + 1) });
+    _resetTouch();
+}
+
+/**
+ * @brief Number of dirty rectangles pending to be flushed.
+ */
+uint8_t FrameCanvas::getDirtyCount()
+{
+    return _dirty_count;
+}
+
+/**
+ * @brief Gets one of the pending dirty rectangles.
+ */
+const DirtyRect& FrameCanvas::getDirtyRect(uint8_t index)
+{
+    return _dirty[index];
+}
+
+/**
+ * @brief Forgets all the dirty rectangles (after a flush).
+ */
+void FrameCanvas::clearDirty()
+{
+    _dirty_count = 0;
+    _resetTouch();
+}
+
+// Resets the touched bounding box
+void FrameCanvas::_resetTouch()
+{
+    _touch_x0 = _touch_y0 = INT16_MAX;
+    _touch_x1 = _touch_y1 = INT16_MIN;
+}
+
+// Inserts a rectangle in the dirty list merging when worth it
+void FrameCanvas::_addDirty(DirtyRect rect)
+{
+    // Absorb into an existing rect if the union does not waste too many pixels.
+    // After a merge the grown rect may now overlap others, so keep merging.
+    bool merged = true;
+    while (merged)
+    {
+        merged = false;
+        for (uint8_t i = 0 ; i < _dirty_count ; i++)
+        {
+            DirtyRect joined = _rectUnion(_dirty[i], rect);
+            if (_rectArea(joined) <= _rectArea(_dirty[i]) + _rectArea(rect) + CANVAS_MERGE_SLACK)
+            {
+                // Take it out of the list and retry with the union
+                rect = joined;
+                _dirty[i] = _dirty[--_dirty_count];
+                merged = true;
+                break;
+            }
+        }
+    }
+    if (_dirty_count < CANVAS_MAX_DIRTY_RECTS)
+    {
+        _dirty[_dirty_count++] = rect;
+        return;
+    }
+    // List full: merge with the rect that grows the least
+    uint8_t best = 0;
+    int32_t best_growth = INT32_MAX;
+    for (uint8_t i = 0 ; i < _dirty_count ; i++)
+    {
+        int32_t growth = _rectArea(_rectUnion(_dirty[i], rect)) - _rectArea(_dirty[i]);
+        if (growth < best_growth)
+        {
+            best_growth = growth;
+            best = i;
+        }
+    }
+    _dirty[best] = _rectUnion(_dirty[best], rect);
+}
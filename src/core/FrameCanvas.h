@@ -0,0 +1,116 @@
+#ifndef FRAME_CANVAS_H
+#define FRAME_CANVAS_H
+
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include <Adafruit_GFX.h>
+
+// Dirty tracking configuration
+#define CANVAS_MAX_DIRTY_RECTS 8    // Windows pushed per flush before rects get merged
+#define CANVAS_MERGE_SLACK     512  // Extra pixels we accept to save one window (address set + CS toggle)
+
+/**
+ * @brief Rectangle pending to be pushed to the panel.
+ */
+struct DirtyRect {
+    int16_t x;
+    int16_t y;
+    int16_t w;
+    int16_t h;
+};
+
+/**
+ * @brief Off-screen RGB565 surface with dirty-rectangle tracking.
+ * Pixels are stored big-endian (panel byte order), so a flush is a raw
+ * copy of each dirty window without any byte swapping.
+ * The canvas is never rotated, it must be created with the panel logical size.
+ */
+class FrameCanvas : public Adafruit_GFX {
+
+    public:
+
+        /**
+         * @brief Constructor. Does NOT allocate memory, call begin().
+         * @param w Width in pixels.
+         * @param h Height in pixels.
+         */
+        FrameCanvas(int16_t w, int16_t h);
+
+        /**
+         * @brief Destructor. Frees the pixel buffer.
+         */
+        ~FrameCanvas();
+
+        /**
+         * @brief Allocates the pixel buffer.
+         * @param caps heap_caps flags (e.g. MALLOC_CAP_SPIRAM).
+         * @return True if the buffer could be allocated.
+         */
+        bool begin(uint32_t caps);
+
+        // --- Adafruit GFX rasterization hooks ---
+        void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+        void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+        void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+        void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+        void fillScreen(uint16_t color) override;
+
+        /**
+         * @brief Direct access to the pixel buffer (big-endian RGB565).
+         */
+        uint16_t* getBuffer();
+
+        // --- Dirty tracking ---
+
+        /**
+         * @brief Marks an area as modified (clipped to the canvas).
+         */
+        void markDirty(int16_t x, int16_t y, int16_t w, int16_t h);
+
+        /**
+         * @brief Closes the current primitive: the area touched since the last
+         * commit is merged into the dirty list.
+         */
+        void commit();
+
+        /**
+         * @brief Number of dirty rectangles pending to be flushed.
+         */
+        uint8_t getDirtyCount();
+
+        /**
+         * @brief Gets one of the pending dirty rectangles.
+         */
+        const DirtyRect& getDirtyRect(uint8_t index);
+
+        /**
+         * @brief Forgets all the dirty rectangles (after a flush).
+         */
+        void clearDirty();
+
+    private:
+
+        uint16_t* _buffer;
+
+        // Bounding box touched by the primitive in progress (x0 > x1 means empty)
+        int16_t _touch_x0, _touch_y0, _touch_x1, _touch_y1;
+
+        DirtyRect _dirty[CANVAS_MAX_DIRTY_RECTS];
+        uint8_t _dirty_count;
+
+        // Extends the touched bounding box (coordinates already clipped)
+        inline void _touch(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+        {
+            if (x0 < _touch_x0) _touch_x0 = x0;
+            if (y0 < _touch_y0) _touch_y0 = y0;
+            if (x1 > _touch_x1) _touch_x1 = x1;
+            if (y1 > _touch_y1) _touch_y1 = y1;
+        }
+        // Resets the touched bounding box
+        void _resetTouch();
+        // Inserts a rectangle in the dirty list merging when worth it
+        void _addDirty(DirtyRect rect);
+
+};
+
+#endif
@@ -0,0 +1,414 @@
+#include "FrameLog.h"
+#include <esp_heap_caps.h>
+
+/**
+ * @brief Constructor.
+ * @param files File system to write into.
+ * @param camera Camera to read.
+ */
+FrameLog::FrameLog(FlashFiles* files, CameraHandler* camera)
+{
+    _files = files;
+    _camera = camera;
+    _index = NULL;
+    _max_frames = 0;
+    _interval_ms = 0;
+    _start_ms = 0;
+    _room = 0;
+    _overflow = false;
+    _task_handle = NULL;
+    _enabled = false;
+    _running = false;
+    memset(&_stats, 0, sizeof(_stats));
+    portMUX_INITIALIZE(&_mux);
+}
+
+/**
+ * @brief Starts recording in a task.
+ * @param name File of the log (replaced when it ends).
+ * @param interval_ms Time between frames, 0 = every frame the sensor gives (burst).
+ * @param max_frames Frames to record, 0 = until stop() or the flash is full.
+ * @param core Core of the task.
+ * @return False if it is already recording or there is no room.
+ */
+bool FrameLog::start(const char* name, uint32_t interval_ms, uint16_t max_frames, uint8_t core)
+{
+    if (_running || !_camera->isInitialized()) return false;
+    if (max_frames == 0 || max_frames > FRAME_LOG_MAX_FRAMES) max_frames = FRAME_LOG_MAX_FRAMES;
+    // The index grows in RAM (PSRAM if there is some) and is written at the end
+    uint32_t caps = psramFound() ? MALLOC_CAP_SPIRAM : MALLOC_CAP_8BIT;
+    _index = (FrameLogEntry*)heap_caps_malloc(max_frames * sizeof(FrameLogEntry), caps);
+    if (!_index) return false;
+    // The frames written so far survive a reset (see recover())
+    FrameLogHeader header = { FRAME_LOG_MAGIC, interval_ms };
+    if (!_writer.open(*_files, name, 0, true) || _writer.write((const uint8_t*)&header, sizeof(header)) != sizeof(header))
+    {
+        _writer.abort();
+        heap_caps_free(_index);
+        _index = NULL;
+        return false;
+    }
+    _max_frames = max_frames;
+    _interval_ms = interval_ms;
+    memset(&_stats, 0, sizeof(_stats));
+    _enabled = _running = true;
+    if (xTaskCreatePinnedToCore(_task, "orbito_log", FRAME_LOG_STACK, this, FRAME_LOG_PRIORITY, &_task_handle, core) == pdPASS) return true;
+    _enabled = _running = false;
+    _writer.abort();
+    heap_caps_free(_index);
+    _index = NULL;
+    return false;
+}
+
+/**
+ * @brief Ends the recording and waits until the log is complete.
+ */
+void FrameLog::stop()
+{
+    portENTER_CRITICAL(&_mux);
+    _enabled = false;
+    TaskHandle_t task = _running ? _task_handle : NULL;
+    portEXIT_CRITICAL(&_mux);
+    // Wakes a timelapse that is waiting for its next frame
+    if (task) xTaskNotifyGive(task);
+    while (_running) vTaskDelay(pdMS_TO_TICKS(5));
+}
+
+/**
+ * @brief True until the log is complete (after stop() or the last frame).
+ */
+bool FrameLog::isRecording()
+{
+    return _running;
+}
+
+/**
+ * @brief Progress of the current (or last) recording.
+ */
+FrameLogStats FrameLog::getStats()
+{
+    portENTER_CRITICAL(&_mux);
+    FrameLogStats stats = _stats;
+    portEXIT_CRITICAL(&_mux);
+    return stats;
+}
+
+// Task entry point
+void FrameLog::_task(void* param)
+{
+    FrameLog* log = (FrameLog*)param;
+    log->_record();
+    portENTER_CRITICAL(&log->_mux);
+    log->_running = false;
+    log->_task_handle = NULL;
+    portEXIT_CRITICAL(&log->_mux);
+    vTaskDelete(NULL);
+}
+
+// Frame loop, it returns when the recording ends
+void FrameLog::_record()
+{
+    // Frames from the capture task if it runs (latest-only), from the camera otherwise
+    FrameSubscriber frames;
+    _camera->subscribe(frames);
+    bool full = false;
+    unsigned long next_ms = millis();
+    uint16_t count = 0;
+    // Burst: sensor time of the first and last frame written and the shortest gap
+    // between two of them (one sensor frame), the sensor frames in between were lost
+    int64_t first_us = 0, last_us = 0, period_us = 0;
+    while (_enabled && count < _max_frames && !full)
+    {
+        if (_interval_ms > 0)
+        {
+            // Timelapse: sleep until the next frame is due (stop() wakes it up)
+            long wait = (long)(next_ms - millis());
+            if (wait > 0 && ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(wait)) > 0) continue;
+            next_ms += _interval_ms;
+            // Too slow for the interval: no catching up with a burst
+            if ((long)(millis() - next_ms) > 0) next_ms = millis() + _interval_ms;
+            // The frame in the mailbox may be older than the interval
+            frames.take();
+        }
+        FrameRef frame = frames.wait(CAPTURE_WAIT_MS);
+        if (!frame) continue;
+        full = !_append(frame);
+        if (_stats.frames == count) continue;
+        count = _stats.frames;
+        if (_interval_ms == 0)
+        {
+            const struct timeval& stamp = frame.get()->timestamp;
+            int64_t now_us = (int64_t)stamp.tv_sec * 1000000 + stamp.tv_usec;
+            if (count == 1) first_us = now_us;
+            else if (now_us > last_us && (period_us == 0 || now_us - last_us < period_us)) period_us = now_us - last_us;
+            last_us = now_us;
+            uint32_t sensor = (period_us > 0) ? (last_us - first_us + period_us / 2) / period_us + 1 : count;
+            portENTER_CRITICAL(&_mux);
+            _stats.dropped = (sensor > count) ? sensor - count : 0;
+            portEXIT_CRITICAL(&_mux);
+        }
+    }
+    _camera->unsubscribe(frames);
+    portENTER_CRITICAL(&_mux);
+    _stats.full = full;
+    portEXIT_CRITICAL(&_mux);
+    _finish();
+}
+
+// Appends one frame and its index entry
+bool FrameLog::_append(const FrameRef& frame)
+{
+    bool is_jpeg = (frame.format() == PIXFORMAT_JPEG);
+    uint16_t count = _stats.frames;
+    // The mark, the index entries (this one included) and the trailer always keep their room
+    uint32_t reserved = sizeof(FrameLogMark) + (count + 1) * sizeof(FrameLogEntry) + sizeof(FrameLogTrailer);
+    uint32_t available = _writer.available();
+    if (available <= reserved) return false;
+    _room = available - reserved;
+    _overflow = false;
+    if (is_jpeg && frame.length() > _room) return false;
+    unsigned long captured = millis() - frame.age();
+    if (count == 0) _start_ms = captured;
+    // The mark goes first with its length blank, it is filled once the JPEG is complete
+    uint32_t mark_offset = _writer.size();
+    FrameLogMark mark = { 0xFFFFFFFF, (uint32_t)(captured - _start_ms) };
+    if (_writer.write((const uint8_t*)&mark, sizeof(mark)) != sizeof(mark)) return false;
+    uint32_t offset = _writer.size();
+    bool written;
+    if (is_jpeg) written = (_writer.write(frame.data(), frame.length()) == frame.length());
+    else written = _camera->convertFrameToJpeg(const_cast<camera_fb_t*>(frame.get()), _encoded, this);
+    // The encoder does not stop on a short write, _encoded() tells. What was written
+    // of this frame stays in the file, after an open mark and out of the index.
+    if (!written || _overflow || _writer.failed()) return false;
+    mark.length = _writer.size() - offset;
+    if (!_writer.patch(mark_offset, (const uint8_t*)&mark.length, sizeof(mark.length))) return false;
+    _index[count].offset = offset;
+    _index[count].time_ms = mark.time_ms;
+    unsigned long elapsed = millis() - _start_ms;
+    portENTER_CRITICAL(&_mux);
+    _stats.frames = count + 1;
+    _stats.bytes += mark.length;
+    _stats.elapsed_ms = elapsed;
+    _stats.fps = (elapsed > 0) ? _stats.frames * 1000.0f / elapsed : 0;
+    portEXIT_CRITICAL(&_mux);
+    return true;
+}
+
+// Writes the index and the trailer and publishes the file
+bool FrameLog::_finish()
+{
+    FrameLogTrailer trailer;
+    trailer.magic = FRAME_LOG_MAGIC;
+    trailer.count = _stats.frames;
+    trailer.index_offset = _writer.size();
+    trailer.interval_ms = _interval_ms;
+    // Pages can't be taken back: a frame cut short stays before the index, out of it
+    _writer.write((const uint8_t*)_index, trailer.count * sizeof(FrameLogEntry));
+    _writer.write((const uint8_t*)&trailer, sizeof(trailer));
+    bool done = _writer.close();
+    heap_caps_free(_index);
+    _index = NULL;
+    return done;
+}
+
+/**
+ * @brief Finishes the logs a reset left open (call it after FlashFiles::begin()).
+ * Their complete frames get an index and the file is published as if stop()
+ * had been called. A log without any complete frame is removed.
+ * @return Logs recovered.
+ */
+uint8_t FrameLog::recover()
+{
+    if (!_files->isMounted()) return 0;
+    FlashLock guard(*_files->_flash);
+    uint8_t recovered = 0;
+    for (int16_t slot = 0 ; slot < (int16_t)FLASH_FILES_MAX ; slot++)
+    {
+        const FlashFileEntry& entry = _files->_dir[slot];
+        if (entry.state != FLASH_ENTRY_WRITING || entry.flags != FLASH_FILE_RECOVERABLE) continue;
+        if (_recoverLog(slot)) recovered++;
+    }
+    return recovered;
+}
+
+// Rebuilds the index of a log from its marks and publishes it (flash locked)
+bool FrameLog::_recoverLog(int16_t slot)
+{
+    FlashHandler* flash = _files->_flash;
+    FlashFileEntry entry = _files->_dir[slot];
+    // Cut between the size and the state of the entry: the index is already there
+    if (entry.size != 0xFFFFFFFF)
+    {
+        _files->_publish(slot, entry.size);
+        return true;
+    }
+    uint32_t room = _files->_gapEnd(entry.addr) - entry.addr;
+    FrameLogHeader header;
+    flash->read(entry.addr, (uint8_t*)&header, sizeof(header));
+    // Complete frames: each mark gives the length of its JPEG, an open one ends them
+    uint32_t end = sizeof(header);
+    uint16_t count = 0;
+    FrameLogMark mark;
+    while (header.magic == FRAME_LOG_MAGIC && count < FRAME_LOG_MAX_FRAMES && end + sizeof(mark) <= room)
+    {
+        flash->read(entry.addr + end, (uint8_t*)&mark, sizeof(mark));
+        if (mark.length == 0xFFFFFFFF || mark.length > room - end - sizeof(mark)) break;
+        end += sizeof(mark) + mark.length;
+        count++;
+    }
+    // The index goes on the first blank page after what was written (a cut frame included)
+    uint32_t index_offset = (end + W25Q_PAGE_SIZE - 1) / W25Q_PAGE_SIZE * W25Q_PAGE_SIZE;
+    while (index_offset < room && !flash->isBlank(entry.addr + index_offset, W25Q_PAGE_SIZE)) index_offset += W25Q_PAGE_SIZE;
+    // Frames without room for their index entry are left out, from the last one
+    while (count > 0 && index_offset + count * sizeof(FrameLogEntry) + sizeof(FrameLogTrailer) > room) count--;
+    if (count == 0)
+    {
+        _files->_setState(slot, FLASH_ENTRY_DELETED);
+        _files->_eraseArea(entry.addr, min(index_offset, room));
+        return false;
+    }
+    // The marks are walked again, the entries go out a few at a time
+    FrameLogEntry entries[16];
+    uint32_t pos = sizeof(header);
+    uint32_t at = entry.addr + index_offset;
+    for (uint16_t done = 0 ; done < count ; )
+    {
+        uint16_t n = min((uint16_t)16, (uint16_t)(count - done));
+        for (uint16_t i = 0 ; i < n ; i++)
+        {
+            flash->read(entry.addr + pos, (uint8_t*)&mark, sizeof(mark));
+            entries[i].offset = pos + sizeof(mark);
+            entries[i].time_ms = mark.time_ms;
+            pos += sizeof(mark) + mark.length;
+        }
+        flash->write(at, (const uint8_t*)entries, n * sizeof(FrameLogEntry));
+        at += n * sizeof(FrameLogEntry);
+        done += n;
+    }
+    FrameLogTrailer trailer = { FRAME_LOG_MAGIC, count, index_offset, header.interval_ms };
+    flash->write(at, (const uint8_t*)&trailer, sizeof(trailer));
+    _files->_publish(slot, index_offset + count * sizeof(FrameLogEntry) + sizeof(FrameLogTrailer));
+    return true;
+}
+
+// Receives the JPEG encoder output. It ignores a short count and goes on: the
+// overflow is remembered and nothing more is written (the index keeps its room).
+size_t FrameLog::_encoded(void* arg, size_t index, const void* data, size_t len)
+{
+    FrameLog* log = (FrameLog*)arg;
+    if (len == 0 || log->_overflow) return 0;
+    if (len > log->_room)
+    {
+        log->_overflow = true;
+        return 0;
+    }
+    size_t written = log->_writer.write((const uint8_t*)data, len);
+    log->_room -= written;
+    return written;
+}
+
+/**
+ * @brief Constructor. Nothing is open.
+ */
+FrameLogReader::FrameLogReader()
+{
+    _flash = NULL;
+    _addr = 0;
+    memset(&_trailer, 0, sizeof(_trailer));
+    _current = -1;
+    _offset = _length = _time_ms = 0;
+}
+
+/**
+ * @brief Opens a log written by FrameLog.
+ * @return False if the file does not exist or is not a complete log.
+ */
+bool FrameLogReader::open(FlashFiles& files, const char* name)
+{
+    _flash = NULL;
+    _current = -1;
+    FlashLock guard(*files._flash);
+    uint32_t addr, size;
+    if (!files._lookup(name, addr, size) || size < sizeof(FrameLogTrailer)) return false;
+    files._flash->read(addr + size - sizeof(FrameLogTrailer), (uint8_t*)&_trailer, sizeof(_trailer));
+    uint32_t index_end = _trailer.index_offset + _trailer.count * sizeof(FrameLogEntry);
+    if (_trailer.magic != FRAME_LOG_MAGIC || index_end + sizeof(FrameLogTrailer) != size) return false;
+    _flash = files._flash;
+    _addr = addr;
+    return true;
+}
+
+/**
+ * @brief Frames in the log and time between them (0 = burst).
+ */
+uint16_t FrameLogReader::count() const
+{
+    return _flash ? _trailer.count : 0;
+}
+
+uint32_t FrameLogReader::interval() const
+{
+    return _trailer.interval_ms;
+}
+
+/**
+ * @brief Moves to a frame (next() goes on from there).
+ */
+bool FrameLogReader::seek(uint16_t index)
+{
+    if (!_flash || index >= _trailer.count) return false;
+    _current = (int32_t)index - 1;
+    return next();
+}
+
+/**
+ * @brief Moves to the next frame (the first one after open()).
+ * @return False at the end of the log.
+ */
+bool FrameLogReader::next()
+{
+    if (!_flash || _current + 1 >= (int32_t)_trailer.count) return false;
+    FlashLock guard(*_flash);
+    _current++;
+    // The entry gives the place of the JPEG, its mark (just before it) the length
+    FrameLogEntry entry;
+    FrameLogMark mark;
+    _flash->read(_addr + _trailer.index_offset + _current * sizeof(FrameLogEntry), (uint8_t*)&entry, sizeof(entry));
+    _flash->read(_addr + entry.offset - sizeof(mark), (uint8_t*)&mark, sizeof(mark));
+    _offset = entry.offset;
+    _time_ms = entry.time_ms;
+    _length = (entry.offset >= sizeof(mark) && mark.length <= _trailer.index_offset - entry.offset) ? mark.length : 0;
+    return true;
+}
+
+/**
+ * @brief Current frame: position, JPEG size and capture time since the start.
+ */
+uint16_t FrameLogReader::index() const
+{
+    return _current < 0 ? 0 : _current;
+}
+
+uint32_t FrameLogReader::length() const
+{
+    return _current < 0 ? 0 : _length;
+}
+
+uint32_t FrameLogReader::timestamp() const
+{
+    return _current < 0 ? 0 : _time_ms;
+}
+
+/**
+ * @brief Reads part of the current frame.
+ * @param offset First byte inside the frame.
+ * @return Bytes read.
+ */
+size_t FrameLogReader::read(uint32_t offset, uint8_t* buffer, size_t len)
+{
+    if (!_flash || _current < 0 || offset >= _length) return 0;
+    if (len > _length - offset) len = _length - offset;
+    FlashLock guard(*_flash);
+    _flash->read(_addr + _offset + offset, buffer, len);
+    return len;
+}
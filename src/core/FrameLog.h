@@ -0,0 +1,211 @@
+#ifndef FRAME_LOG_H
+#define FRAME_LOG_H
+
+#include <Arduino.h>
+#include "./FlashFiles.h"
+#include "./CameraHandler.h"
+
+// Recording task: priority (below the capture task) and stack
+#define FRAME_LOG_PRIORITY 1
+#define FRAME_LOG_STACK    4096
+// Frames of a log when no limit is given (the index takes 8 bytes per frame in RAM)
+#define FRAME_LOG_MAX_FRAMES 2048
+// Signature of the trailer ("OLOG")
+#define FRAME_LOG_MAGIC 0x474F4C4F
+
+/**
+ * @brief First 8 bytes of a log file.
+ */
+struct FrameLogHeader {
+    uint32_t magic;
+    uint32_t interval_ms;   // 0 = burst
+};
+
+/**
+ * @brief Written before every JPEG: its length (0xFFFFFFFF until the JPEG is
+ * complete) and its capture time. A log cut by a reset is rebuilt from them.
+ */
+struct FrameLogMark {
+    uint32_t length;
+    uint32_t time_ms;
+};
+
+/**
+ * @brief Position of a frame in a log file.
+ */
+struct FrameLogEntry {
+    uint32_t offset;        // First byte of the JPEG in the file
+    uint32_t time_ms;       // Capture time since the start of the recording
+};
+
+/**
+ * @brief Last 16 bytes of a log file.
+ */
+struct FrameLogTrailer {
+    uint32_t magic;
+    uint32_t count;         // Frames in the log
+    uint32_t index_offset;  // count entries, then this trailer
+    uint32_t interval_ms;   // 0 = burst
+};
+
+/**
+ * @brief Progress of a recording (see FrameLog::getStats()).
+ */
+struct FrameLogStats {
+    uint16_t frames;        // Frames written
+    uint32_t dropped;       // Sensor frames lost in a burst (from the sensor timestamps)
+    uint32_t bytes;         // JPEG bytes written
+    uint32_t elapsed_ms;    // Time since the first frame
+    float fps;              // Frames written per second
+    bool full;              // Stopped because the flash ran out
+};
+
+/**
+ * @brief Records camera frames into one append-only file: a header, the JPEGs
+ * one after another (each one after its mark), then a compact index (offset and
+ * time of each frame) and a trailer. The entry of the file is recoverable: after
+ * a reset, recover() keeps the complete frames of a recording that never ended.
+ * A task takes the frames (from the capture task if it runs) and streams them to
+ * the flash while the sensor goes on. Frames the flash is too slow for are skipped
+ * and counted in the stats.
+ * The file appears in Storage once the recording ends.
+ */
+class FrameLog {
+
+    public:
+
+        /**
+         * @brief Constructor.
+         * @param files File system to write into.
+         * @param camera Camera to read.
+         */
+        FrameLog(FlashFiles* files, CameraHandler* camera);
+
+        /**
+         * @brief Starts recording in a task.
+         * @param name File of the log (replaced when it ends).
+         * @param interval_ms Time between frames, 0 = every frame the sensor gives (burst).
+         * @param max_frames Frames to record, 0 = until stop() or the flash is full.
+         * @param core Core of the task.
+         * @return False if it is already recording or there is no room.
+         */
+        bool start(const char* name, uint32_t interval_ms, uint16_t max_frames = 0, uint8_t core = 0);
+
+        /**
+         * @brief Ends the recording and waits until the log is complete.
+         */
+        void stop();
+
+        /**
+         * @brief True until the log is complete (after stop() or the last frame).
+         */
+        bool isRecording();
+
+        /**
+         * @brief Progress of the current (or last) recording.
+         */
+        FrameLogStats getStats();
+
+        /**
+         * @brief Finishes the logs a reset left open (call it after FlashFiles::begin()).
+         * Their complete frames get an index and the file is published as if stop()
+         * had been called. A log without any complete frame is removed.
+         * @return Logs recovered.
+         */
+        uint8_t recover();
+
+    private:
+
+        FlashFiles* _files;
+        CameraHandler* _camera;
+        FlashFileWriter _writer;
+        FrameLogEntry* _index;      // Kept in RAM, written at the end
+        uint16_t _max_frames;
+        uint32_t _interval_ms;
+        unsigned long _start_ms;
+        uint32_t _room;             // Bytes the frame being encoded may still take
+        bool _overflow;             // It did not fit
+        TaskHandle_t _task_handle;
+        volatile bool _enabled;
+        volatile bool _running;
+        FrameLogStats _stats;
+        portMUX_TYPE _mux;
+
+        // Task entry point
+        static void _task(void* param);
+        // Frame loop, it returns when the recording ends
+        void _record();
+        // Appends one frame and its index entry
+        bool _append(const FrameRef& frame);
+        // Writes the index and the trailer and publishes the file
+        bool _finish();
+        // Rebuilds the index of a log from its marks and publishes it (flash locked)
+        bool _recoverLog(int16_t slot);
+        // Receives the JPEG encoder output (nothing past _room)
+        static size_t _encoded(void* arg, size_t index, const void* data, size_t len);
+
+};
+
+/**
+ * @brief Walks the frames of a log. Only one index entry is read per frame, so
+ * a long log needs no RAM for its index.
+ */
+class FrameLogReader {
+
+    public:
+
+        /**
+         * @brief Constructor. Nothing is open.
+         */
+        FrameLogReader();
+
+        /**
+         * @brief Opens a log written by FrameLog.
+         * @return False if the file does not exist or is not a complete log.
+         */
+        bool open(FlashFiles& files, const char* name);
+
+        /**
+         * @brief Frames in the log and time between them (0 = burst).
+         */
+        uint16_t count() const;
+        uint32_t interval() const;
+
+        /**
+         * @brief Moves to a frame (next() goes on from there).
+         */
+        bool seek(uint16_t index);
+
+        /**
+         * @brief Moves to the next frame (the first one after open()).
+         * @return False at the end of the log.
+         */
+        bool next();
+
+        /**
+         * @brief Current frame: position, JPEG size and capture time since the start.
+         */
+        uint16_t index() const;
+        uint32_t length() const;
+        uint32_t timestamp() const;
+
+        /**
+         * @brief Reads part of the current frame.
+         * @param offset First byte inside the frame.
+         * @return Bytes read.
+         */
+        size_t read(uint32_t offset, uint8_t* buffer, size_t len);
+
+    private:
+
+        FlashHandler* _flash;
+        uint32_t _addr;             // Flash address of the file
+        FrameLogTrailer _trailer;
+        int32_t _current;           // -1 before the first next()
+        uint32_t _offset;
+        uint32_t _length;
+        uint32_t _time_ms;
+
+};
+
+#endif
@@ -0,0 +1,133 @@
+#include "FrameRef.h"
+#include "CameraHandler.h"
+
+/**
+ * @brief Empty handle (no frame).
+ */
+FrameRef::FrameRef()
+{
+    _lease = NULL;
+}
+
+// Takes over a reference already counted in the lease (see CameraHandler)
+FrameRef::FrameRef(FrameLease* lease)
+{
+    _lease = lease;
+}
+
+FrameRef::FrameRef(const FrameRef& other)
+{
+    _lease = other._lease;
+    if (_lease) _lease->refs.fetch_add(1, std::memory_order_relaxed);
+}
+
+FrameRef::FrameRef(FrameRef&& other)
+{
+    _lease = other._lease;
+    other._lease = NULL;
+}
+
+FrameRef& FrameRef::operator=(const FrameRef& other)
+{
+    // Count the new one first, so assigning a handle to itself is safe
+    if (other._lease) other._lease->refs.fetch_add(1, std::memory_order_relaxed);
+    reset();
+    _lease = other._lease;
+    return *this;
+}
+
+FrameRef& FrameRef::operator=(FrameRef&& other)
+{
+    if (this == &other) return *this;
+    reset();
+    _lease = other._lease;
+    other._lease = NULL;
+    return *this;
+}
+
+/**
+ * @brief Drops this reference (the last one gives the buffer back).
+ */
+FrameRef::~FrameRef()
+{
+    reset();
+}
+
+/**
+ * @brief Drops the frame now instead of at the end of the scope.
+ */
+void FrameRef::reset()
+{
+    if (!_lease) return;
+    FrameLease* lease = _lease;
+    _lease = NULL;
+    // Only one holder sees the count go from 1 to 0
+    if (lease->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) lease->owner->_returnLease(lease);
+}
+
+/**
+ * @brief True if the handle holds a frame.
+ */
+bool FrameRef::valid() const
+{
+    return _lease != NULL;
+}
+
+FrameRef::operator bool() const
+{
+    return _lease != NULL;
+}
+
+/**
+ * @brief The frame itself. Its pixels are shared: do not modify them.
+ */
+const camera_fb_t* FrameRef::get() const
+{
+    return _lease ? _lease->fb : NULL;
+}
+
+const camera_fb_t* FrameRef::operator->() const
+{
+    return get();
+}
+
+const uint8_t* FrameRef::data() const
+{
+    return _lease ? _lease->fb->buf : NULL;
+}
+
+size_t FrameRef::length() const
+{
+    return _lease ? _lease->fb->len : 0;
+}
+
+uint16_t FrameRef::width() const
+{
+    return _lease ? _lease->fb->width : 0;
+}
+
+uint16_t FrameRef::height() const
+{
+    return _lease ? _lease->fb->height : 0;
+}
+
+pixformat_t FrameRef::format() const
+{
+    return _lease ? _lease->fb->format : PIXFORMAT_JPEG;
+}
+
+/**
+ * @brief Milliseconds since the frame was captured.
+ */
+unsigned long FrameRef::age() const
+{
+    return _lease ? millis() - _lease->captured_ms : 0;
+}
+
+/**
+ * @brief Number of handles sharing this frame (0 without frame).
+ */
+uint16_t FrameRef::useCount() const
+{
+    return _lease ? _lease->refs.load(std::memory_order_relaxed) : 0;
+}
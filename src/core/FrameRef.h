@@ -0,0 +1,95 @@
+#ifndef FRAME_REF_H
+#define FRAME_REF_H
+
+#include <Arduino.h>
+#include <atomic>
+#include "esp_camera.h"
+
+// Frames that can be out of the driver at the same time (it has 2 buffers with PSRAM)
+#define FRAME_LEASES 4
+
+class CameraHandler;
+
+/**
+ * @brief One frame buffer taken from the camera driver and the number of
+ * FrameRef that point to it. It goes back to the driver when the count hits 0.
+ */
+struct FrameLease {
+    camera_fb_t* fb;                // NULL = free slot
+    std::atomic<uint16_t> refs;
+    unsigned long captured_ms;      // millis() when it was taken
+    CameraHandler* owner;
+};
+
+/**
+ * @brief Shared, read-only handle to a camera frame. Copies are cheap (one
+ * atomic increment) and see the same pixels, the buffer is returned to the
+ * driver when the last copy is destroyed or reset(). There is nothing to
+ * release by hand, so a frame can not be leaked or returned twice.
+ */
+class FrameRef {
+
+    public:
+
+        /**
+         * @brief Empty handle (no frame).
+         */
+        FrameRef();
+
+        FrameRef(const FrameRef& other);
+        FrameRef(FrameRef&& other);
+        FrameRef& operator=(const FrameRef& other);
+        FrameRef& operator=(FrameRef&& other);
+
+        /**
+         * @brief Drops this reference (the last one gives the buffer back).
+         */
+        ~FrameRef();
+
+        /**
+         * @brief Drops the frame now instead of at the end of the scope.
+         */
+        void reset();
+
+        /**
+         * @brief True if the handle holds a frame.
+         */
+        bool valid() const;
+        explicit operator bool() const;
+
+        /**
+         * @brief The frame itself. Its pixels are shared: do not modify them.
+         */
+        const camera_fb_t* get() const;
+        const camera_fb_t* operator->() const;
+
+        // Shortcuts to the frame fields (0 / NULL without frame)
+        const uint8_t* data() const;
+        size_t length() const;
+        uint16_t width() const;
+        uint16_t height() const;
+        pixformat_t format() const;
+
+        /**
+         * @brief Milliseconds since the frame was captured.
+         */
+        unsigned long age() const;
+
+        /**
+         * @brief Number of handles sharing this frame (0 without frame).
+         */
+        uint16_t useCount() const;
+
+    private:
+
+        FrameLease* _lease;
+
+        // Takes over a reference already counted in the lease (see CameraHandler)
+        explicit FrameRef(FrameLease* lease);
+
+        friend class CameraHandler;
+        friend class FrameSubscriber;
+
+};
+
+#endif
@@ -0,0 +1,158 @@
+#include "FrameSubscriber.h"
+#include "CameraHandler.h"
+
+/**
+ * @brief Constructor. Receives nothing until CameraHandler::subscribe().
+ */
+FrameSubscriber::FrameSubscriber()
+{
+    _camera = NULL;
+    _slot = NULL;
+    _ready = NULL;
+    _interval_ms = 0;
+    _every = 1;
+    _seen = 0;
+    _next_ms = 0;
+    _delivered = 0;
+    _dropped = 0;
+}
+
+/**
+ * @brief Destructor. Unsubscribes and drops the unread frame.
+ */
+FrameSubscriber::~FrameSubscriber()
+{
+    if (_camera) _camera->unsubscribe(*this);
+    _withdraw();
+    if (_ready) vSemaphoreDelete(_ready);
+}
+
+/**
+ * @brief True while it is registered in a camera.
+ */
+bool FrameSubscriber::isSubscribed() const
+{
+    return _camera != NULL;
+}
+
+/**
+ * @brief True if a frame is waiting in the mailbox.
+ */
+bool FrameSubscriber::available() const
+{
+    return _slot.load(std::memory_order_acquire) != NULL;
+}
+
+/**
+ * @brief Takes the frame in the mailbox without waiting.
+ * @return Empty FrameRef if there is none.
+ */
+FrameRef FrameSubscriber::take()
+{
+    // The reference held by the mailbox moves to the caller
+    FrameLease* lease = _slot.exchange(NULL, std::memory_order_acq_rel);
+    if (lease) _delivered.fetch_add(1, std::memory_order_relaxed);
+    return FrameRef(lease);
+}
+
+/**
+ * @brief Waits for the next frame. Without the capture task a new frame is
+ * captured here (respecting the max_fps of the subscription).
+ * @param timeout_ms Maximum wait.
+ * @return Empty FrameRef on timeout.
+ */
+FrameRef FrameSubscriber::wait(uint32_t timeout_ms)
+{
+    if (!_camera) return FrameRef();
+    if (!_camera->isCapturing())
+    {
+        if (_interval_ms)
+        {
+            long left = (long)(_next_ms - millis());
+            if (left > 0) vTaskDelay(pdMS_TO_TICKS(left));
+            _next_ms = millis() + _interval_ms;
+        }
+        FrameRef frame = _camera->captureFrame();
+        if (frame) _delivered.fetch_add(1, std::memory_order_relaxed);
+        return frame;
+    }
+    unsigned long start = millis();
+    for (;;)
+    {
+        FrameRef frame = take();
+        if (frame) return frame;
+        unsigned long elapsed = millis() - start;
+        if (elapsed >= timeout_ms || !_camera) return FrameRef();
+        xSemaphoreTake(_ready, pdMS_TO_TICKS(timeout_ms - elapsed));
+    }
+}
+
+/**
+ * @brief Frames taken by the consumer and frames replaced before being read.
+ */
+uint32_t FrameSubscriber::delivered() const
+{
+    return _delivered.load(std::memory_order_relaxed);
+}
+
+uint32_t FrameSubscriber::dropped() const
+{
+    return _dropped.load(std::memory_order_relaxed);
+}
+
+// Prepares the mailbox for a camera (see CameraHandler::subscribe())
+bool FrameSubscriber::_attach(CameraHandler* camera, uint8_t max_fps, uint8_t every_nth)
+{
+    if (!_ready) _ready = xSemaphoreCreateBinary();
+    if (!_ready) return false;
+    _camera = camera;
+    _interval_ms = max_fps ? 1000 / max_fps : 0;
+    _every = every_nth ? every_nth : 1;
+    _seen = 0;
+    _next_ms = millis();
+    return true;
+}
+
+// Applies the every_nth and max_fps filters to a new frame (capture task only)
+bool FrameSubscriber::_accepts(unsigned long now)
+{
+    if (++_seen < _every) return false;
+    if (_interval_ms)
+    {
+        if ((long)(now - _next_ms) < 0) return false;
+        _next_ms += _interval_ms;
+        // Far behind (paused or slow sensor): start counting from now
+        if ((long)(now - _next_ms) >= 0) _next_ms = now + _interval_ms;
+    }
+    _seen = 0;
+    return true;
+}
+
+// Puts a frame in the mailbox, the unread one is dropped (capture task only)
+void FrameSubscriber::_offer(const FrameRef& frame)
+{
+    FrameRef mailbox(frame);
+    FrameRef unread(_slot.exchange(mailbox._lease, std::memory_order_acq_rel));
+    mailbox._lease = NULL;
+    if (unread) _dropped.fetch_add(1, std::memory_order_relaxed);
+    _wake();
+}
+
+// Empties the mailbox
+void FrameSubscriber::_withdraw()
+{
+    FrameRef unread(_slot.exchange(NULL, std::memory_order_acq_rel));
+}
+
+// Same, the unread frame counts as dropped (capture task only)
+void FrameSubscriber::_reclaim()
+{
+    FrameRef unread(_slot.exchange(NULL, std::memory_order_acq_rel));
+    if (unread) _dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Wakes a consumer blocked in wait()
+void FrameSubscriber::_wake()
+{
+    if (_ready) xSemaphoreGive(_ready);
+}
@@ -0,0 +1,96 @@
+#ifndef FRAME_SUBSCRIBER_H
+#define FRAME_SUBSCRIBER_H
+
+#include <Arduino.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include "FrameRef.h"
+
+// Subscribers the capture task can feed at the same time
+#define FRAME_SUBSCRIBERS 6
+
+class CameraHandler;
+
+/**
+ * @brief Mailbox for the frames published by the capture task (see
+ * CameraHandler::startCapture()). The task drops the newest frame in the
+ * mailbox without waiting: an unread frame is replaced (latest-only), so a
+ * slow consumer only skips frames and never slows the sensor or the others.
+ * Without the capture task, wait() simply asks the camera for a frame.
+ */
+class FrameSubscriber {
+
+    public:
+
+        /**
+         * @brief Constructor. Receives nothing until CameraHandler::subscribe().
+         */
+        FrameSubscriber();
+
+        /**
+         * @brief Destructor. Unsubscribes and drops the unread frame.
+         */
+        ~FrameSubscriber();
+
+        /**
+         * @brief True while it is registered in a camera.
+         */
+        bool isSubscribed() const;
+
+        /**
+         * @brief True if a frame is waiting in the mailbox.
+         */
+        bool available() const;
+
+        /**
+         * @brief Takes the frame in the mailbox without waiting.
+         * @return Empty FrameRef if there is none.
+         */
+        FrameRef take();
+
+        /**
+         * @brief Waits for the next frame. Without the capture task a new frame is
+         * captured here (respecting the max_fps of the subscription).
+         * @param timeout_ms Maximum wait.
+         * @return Empty FrameRef on timeout.
+         */
+        FrameRef wait(uint32_t timeout_ms = 1000);
+
+        /**
+         * @brief Frames taken by the consumer and frames lost before being read
+         * (replaced by a newer one or taken back because the driver needed the buffer).
+         */
+        uint32_t delivered() const;
+        uint32_t dropped() const;
+
+    private:
+
+        CameraHandler* _camera;
+        std::atomic<FrameLease*> _slot;     // Holds one reference of its frame
+        SemaphoreHandle_t _ready;           // Given on every frame published
+        uint32_t _interval_ms;              // 0 = every frame
+        uint8_t _every;                     // Keep one frame out of _every
+        uint8_t _seen;
+        unsigned long _next_ms;             // Time the next frame is accepted
+        std::atomic<uint32_t> _delivered;
+        std::atomic<uint32_t> _dropped;
+
+        // Prepares the mailbox for a camera (see CameraHandler::subscribe())
+        bool _attach(CameraHandler* camera, uint8_t max_fps, uint8_t every_nth);
+        // Applies the every_nth and max_fps filters to a new frame (capture task only)
+        bool _accepts(unsigned long now);
+        // Puts a frame in the mailbox, the unread one is dropped (capture task only)
+        void _offer(const FrameRef& frame);
+        // Empties the mailbox
+        void _withdraw();
+        // Same, the unread frame counts as dropped (capture task only)
+        void _reclaim();
+        // Wakes a consumer blocked in wait()
+        void _wake();
+
+        friend class CameraHandler;
+
+};
+
+#endif
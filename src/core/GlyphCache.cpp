@@ -0,0 +1,115 @@
+#include "GlyphCache.h"
+
+// Surface that only records the pixels of one glyph cell
+class _GlyphCapture : public Adafruit_GFX {
+
+    public:
+
+        uint8_t cols[5];
+
+        _GlyphCapture() : Adafruit_GFX(GLYPH_WIDTH, GLYPH_HEIGHT)
+        {
+            memset(cols, 0, sizeof(cols));
+        }
+
+        void drawPixel(int16_t x, int16_t y, uint16_t color) override
+        {
+            if (color && x >= 0 && x < 5 && y >= 0 && y < GLYPH_HEIGHT) cols[x] |= (1 << y);
+        }
+
+};
+
+/**
+ * @brief Constructor. Glyphs are rendered the first time they are used.
+ */
+GlyphCache::GlyphCache()
+{
+    memset(_ready, 0, sizeof(_ready));
+}
+
+/**
+ * @brief Mask of a character: 5 column bytes, bit 0 is the top row.
+ */
+const uint8_t* GlyphCache::get(uint8_t c)
+{
+    if (!(_ready[c >> 3] & (1 << (c & 7))))
+    {
+        _GlyphCapture capture;
+        // Same fg and bg: only the glyph pixels are drawn
+        capture.drawChar(0, 0, c, 1, 1, 1);
+        memcpy(_masks[c], capture.cols, 5);
+        _ready[c >> 3] |= (1 << (c & 7));
+    }
+    return _masks[c];
+}
+
+/**
+ * @brief Expands part of a text run into a pixel buffer (big-endian RGB565).
+ * The run is one line of text: count * 6 * size wide and 8 * size high.
+ * @param dst Buffer where pixel (col0, row0) of the run goes.
+ * @param stride Pixels per row of dst.
+ * @param size Text size (1, 2, 3...).
+ * @param fg Text color (panel byte order).
+ * @param bg Background color (panel byte order).
+ * @param opaque False to leave background pixels untouched.
+ * @param row0 First row of the run to expand.
+ * @param rows Number of rows.
+ * @param col0 First column of the run to expand.
+ * @param cols Number of columns.
+ */
+void GlyphCache::expandRun(uint16_t* dst, int16_t stride, const char* text, uint16_t count, uint8_t size, uint16_t fg, uint16_t bg,
+                           bool opaque, int16_t row0, int16_t rows, int16_t col0, int16_t cols)
+{
+    int16_t cell = GLYPH_WIDTH * size;
+    int16_t first = col0 / cell;
+    int16_t last = min((int16_t)count, (int16_t)((col0 + cols + cell - 1) / cell));
+    for (int16_t r = 0 ; r < rows ; r++)
+    {
+        uint8_t bit = 1 << ((row0 + r) / size);
+        uint16_t* out = dst + r * stride - col0;
+        for (int16_t i = first ; i < last ; i++)
+        {
+            const uint8_t* mask = get((uint8_t)text[i]);
+            int16_t x = i * cell;
+            for (uint8_t gx = 0 ; gx < GLYPH_WIDTH ; gx++)
+            {
+                bool on = (gx < 5) && (mask[gx] & bit);
+                if (!on && !opaque)
+                {
+                    x += size;
+                    continue;
+                }
+                uint16_t color = on ? fg : bg;
+                // Each font pixel is size x 1 here, clipped to the requested columns
+                for (uint8_t s = 0 ; s < size ; s++, x++)
+                    if (x >= col0 && x < col0 + cols) out[x] = color;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Draws a text run with transparent background as horizontal spans.
+ * Only "write" primitives are used, the caller opens the transaction.
+ */
+void GlyphCache::spanRun(Adafruit_GFX& gfx, int16_t x, int16_t y, const char* text, uint16_t count, uint8_t size, uint16_t color)
+{
+    for (uint16_t i = 0 ; i < count ; i++)
+    {
+        const uint8_t* mask = get((uint8_t)text[i]);
+        int16_t cx = x + i * GLYPH_WIDTH * size;
+        for (uint8_t gy = 0 ; gy < GLYPH_HEIGHT ; gy++)
+        {
+            uint8_t bit = 1 << gy;
+            // Consecutive lit columns become a single rectangle
+            for (uint8_t gx = 0 ; gx < 5 ; gx++)
+            {
+                if (!(mask[gx] & bit)) continue;
+                uint8_t run = 1;
+                while (gx + run < 5 && (mask[gx + run] & bit)) run++;
+                gfx.writeFillRect(cx + gx * size, y + gy * size, run * size, size, color);
+                gx += run;
+            }
+        }
+    }
+}
@@ -0,0 +1,61 @@
+#ifndef GLYPH_CACHE_H
+#define GLYPH_CACHE_H
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+
+// Classic Adafruit font cell (5x7 glyph + 1 column and 1 row of spacing)
+#define GLYPH_WIDTH  6
+#define GLYPH_HEIGHT 8
+
+/**
+ * @brief Cache of the built-in 5x7 font as 1-bit masks.
+ * Each glyph is rasterized once (through Adafruit's own drawChar, so the
+ * result is identical) and then whole runs of text are expanded at any size
+ * into a pixel buffer, or into a few spans when the background is transparent.
+ */
+class GlyphCache {
+
+    public:
+
+        /**
+         * @brief Constructor. Glyphs are rendered the first time they are used.
+         */
+        GlyphCache();
+
+        /**
+         * @brief Mask of a character: 5 column bytes, bit 0 is the top row.
+         */
+        const uint8_t* get(uint8_t c);
+
+        /**
+         * @brief Expands part of a text run into a pixel buffer (big-endian RGB565).
+         * The run is one line of text: count * 6 * size wide and 8 * size high.
+         * @param dst Buffer where pixel (col0, row0) of the run goes.
+         * @param stride Pixels per row of dst.
+         * @param size Text size (1, 2, 3...).
+         * @param fg Text color (panel byte order).
+         * @param bg Background color (panel byte order).
+         * @param opaque False to leave background pixels untouched.
+         * @param row0 First row of the run to expand.
+         * @param rows Number of rows.
+         * @param col0 First column of the run to expand.
+         * @param cols Number of columns.
+         */
+        void expandRun(uint16_t* dst, int16_t stride, const char* text, uint16_t count, uint8_t size, uint16_t fg, uint16_t bg,
+                       bool opaque, int16_t row0, int16_t rows, int16_t col0, int16_t cols);
+
+        /**
+         * @brief Draws a text run with transparent background as horizontal spans.
+         * Only "write" primitives are used, the caller opens the transaction.
+         */
+        void spanRun(Adafruit_GFX& gfx, int16_t x, int16_t y, const char* text, uint16_t count, uint8_t size, uint16_t color);
+
+    private:
+
+        uint8_t _masks[256][5];
+        uint8_t _ready[32];      // One bit per character already rendered
+
+};
+
+#endif
@@ -0,0 +1,153 @@
+#include "KeyframeStream.h"
+#include "FlashFiles.h"
+
+/**
+ * @brief Constructor. Nothing is open until open().
+ */
+KeyframeStream::KeyframeStream()
+{
+    _flash = NULL;
+    _base = _end = _cursor = 0;
+    _duration = 0;
+    _keys = _key_index = 0;
+    _flags = 0;
+}
+
+/**
+ * @brief Checks the header of an animation and gets ready to read it.
+ * @param flash Flash that holds it.
+ * @param addr Address of the header.
+ * @return False if there is no valid animation there.
+ */
+bool KeyframeStream::open(FlashHandler* flash, uint32_t addr)
+{
+    close();
+    uint8_t header[ANIM_HEADER_BYTES];
+    // Not in the middle of a Storage write (see FlashHandler::lock())
+    FlashLock guard(*flash);
+    flash->read(addr, header, ANIM_HEADER_BYTES);
+    uint32_t size = _parseHeader(header, _duration, _keys, _flags);
+    if (size == 0) return false;
+    _flash = flash;
+    _base = addr + ANIM_HEADER_BYTES;
+    _end = _base + size;
+    rewind();
+    return true;
+}
+
+/**
+ * @brief Forgets the open animation.
+ */
+void KeyframeStream::close()
+{
+    _flash = NULL;
+}
+
+/**
+ * @brief True while an animation is open.
+ */
+bool KeyframeStream::isOpen() const
+{
+    return _flash != NULL;
+}
+
+/**
+ * @brief Goes back to the first keyframe.
+ */
+void KeyframeStream::rewind()
+{
+    _cursor = _base;
+    _key_index = 0;
+}
+
+/**
+ * @brief Reads the next keyframe (they are stored in time order).
+ * @return False at the end (or if the data is damaged).
+ */
+bool KeyframeStream::next(Keyframe& key)
+{
+    if (!_flash || _key_index >= _keys || _cursor + ANIM_KEY_BYTES > _end) return false;
+    // Keyframe and the start of its payload in one read
+    uint8_t raw[ANIM_KEY_BYTES + ANIM_PARAM_BYTES];
+    size_t len = min((uint32_t)sizeof(raw), _end - _cursor);
+    FlashLock guard(*_flash);
+    _flash->read(_cursor, raw, len);
+    key.time_ms = animRead32(&raw[0]);
+    key.track = (AnimTrack)raw[4];
+    key.easing = raw[5];
+    key.length = animRead32(&raw[8]);
+    key.data_addr = _cursor + ANIM_KEY_BYTES;
+    if (key.length > _end - key.data_addr) return false;
+    memset(key.params, 0, ANIM_PARAM_BYTES);
+    memcpy(key.params, &raw[ANIM_KEY_BYTES], min((size_t)key.length, len - ANIM_KEY_BYTES));
+    _cursor = key.data_addr + key.length;
+    _key_index++;
+    return true;
+}
+
+/**
+ * @brief Reads part of the payload of a keyframe (frame pixels).
+ * @param offset Bytes from the start of the payload.
+ */
+void KeyframeStream::readData(const Keyframe& key, uint32_t offset, uint8_t* dst, size_t len)
+{
+    if (!_flash || offset >= key.length) return;
+    if (len > key.length - offset) len = key.length - offset;
+    FlashLock guard(*_flash);
+    _flash->read(key.data_addr + offset, dst, len);
+}
+
+uint32_t KeyframeStream::duration() const
+{
+    return _duration;
+}
+
+uint16_t KeyframeStream::keyCount() const
+{
+    return _keys;
+}
+
+bool KeyframeStream::loops() const
+{
+    return (_flags & ANIM_FLAG_LOOP) != 0;
+}
+
+/**
+ * @brief Copies an animation file to the flash (erases the sectors it needs).
+ * @param addr Destination address, must be the start of a sector (not sectors 0 and 1).
+ * The animation must end before FLASH_FILES_START (files live from there on).
+ * @return False if the data is not an ORBA animation or the address is not valid.
+ */
+bool KeyframeStream::store(FlashHandler& flash, uint32_t addr, const uint8_t* data, size_t len)
+{
+    // Sectors 0 and 1 hold the Storage directory
+    if (addr % W25Q_SECTOR_SIZE != 0 || addr < FLASH_FILES_DIR_END || len < ANIM_HEADER_BYTES) return false;
+    uint32_t duration;
+    uint16_t keys;
+    uint8_t flags;
+    uint32_t size = _parseHeader(data, duration, keys, flags);
+    if (size == 0 || size > len - ANIM_HEADER_BYTES) return false;
+    len = ANIM_HEADER_BYTES + size;
+    // Files start at FLASH_FILES_START
+    if (addr + len > FLASH_FILES_START) return false;
+    // Erase and program in one go, a file write can't slip in between
+    FlashLock guard(flash);
+    for (uint32_t sector = addr ; sector < addr + len ; sector += W25Q_SECTOR_SIZE)
+        flash.eraseSector(sector);
+    flash.write(addr, data, len);
+    flash.waitForReady();
+    return true;
+}
+
+// Checks a header, returns the data size (0 if not valid)
+uint32_t KeyframeStream::_parseHeader(const uint8_t* header, uint32_t& duration, uint16_t& keys, uint8_t& flags)
+{
+    if (animRead32(&header[0]) != ANIM_MAGIC || header[4] != ANIM_VERSION) return 0;
+    flags = header[5];
+    keys = animRead16(&header[6]);
+    duration = animRead32(&header[8]);
+    // Erased flash reads as 0xFF
+    uint32_t size = animRead32(&header[12]);
+    if (size == 0xFFFFFFFF || size < (uint32_t)keys * ANIM_KEY_BYTES) return 0;
+    return size;
+}
@@ -0,0 +1,125 @@
+#ifndef KEYFRAME_STREAM_H
+#define KEYFRAME_STREAM_H
+
+#include <Arduino.h>
+#include "./FlashHandler.h"
+
+// --- ORBA FORMAT (little-endian, made by extras/tools/orbito_anim.py) ---
+// Header:   "ORBA", version u8, flags u8, key count u16, duration ms u32, data bytes u32
+// Keyframe: time ms u32, track u8, easing u8, reserved u16, payload bytes u32, payload
+#define ANIM_MAGIC        0x4142524F    // "ORBA"
+#define ANIM_VERSION      1
+#define ANIM_HEADER_BYTES 16
+#define ANIM_KEY_BYTES    12
+#define ANIM_PARAM_BYTES  8             // Payload read together with the keyframe
+#define ANIM_FLAG_LOOP    0x01
+
+/**
+ * @brief What a keyframe changes. Payloads:
+ * EXPRESSION: emotion u8, reserved u8, transition ms u16.
+ * GAZE: pupil x i8, pupil y i8, movement ms u16.
+ * BLINK: nothing.
+ * FRAME: x i16, y i16, w u16, h u16, then w * h pixels (big-endian RGB565).
+ */
+enum AnimTrack : uint8_t {
+    ANIM_TRACK_EXPRESSION,
+    ANIM_TRACK_GAZE,
+    ANIM_TRACK_BLINK,
+    ANIM_TRACK_FRAME
+};
+
+/**
+ * @brief One keyframe read from the flash. Only the first ANIM_PARAM_BYTES of
+ * the payload are loaded, the rest (frame pixels) stays at data_addr.
+ */
+struct Keyframe {
+    uint32_t time_ms;       // Since the start of the animation
+    AnimTrack track;
+    uint8_t easing;         // Easing of the movement it starts
+    uint32_t length;        // Payload bytes
+    uint32_t data_addr;     // Flash address of the payload
+    uint8_t params[ANIM_PARAM_BYTES];
+};
+
+/**
+ * @brief Reads an ORBA animation stored in the external flash one keyframe
+ * at a time, so its length is only limited by the flash.
+ */
+class KeyframeStream {
+
+    public:
+
+        /**
+         * @brief Constructor. Nothing is open until open().
+         */
+        KeyframeStream();
+
+        /**
+         * @brief Checks the header of an animation and gets ready to read it.
+         * @param flash Flash that holds it.
+         * @param addr Address of the header.
+         * @return False if there is no valid animation there.
+         */
+        bool open(FlashHandler* flash, uint32_t addr);
+
+        /**
+         * @brief Forgets the open animation.
+         */
+        void close();
+
+        /**
+         * @brief True while an animation is open.
+         */
+        bool isOpen() const;
+
+        /**
+         * @brief Goes back to the first keyframe.
+         */
+        void rewind();
+
+        /**
+         * @brief Reads the next keyframe (they are stored in time order).
+         * @return False at the end (or if the data is damaged).
+         */
+        bool next(Keyframe& key);
+
+        /**
+         * @brief Reads part of the payload of a keyframe (frame pixels).
+         * @param offset Bytes from the start of the payload.
+         */
+        void readData(const Keyframe& key, uint32_t offset, uint8_t* dst, size_t len);
+
+        // Header fields
+        uint32_t duration() const;
+        uint16_t keyCount() const;
+        bool loops() const;
+
+        /**
+         * @brief Copies an animation file to the flash (erases the sectors it needs).
+         * @param addr Destination address, must be the start of a sector (not sectors 0 and 1).
+         * The animation must end before FLASH_FILES_START (files live from there on).
+         * @return False if the data is not an ORBA animation or the address is not valid.
+         */
+        static bool store(FlashHandler& flash, uint32_t addr, const uint8_t* data, size_t len);
+
+    private:
+
+        FlashHandler* _flash;
+        uint32_t _base;         // Address of the first keyframe
+        uint32_t _end;          // Address after the last one
+        uint32_t _cursor;       // Next keyframe
+        uint32_t _duration;
+        uint16_t _keys;
+        uint16_t _key_index;
+        uint8_t _flags;
+
+        // Checks a header, returns the data size (0 if not valid)
+        static uint32_t _parseHeader(const uint8_t* header, uint32_t& duration, uint16_t& keys, uint8_t& flags);
+
+};
+
+// Little-endian fields of the ORBA format
+inline uint16_t animRead16(const uint8_t* p) { return p[0] | (p[1] << 8); }
+inline uint32_t animRead32(const uint8_t* p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24); }
+
+#endif
@@ -0,0 +1,55 @@
+#include "LineRing.h"
+
+/**
+ * @brief Constructor. Starts empty.
+ */
+LineRing::LineRing()
+{
+    clear();
+}
+
+/**
+ * @brief Adds a line at the end (cut to CONSOLE_LINE_CHARS).
+ * @param len Characters of text to copy.
+ */
+void LineRing::push(const char* text, uint16_t len)
+{
+    if (len > CONSOLE_LINE_CHARS) len = CONSOLE_LINE_CHARS;
+    uint16_t slot;
+    if (_count < CONSOLE_HISTORY)
+    {
+        slot = (_head + _count) % CONSOLE_HISTORY;
+        _count++;
+    } else {
+        // Full: the oldest slot is reused
+        slot = _head;
+        _head = (_head + 1) % CONSOLE_HISTORY;
+    }
+    memcpy(_lines[slot], text, len);
+    _lines[slot][len] = '\0';
+}
+
+/**
+ * @brief Number of lines stored.
+ */
+uint16_t LineRing::count() const
+{
+    return _count;
+}
+
+/**
+ * @brief Gets a line. 0 is the oldest, count() - 1 the newest.
+ */
+const char* LineRing::line(uint16_t index) const
+{
+    return _lines[(_head + index) % CONSOLE_HISTORY];
+}
+
+/**
+ * @brief Forgets every line.
+ */
+void LineRing::clear()
+{
+    _head = 0;
+    _count = 0;
+}
@@ -0,0 +1,52 @@
+#ifndef LINE_RING_H
+#define LINE_RING_H
+
+#include <Arduino.h>
+
+// Console history configuration
+#define CONSOLE_HISTORY    48    // Lines kept in memory (a full portrait screen at size 1 is 40)
+#define CONSOLE_LINE_CHARS 54    // Longest line (320 px / 6 px per char at size 1)
+
+/**
+ * @brief Fixed ring of text lines. When it is full the oldest line is
+ * overwritten, nothing is ever allocated.
+ */
+class LineRing {
+
+    public:
+
+        /**
+         * @brief Constructor. Starts empty.
+         */
+        LineRing();
+
+        /**
+         * @brief Adds a line at the end (cut to CONSOLE_LINE_CHARS).
+         * @param len Characters of text to copy.
+         */
+        void push(const char* text, uint16_t len);
+
+        /**
+         * @brief Number of lines stored.
+         */
+        uint16_t count() const;
+
+        /**
+         * @brief Gets a line. 0 is the oldest, count() - 1 the newest.
+         */
+        const char* line(uint16_t index) const;
+
+        /**
+         * @brief Forgets every line.
+         */
+        void clear();
+
+    private:
+
+        char _lines[CONSOLE_HISTORY][CONSOLE_LINE_CHARS + 1];
+        uint16_t _head;     // Slot of the oldest line
+        uint16_t _count;
+
+};
+
+#endif
@@ -0,0 +1,131 @@
+#include "MotionTracker.h"
+#include <esp_heap_caps.h>
+
+/**
+ * @brief Constructor. The reference grid is allocated with the first frame.
+ */
+MotionTracker::MotionTracker()
+{
+    _reference = NULL;
+    _cols = _rows = 0;
+    _step = MOTION_STEP;
+    _threshold = MOTION_THRESHOLD;
+    _primed = false;
+    _x = _y = 0;
+    _changed = 0;
+}
+
+/**
+ * @brief Destructor. Frees the reference grid.
+ */
+MotionTracker::~MotionTracker()
+{
+    if (_reference) heap_caps_free(_reference);
+}
+
+/**
+ * @brief Compares a frame with the previous one.
+ * @param pixels Frame data, grayscale (1 byte) or RGB565 (2 bytes, big-endian).
+ * @param rgb565 True for RGB565 frames.
+ * @return True if enough samples changed (x() and y() are updated).
+ */
+bool MotionTracker::update(const uint8_t* pixels, uint16_t width, uint16_t height, bool rgb565)
+{
+    uint16_t cols = width / _step;
+    uint16_t rows = height / _step;
+    if (cols == 0 || rows == 0) return false;
+    // New size: new grid (internal RAM, it is read and written every frame)
+    if (!_reference || cols != _cols || rows != _rows)
+    {
+        if (_reference) heap_caps_free(_reference);
+        _reference = (uint8_t*)heap_caps_malloc((size_t)cols * rows, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        if (!_reference) return false;
+        _cols = cols;
+        _rows = rows;
+        _primed = false;
+    }
+    uint8_t bytes = rgb565 ? 2 : 1;
+    uint32_t sum_x = 0, sum_y = 0, count = 0;
+    uint8_t* ref = _reference;
+    for (uint16_t row = 0 ; row < rows ; row++)
+    {
+        // Center of each step x step cell
+        const uint8_t* src = &pixels[((uint32_t)(row * _step + _step / 2) * width + _step / 2) * bytes];
+        uint32_t stride = (uint32_t)_step * bytes;
+        for (uint16_t col = 0 ; col < cols ; col++, src += stride, ref++)
+        {
+            uint8_t luma;
+            if (rgb565)
+            {
+                // Integer luma from the 5/6/5 bits: (77 R + 150 G + 29 B) / 256
+                uint8_t r = src[0] & 0xF8;
+                uint8_t g = ((src[0] & 0x07) << 5) | ((src[1] & 0xE0) >> 3);
+                uint8_t b = (src[1] & 0x1F) << 3;
+                luma = (r * 77 + g * 150 + b * 29) >> 8;
+            } else {
+                luma = src[0];
+            }
+            // Difference and new reference in the same pass
+            int16_t diff = luma - *ref;
+            *ref = luma;
+            if (diff > _threshold || diff < -_threshold)
+            {
+                sum_x += col;
+                sum_y += row;
+                count++;
+            }
+        }
+    }
+    _changed = count;
+    // The first frame only fills the reference
+    if (!_primed)
+    {
+        _primed = true;
+        return false;
+    }
+    if (count < MOTION_MIN_SAMPLES) return false;
+    // Cell centers mapped to -100..100
+    _x = (int16_t)((int64_t)(2 * sum_x + count) * 100 / ((int64_t)count * _cols)) - 100;
+    _y = (int16_t)((int64_t)(2 * sum_y + count) * 100 / ((int64_t)count * _rows)) - 100;
+    return true;
+}
+
+/**
+ * @brief Center of the motion, from -100 (left/top) to 100 (right/bottom).
+ */
+int16_t MotionTracker::x() const
+{
+    return _x;
+}
+
+int16_t MotionTracker::y() const
+{
+    return _y;
+}
+
+/**
+ * @brief Samples that changed in the last frame.
+ */
+uint16_t MotionTracker::changed() const
+{
+    return _changed;
+}
+
+/**
+ * @brief Sampling step and brightness change that counts as motion.
+ * The reference is taken again from the next frame.
+ */
+void MotionTracker::configure(uint8_t step, uint8_t threshold)
+{
+    _step = max(step, (uint8_t)1);
+    _threshold = threshold;
+    reset();
+}
+
+/**
+ * @brief Forgets the reference frame (the next one only becomes the reference).
+ */
+void MotionTracker::reset()
+{
+    _primed = false;
+}
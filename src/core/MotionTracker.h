@@ -0,0 +1,73 @@
+#ifndef MOTION_TRACKER_H
+#define MOTION_TRACKER_H
+
+#include <Arduino.h>
+
+// Defaults of the motion kernel
+#define MOTION_STEP        4     // One sample every 4x4 pixels (QVGA -> 80x60)
+#define MOTION_THRESHOLD   24    // Brightness change (0-255) that counts as motion
+#define MOTION_MIN_SAMPLES 8     // Changed samples needed to trust the centroid
+
+/**
+ * @brief Finds where something moves between consecutive camera frames.
+ * Frames are sampled on a coarse grid and compared with the previous one in
+ * a single integer pass that also updates the reference, so each frame costs
+ * a few thousand additions whatever the resolution.
+ */
+class MotionTracker {
+
+    public:
+
+        /**
+         * @brief Constructor. The reference grid is allocated with the first frame.
+         */
+        MotionTracker();
+
+        /**
+         * @brief Destructor. Frees the reference grid.
+         */
+        ~MotionTracker();
+
+        /**
+         * @brief Compares a frame with the previous one.
+         * @param pixels Frame data, grayscale (1 byte) or RGB565 (2 bytes, big-endian).
+         * @param rgb565 True for RGB565 frames.
+         * @return True if enough samples changed (x() and y() are updated).
+         */
+        bool update(const uint8_t* pixels, uint16_t width, uint16_t height, bool rgb565);
+
+        /**
+         * @brief Center of the motion, from -100 (left/top) to 100 (right/bottom).
+         */
+        int16_t x() const;
+        int16_t y() const;
+
+        /**
+         * @brief Samples that changed in the last frame.
+         */
+        uint16_t changed() const;
+
+        /**
+         * @brief Sampling step and brightness change that counts as motion.
+         * The reference is taken again from the next frame.
+         */
+        void configure(uint8_t step, uint8_t threshold);
+
+        /**
+         * @brief Forgets the reference frame (the next one only becomes the reference).
+         */
+        void reset();
+
+    private:
+
+        uint8_t* _reference;    // Brightness of every sample of the last frame
+        uint16_t _cols, _rows;
+        uint8_t _step;
+        uint8_t _threshold;
+        bool _primed;           // The reference holds a frame
+        int16_t _x, _y;
+        uint16_t _changed;
+
+};
+
+#endif
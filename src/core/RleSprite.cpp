@@ -0,0 +1,305 @@
+#include "RleSprite.h"
+#include "BandCanvas.h"
+#include <vector>
+
+// Fills n pixels with the same (already swapped) color
+static inline void _fill16(uint16_t* dst, uint16_t color, int16_t n)
+{
+    for (int16_t i = 0 ; i < n ; i++) dst[i] = color;
+}
+
+/**
+ * @brief Constructor. The sprite is empty until build().
+ */
+RleSprite::RleSprite()
+{
+    _runs = NULL;
+    _row_start = NULL;
+    _x = _y = _w = _h = 0;
+    _background = 0x0000;
+    _ink = 0xFFFF;
+}
+
+/**
+ * @brief Destructor. Frees the runs.
+ */
+RleSprite::~RleSprite()
+{
+    release();
+}
+
+/**
+ * @brief Rasterizes a list and keeps the area (x, y, w, h) of the screen.
+ * Runs are stored in PSRAM when the board has it.
+ * @param list Commands to rasterize (screen coordinates).
+ * @param screen_w Screen width the list was recorded for.
+ * @param screen_h Screen height the list was recorded for.
+ * @param background Color of the pixels not covered by the list.
+ * @return False if there is not enough memory.
+ */
+bool RleSprite::build(const DrawList& list, int16_t screen_w, int16_t screen_h,
+                      int16_t x, int16_t y, int16_t w, int16_t h, uint16_t background)
+{
+    release();
+    // Only the part inside the screen can be rasterized
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (x + w > screen_w) w = screen_w - x;
+    if (y + h > screen_h) h = screen_h - y;
+    if (w <= 0 || h <= 0) return false;
+    uint16_t* pixels = (uint16_t*)heap_caps_malloc((size_t)screen_w * RLE_BUILD_LINES * sizeof(uint16_t), MALLOC_CAP_8BIT);
+    if (!pixels) return false;
+    uint16_t bg = __builtin_bswap16(background);
+    bool ink_found = false;
+    _ink = (background == 0xFFFF) ? 0x0000 : 0xFFFF;
+    std::vector<uint16_t> runs;
+    std::vector<uint32_t> starts;
+    runs.reserve(h * 4);
+    starts.reserve(h + 1);
+    // Same band replay as DisplayHandler::renderScene(), then each row is encoded
+    BandCanvas band(screen_w, screen_h);
+    for (int16_t band_y = y ; band_y < y + h ; band_y += RLE_BUILD_LINES)
+    {
+        int16_t lines = min((int16_t)RLE_BUILD_LINES, (int16_t)(y + h - band_y));
+        _fill16(pixels, bg, screen_w * lines);
+        band.setBand(pixels, band_y, lines);
+        for (uint16_t i = 0 ; i < list.size() ; i++)
+        {
+            int16_t row0, row1;
+            list.getRows(i, row0, row1);
+            if (row1 < band_y || row0 >= band_y + lines) continue;
+            list.execute(i, band);
+        }
+        for (int16_t row = 0 ; row < lines ; row++)
+        {
+            const uint16_t* src = &pixels[row * screen_w + x];
+            starts.push_back(runs.size());
+            bool ink = false;
+            uint16_t length = 0;
+            for (int16_t col = 0 ; col < w ; col++)
+            {
+                bool is_ink = (src[col] != bg);
+                if (is_ink && !ink_found)
+                {
+                    _ink = __builtin_bswap16(src[col]);
+                    ink_found = true;
+                }
+                if (is_ink != ink)
+                {
+                    runs.push_back(length);
+                    length = 0;
+                    ink = is_ink;
+                }
+                length++;
+            }
+            runs.push_back(length);
+        }
+    }
+    heap_caps_free(pixels);
+    starts.push_back(runs.size());
+    // Row index and runs in one block, in PSRAM if there is some
+    size_t bytes = starts.size() * sizeof(uint32_t) + runs.size() * sizeof(uint16_t);
+    uint32_t caps = psramFound() ? MALLOC_CAP_SPIRAM : MALLOC_CAP_8BIT;
+    _row_start = (uint32_t*)heap_caps_malloc(bytes, caps);
+    if (!_row_start) return false;
+    _runs = (uint16_t*)(_row_start + starts.size());
+    memcpy(_row_start, starts.data(), starts.size() * sizeof(uint32_t));
+    memcpy(_runs, runs.data(), runs.size() * sizeof(uint16_t));
+    _x = x;
+    _y = y;
+    _w = w;
+    _h = h;
+    _background = background;
+    return true;
+}
+
+/**
+ * @brief Frees the runs (the sprite becomes empty).
+ */
+void RleSprite::release()
+{
+    if (_row_start) heap_caps_free(_row_start);
+    _row_start = NULL;
+    _runs = NULL;
+    _w = _h = 0;
+}
+
+/**
+ * @brief True once build() has succeeded.
+ */
+bool RleSprite::isReady() const
+{
+    return _row_start != NULL;
+}
+
+int16_t RleSprite::x() const
+{
+    return _x;
+}
+
+int16_t RleSprite::y() const
+{
+    return _y;
+}
+
+int16_t RleSprite::width() const
+{
+    return _w;
+}
+
+int16_t RleSprite::height() const
+{
+    return _h;
+}
+
+/**
+ * @brief Background and ink colors (CPU byte order).
+ */
+uint16_t RleSprite::background() const
+{
+    return _background;
+}
+
+uint16_t RleSprite::ink() const
+{
+    return _ink;
+}
+
+/**
+ * @brief Bytes used by the runs and the row index.
+ */
+uint32_t RleSprite::memoryUsed() const
+{
+    if (!_row_start) return 0;
+    return (_h + 1) * sizeof(uint32_t) + _row_start[_h] * sizeof(uint16_t);
+}
+
+/**
+ * @brief Expands one row into a pixel buffer (big-endian RGB565).
+ * The content can be moved inside the sprite area, what is uncovered
+ * becomes background.
+ * @param dst Buffer for width() pixels.
+ * @param row Row of the area (0 = top).
+ * @param shift_x Content displacement to the right.
+ * @param shift_y Content displacement down.
+ */
+void RleSprite::expandRow(uint16_t* dst, int16_t row, int16_t shift_x, int16_t shift_y) const
+{
+    _fill16(dst, __builtin_bswap16(_background), _w);
+    int16_t src_row = row - shift_y;
+    if (!_row_start || src_row < 0 || src_row >= _h) return;
+    uint16_t ink = __builtin_bswap16(_ink);
+    // Only the ink runs are written, shifted and clipped to the area
+    int16_t col = shift_x;
+    bool is_ink = false;
+    for (uint32_t i = _row_start[src_row] ; i < _row_start[src_row + 1] ; i++)
+    {
+        int16_t length = _runs[i];
+        if (is_ink)
+        {
+            int16_t x0 = max(col, (int16_t)0);
+            int16_t x1 = min((int16_t)(col + length), _w);
+            if (x1 > x0) _fill16(&dst[x0], ink, x1 - x0);
+        }
+        col += length;
+        is_ink = !is_ink;
+    }
+}
+
+/**
+ * @brief Columns of a row that change when this sprite (moved by shift_x,
+ * shift_y) replaces another one already on the screen. Both sprites must
+ * cover the same area with the same colors (see sameArea()).
+ * @param shown Sprite on the screen (it can be this one).
+ * @param shown_x Displacement it was drawn with.
+ * @param shown_y Displacement it was drawn with.
+ * @param spans Output: pairs of first column and column after the last.
+ * @param max_spans Pairs that fit in spans (the last one absorbs the rest).
+ * @return Number of spans.
+ */
+uint8_t RleSprite::changedSpans(int16_t row, int16_t shift_x, int16_t shift_y, const RleSprite& shown, int16_t shown_x, int16_t shown_y,
+                                int16_t* spans, uint8_t max_spans) const
+{
+    if (max_spans == 0) return 0;
+    int16_t edges_new[RLE_MAX_EDGES], edges_old[RLE_MAX_EDGES];
+    uint8_t count_new, count_old;
+    // Too detailed to compare: the whole row is sent
+    if (!_rowEdges(row, shift_x, shift_y, edges_new, count_new, RLE_MAX_EDGES) ||
+        !shown._rowEdges(row, shown_x, shown_y, edges_old, count_old, RLE_MAX_EDGES))
+    {
+        spans[0] = 0;
+        spans[1] = _w;
+        return 1;
+    }
+    // Both inks toggle at their edges, the difference toggles at every edge that is not shared
+    uint8_t i = 0, j = 0, n = 0;
+    bool changed = false;
+    int16_t start = 0;
+    while (i < count_new || j < count_old)
+    {
+        int16_t x;
+        if (j >= count_old || (i < count_new && edges_new[i] < edges_old[j])) x = edges_new[i++];
+        else if (i >= count_new || edges_old[j] < edges_new[i]) x = edges_old[j++];
+        else
+        {
+            // Same edge in both: no change here
+            i++;
+            j++;
+            continue;
+        }
+        changed = !changed;
+        if (changed)
+        {
+            start = x;
+            continue;
+        }
+        if (x <= start) continue;
+        if (n == max_spans)
+        {
+            // No room: the last span grows
+            spans[2 * n - 1] = x;
+            continue;
+        }
+        spans[2 * n] = start;
+        spans[2 * n + 1] = x;
+        n++;
+    }
+    return n;
+}
+
+/**
+ * @brief True if another sprite covers the same area with the same colors.
+ */
+bool RleSprite::sameArea(const RleSprite& other) const
+{
+    return isReady() && other.isReady() && _x == other._x && _y == other._y && _w == other._w && _h == other._h &&
+           _background == other._background && _ink == other._ink;
+}
+
+// Columns where the ink starts or ends in a row (clipped to the area)
+bool RleSprite::_rowEdges(int16_t row, int16_t shift_x, int16_t shift_y, int16_t* edges, uint8_t& count, uint8_t capacity) const
+{
+    count = 0;
+    int16_t src_row = row - shift_y;
+    if (!_row_start || src_row < 0 || src_row >= _h) return true;
+    int16_t col = shift_x;
+    bool is_ink = false;
+    for (uint32_t i = _row_start[src_row] ; i < _row_start[src_row + 1] ; i++)
+    {
+        int16_t length = _runs[i];
+        if (is_ink)
+        {
+            int16_t x0 = max(col, (int16_t)0);
+            int16_t x1 = min((int16_t)(col + length), _w);
+            if (x1 > x0)
+            {
+                if (count + 2 > capacity) return false;
+                edges[count++] = x0;
+                edges[count++] = x1;
+            }
+        }
+        col += length;
+        is_ink = !is_ink;
+    }
+    return true;
+}
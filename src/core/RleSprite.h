@@ -0,0 +1,117 @@
+#ifndef RLE_SPRITE_H
+#define RLE_SPRITE_H
+
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include "./DrawList.h"
+
+// Rows rasterized at a time while a sprite is built
+#define RLE_BUILD_LINES 16
+// Ink edges per row handled by changedSpans() (more = the whole row changes)
+#define RLE_MAX_EDGES 32
+
+/**
+ * @brief Two-color picture stored as run lengths, made once from a DrawList.
+ * Each row is a list of uint16_t runs that alternate background and ink,
+ * starting with background (it may be 0). A face part of a few thousand
+ * pixels takes a few hundred bytes and is expanded back at memcpy speed.
+ * Every pixel that is not the background color becomes the ink color.
+ */
+class RleSprite {
+
+    public:
+
+        /**
+         * @brief Constructor. The sprite is empty until build().
+         */
+        RleSprite();
+
+        /**
+         * @brief Destructor. Frees the runs.
+         */
+        ~RleSprite();
+
+        /**
+         * @brief Rasterizes a list and keeps the area (x, y, w, h) of the screen.
+         * Runs are stored in PSRAM when the board has it.
+         * @param list Commands to rasterize (screen coordinates).
+         * @param screen_w Screen width the list was recorded for.
+         * @param screen_h Screen height the list was recorded for.
+         * @param background Color of the pixels not covered by the list.
+         * @return False if there is not enough memory.
+         */
+        bool build(const DrawList& list, int16_t screen_w, int16_t screen_h,
+                   int16_t x, int16_t y, int16_t w, int16_t h, uint16_t background);
+
+        /**
+         * @brief Frees the runs (the sprite becomes empty).
+         */
+        void release();
+
+        /**
+         * @brief True once build() has succeeded.
+         */
+        bool isReady() const;
+
+        // Area of the screen covered by the sprite
+        int16_t x() const;
+        int16_t y() const;
+        int16_t width() const;
+        int16_t height() const;
+
+        /**
+         * @brief Background and ink colors (CPU byte order).
+         */
+        uint16_t background() const;
+        uint16_t ink() const;
+
+        /**
+         * @brief Bytes used by the runs and the row index.
+         */
+        uint32_t memoryUsed() const;
+
+        /**
+         * @brief Expands one row into a pixel buffer (big-endian RGB565).
+         * The content can be moved inside the sprite area, what is uncovered
+         * becomes background.
+         * @param dst Buffer for width() pixels.
+         * @param row Row of the area (0 = top).
+         * @param shift_x Content displacement to the right.
+         * @param shift_y Content displacement down.
+         */
+        void expandRow(uint16_t* dst, int16_t row, int16_t shift_x = 0, int16_t shift_y = 0) const;
+
+        /**
+         * @brief Columns of a row that change when this sprite (moved by shift_x,
+         * shift_y) replaces another one already on the screen. Both sprites must
+         * cover the same area with the same colors (see sameArea()).
+         * @param shown Sprite on the screen (it can be this one).
+         * @param shown_x Displacement it was drawn with.
+         * @param shown_y Displacement it was drawn with.
+         * @param spans Output: pairs of first column and column after the last.
+         * @param max_spans Pairs that fit in spans (the last one absorbs the rest).
+         * @return Number of spans.
+         */
+        uint8_t changedSpans(int16_t row, int16_t shift_x, int16_t shift_y, const RleSprite& shown, int16_t shown_x, int16_t shown_y,
+                             int16_t* spans, uint8_t max_spans) const;
+
+        /**
+         * @brief True if another sprite covers the same area with the same colors.
+         */
+        bool sameArea(const RleSprite& other) const;
+
+    private:
+
+        uint16_t* _runs;
+        uint32_t* _row_start;   // h + 1 offsets into _runs
+        int16_t _x, _y, _w, _h;
+        uint16_t _background;
+        uint16_t _ink;
+
+        // Columns where the ink starts or ends in a row (clipped to the area).
+        // Returns false if they do not fit in capacity.
+        bool _rowEdges(int16_t row, int16_t shift_x, int16_t shift_y, int16_t* edges, uint8_t& count, uint8_t capacity) const;
+
+};
+
+#endif
@@ -2,6 +2,12 @@
 
 SemaphoreHandle_t SPIHandler::_safety_block_spi = NULL;
 
+#ifdef ORBITO_DISPLAY_STATS
+BusStats SPIHandler::_bus_stats = { 0, 0, 0 };
+uint32_t SPIHandler::_bus_taken_at = 0;
+portMUX_TYPE SPIHandler::_bus_stats_mux = portMUX_INITIALIZER_UNLOCKED;
+#endif
+
 /**
  * @brief Constructor
  * @param spi_bus Pointer to the SPI bus.
@@ -27,7 +33,7 @@ void SPIHandler::begin()
 void SPIHandler::startTransaction()
 {
     // Wait the blocking key
-    xSemaphoreTake(_safety_block_spi, portMAX_DELAY);
+    _lockBus();
     // Config the bus with the device frequency
     _spi->beginTransaction(_settings);
     // Select the slave
@@ -42,7 +48,7 @@ void SPIHandler::endTransaction()
     // Free the configuration
     _spi->endTransaction();
     // Return the blocking key
-    xSemaphoreGive(_safety_block_spi);
+    _unlockBus();
 }
 
 // Send a simple byte
@@ -62,3 +68,57 @@ uint8_t SPIHandler::spiRead()
 {
     return _spi->transfer(0x00);
 }
+
+// Reads a buffer
+void SPIHandler::spiReadBytes(uint8_t* data, size_t size)
+{
+    _spi->transferBytes(NULL, data, size);
+}
+
+// Takes the shared bus
+void SPIHandler::_lockBus()
+{
+    ORBITO_STAT(uint32_t wait_start = micros());
+    xSemaphoreTake(_safety_block_spi, portMAX_DELAY);
+    // Only the owner writes the timestamp, the mutex protects it
+    ORBITO_STAT(
+        _bus_taken_at = micros();
+        portENTER_CRITICAL(&_bus_stats_mux);
+        _bus_stats.locks++;
+        _bus_transactions++;
+        _bus_stats.wait_us += _bus_taken_at - wait_start;
+        portEXIT_CRITICAL(&_bus_stats_mux)
+    );
+}
+
+// Frees the shared bus
+void SPIHandler::_unlockBus()
+{
+    ORBITO_STAT(
+        uint32_t held = micros() - _bus_taken_at;
+        portENTER_CRITICAL(&_bus_stats_mux);
+        _bus_stats.hold_us += held;
+        portEXIT_CRITICAL(&_bus_stats_mux)
+    );
+    xSemaphoreGive(_safety_block_spi);
+}
+
+/**
+ * @brief Copies the bus counters (shared by every SPI device).
+ * @param reset Starts counting again from zero.
+ * @return False if the library was built without ORBITO_DISPLAY_STATS.
+ */
+bool SPIHandler::getBusStats(BusStats& stats, bool reset)
+{
+#ifdef ORBITO_DISPLAY_STATS
+    portENTER_CRITICAL(&_bus_stats_mux);
+    stats = _bus_stats;
+    if (reset) _bus_stats = { 0, 0, 0 };
+    portEXIT_CRITICAL(&_bus_stats_mux);
+    return true;
+#else
+    stats = { 0, 0, 0 };
+    (void)reset;
+    return false;
+#endif
+}
@@ -6,6 +6,24 @@
 #include <freertos/FreeRTOS.h>
 #include <freertos/semphr.h>
 
+// Build with -DORBITO_DISPLAY_STATS (or uncomment the line) to count bus and
+// display activity. Without it every counter call compiles to nothing.
+// #define ORBITO_DISPLAY_STATS
+#ifdef ORBITO_DISPLAY_STATS
+#define ORBITO_STAT(...) __VA_ARGS__
+#else
+#define ORBITO_STAT(...)
+#endif
+
+/**
+ * @brief Usage of the shared SPI bus since the last reset.
+ */
+struct BusStats {
+    uint32_t locks;         // Times the bus was taken
+    uint32_t wait_us;       // Time spent waiting for the bus
+    uint32_t hold_us;       // Time the bus was owned
+};
+
 class SPIHandler {
 
     protected:
@@ -19,6 +37,16 @@ class SPIHandler {
         // If a device close it, other device can't use it until the first device open it.
         static SemaphoreHandle_t _safety_block_spi;
 
+        // Takes and frees the shared bus (counting wait and hold time if enabled)
+        void _lockBus();
+        void _unlockBus();
+
+#ifdef ORBITO_DISPLAY_STATS
+        // Times this device took the bus, and the lock of every bus counter
+        uint32_t _bus_transactions = 0;
+        static portMUX_TYPE _bus_stats_mux;
+#endif
+
     public:
 
         /**
@@ -47,6 +75,23 @@ class SPIHandler {
         // Reads from a byte
         uint8_t spiRead();
 
+        // Reads a buffer
+        void spiReadBytes(uint8_t* data, size_t size);
+
+        /**
+         * @brief Copies the bus counters (shared by every SPI device).
+         * @param reset Starts counting again from zero.
+         * @return False if the library was built without ORBITO_DISPLAY_STATS.
+         */
+        static bool getBusStats(BusStats& stats, bool reset = false);
+
+    private:
+
+#ifdef ORBITO_DISPLAY_STATS
+        static BusStats _bus_stats;
+        static uint32_t _bus_taken_at;
+#endif
+
 };
 
 #endif
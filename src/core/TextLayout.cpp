@@ -0,0 +1,132 @@
+#include "TextLayout.h"
+
+/**
+ * @brief Constructor. The layout is empty until build().
+ */
+TextLayout::TextLayout()
+{
+    _block = NULL;
+    _starts = NULL;
+    _count = _length = 0;
+    _columns = 0;
+    _hash = 0;
+}
+
+/**
+ * @brief Destructor. Frees the lines.
+ */
+TextLayout::~TextLayout()
+{
+    release();
+}
+
+/**
+ * @brief Splits a text in lines of at most columns characters.
+ * @return False if there is not enough memory.
+ */
+bool TextLayout::build(const char* text, uint8_t columns)
+{
+    release();
+    if (columns == 0) return false;
+    // Offsets are 16 bits: with one column the block is three times the text
+    size_t len = min(strlen(text), (size_t)UINT16_MAX / 3 - 1);
+    // Original text + every line with its NUL: a line ends at a space or '\n'
+    // (its NUL takes that place) or is a full line cut inside a word (one more)
+    size_t size = len + 1 + len + len / columns + 1;
+    _block = (char*)malloc(size);
+    _starts = (uint16_t*)malloc((len + 1) * sizeof(uint16_t));
+    if (!_block || !_starts)
+    {
+        release();
+        return false;
+    }
+    memcpy(_block, text, len);
+    _block[len] = '\0';
+    char* out = &_block[len + 1];
+    uint16_t used = len + 1;
+    size_t pos = 0;
+    while (pos < len && text[pos] == ' ') pos++;
+    while (pos < len)
+    {
+        // Longest piece that fits, cut at the last space if there is one
+        size_t end = pos;
+        size_t cut = 0;
+        while (end < len && end - pos < columns && text[end] != '\n')
+        {
+            if (text[end] == ' ') cut = end;
+            end++;
+        }
+        size_t next = end;
+        if (end < len && text[end] != '\n' && text[end] != ' ' && cut > pos) next = end = cut;
+        // Spaces at the end of the line and at the start of the next one are dropped
+        while (end > pos && text[end - 1] == ' ') end--;
+        while (next < len && text[next] == ' ') next++;
+        if (next < len && text[next] == '\n') next++;
+        _starts[_count++] = used;
+        memcpy(out, &text[pos], end - pos);
+        out[end - pos] = '\0';
+        out += end - pos + 1;
+        used += end - pos + 1;
+        pos = next;
+    }
+    _length = len;
+    _columns = columns;
+    _hash = hash(_block);
+    return true;
+}
+
+/**
+ * @brief True if this layout was built from the same text and columns.
+ */
+bool TextLayout::matches(const char* text, uint8_t columns) const
+{
+    return _block && _columns == columns && _hash == hash(text) && strcmp(_block, text) == 0;
+}
+
+/**
+ * @brief Frees the lines (the layout becomes empty).
+ */
+void TextLayout::release()
+{
+    free(_block);
+    free(_starts);
+    _block = NULL;
+    _starts = NULL;
+    _count = _length = 0;
+    _columns = 0;
+}
+
+/**
+ * @brief Number of lines (0 if empty).
+ */
+uint16_t TextLayout::lineCount() const
+{
+    return _count;
+}
+
+/**
+ * @brief Gets a line (NUL terminated, without the spaces where it was cut).
+ */
+const char* TextLayout::line(uint16_t index) const
+{
+    if (index >= _count) return "";
+    return &_block[_starts[index]];
+}
+
+/**
+ * @brief Characters of the original text (used to time its reading).
+ */
+uint16_t TextLayout::length() const
+{
+    return _length;
+}
+
+/**
+ * @brief Hash of a text (FNV-1a), to find a layout without comparing strings.
+ */
+uint32_t TextLayout::hash(const char* text)
+{
+    uint32_t h = 2166136261u;
+    while (*text) h = (h ^ (uint8_t)*text++) * 16777619u;
+    return h;
+}
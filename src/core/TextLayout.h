@@ -0,0 +1,73 @@
+#ifndef TEXT_LAYOUT_H
+#define TEXT_LAYOUT_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Word-wrapped text, laid out once for a number of columns.
+ * Lines are kept as consecutive C strings in one block, so each of them can be
+ * drawn straight away (e.g. recorded in a DrawList) without copying it again.
+ * '\n' forces a line break and words longer than a line are cut.
+ */
+class TextLayout {
+
+    public:
+
+        /**
+         * @brief Constructor. The layout is empty until build().
+         */
+        TextLayout();
+
+        /**
+         * @brief Destructor. Frees the lines.
+         */
+        ~TextLayout();
+
+        /**
+         * @brief Splits a text in lines of at most columns characters.
+         * @return False if there is not enough memory.
+         */
+        bool build(const char* text, uint8_t columns);
+
+        /**
+         * @brief True if this layout was built from the same text and columns.
+         */
+        bool matches(const char* text, uint8_t columns) const;
+
+        /**
+         * @brief Frees the lines (the layout becomes empty).
+         */
+        void release();
+
+        /**
+         * @brief Number of lines (0 if empty).
+         */
+        uint16_t lineCount() const;
+
+        /**
+         * @brief Gets a line (NUL terminated, without the spaces where it was cut).
+         */
+        const char* line(uint16_t index) const;
+
+        /**
+         * @brief Characters of the original text (used to time its reading).
+         */
+        uint16_t length() const;
+
+        /**
+         * @brief Hash of a text (FNV-1a), to find a layout without comparing strings.
+         */
+        static uint32_t hash(const char* text);
+
+    private:
+
+        char* _block;           // Original text, then the lines
+        uint16_t* _starts;      // Offset of every line in _block
+        uint16_t _count;
+        uint16_t _length;
+        uint8_t _columns;
+        uint32_t _hash;
+
+};
+
+#endif
@@ -120,30 +120,41 @@ esp_err_t WebServerHandler::streamHandler(httpd_req_t *req)
         return ESP_FAIL;
     }
     CameraHandler* camera = _instance->_camera_ptr;
-    camera_fb_t* fb = NULL;
     esp_err_t response = ESP_OK;
     char part_buffer[64];
     // Standar MJPEG header
     response = httpd_resp_set_type(req, "multipart/x-mixed-replace;boundary=frame");
     if (response != ESP_OK) return response;
+    // Frames from the capture task if it runs, from the camera otherwise (see CameraHandler::startCapture)
+    FrameSubscriber frames;
+    camera->subscribe(frames);
+    uint8_t misses = 0;
     // Streaming loop
     while (true)
     {
-        fb = camera->getFrame();
-        if (!fb)
+        // Shared with the sketch and the AI while it is sent (see CameraHandler::latestFrame)
+        FrameRef frame = frames.wait(CAPTURE_WAIT_MS);
+        if (!frame)
         {
+            // The camera may be changing its mode for a moment
+            if (++misses < STREAM_MAX_MISSES)
+            {
+                vTaskDelay(pdMS_TO_TICKS(50));
+                continue;
+            }
             response = ESP_FAIL;
             break;
         }
+        misses = 0;
         // Convert frame to format RGB
-        uint8_t* data_buffer = fb->buf;
-        size_t data_length = fb->len;
+        const uint8_t* data_buffer = frame.data();
+        size_t data_length = frame.length();
         uint8_t*jpg_buffer = NULL;
         size_t jpg_length = 0;
         bool converted = false;
-        if (fb->format != PIXFORMAT_JPEG)
+        if (frame.format() != PIXFORMAT_JPEG)
         {
-            if (camera->convertFrameToJpeg(fb, &jpg_buffer, &jpg_length))
+            if (camera->convertFrameToJpeg(const_cast<camera_fb_t*>(frame.get()), &jpg_buffer, &jpg_length))
             {
                 data_buffer = jpg_buffer;
                 data_length = jpg_length;
@@ -159,7 +170,7 @@ esp_err_t WebServerHandler::streamHandler(httpd_req_t *req)
         if (response == ESP_OK) response = httpd_resp_send_chunk(req, "\r\n--frame\r\n", 13);
         // Clean memory
         if (converted) free(jpg_buffer);
-        camera->releaseFrame(fb);
+        frame.reset();
         if (response != ESP_OK) break;
         vTaskDelay(pdMS_TO_TICKS(10));
     }
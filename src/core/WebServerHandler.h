@@ -5,6 +5,9 @@
 #include "esp_http_server.h"
 #include "CameraHandler.h"
 
+// Empty frames in a row before the stream gives up (a mode change takes a few)
+#define STREAM_MAX_MISSES 20
+
 // This is the definition of the type of function for the Callbacks for commands
 // Receives: (command_name, numeric_value)
 typedef std::function<void(String, int)> CommandCallback;